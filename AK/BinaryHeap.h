@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include <AK/Assertions.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
 namespace AK {
 
 template<typename K, typename V, size_t Capacity>
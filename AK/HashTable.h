@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <AK/BitCast.h>
 #include <AK/Forward.h>
 #include <AK/HashFunctions.h>
+#include <AK/SIMD.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Types.h>
 #include <AK/kmalloc.h>
@@ -26,6 +28,52 @@ enum class HashSetExistingEntryBehavior {
     Replace
 };
 
+namespace Detail {
+
+// Every bucket has a control byte, stored apart from the buckets themselves so that a lookup can check
+// a whole group of them at once. A used bucket's control byte holds the low 7 bits of its value's hash,
+// so the top bit is only set for the special values below.
+enum class HashTableControl : i8 {
+    Empty = -128,
+    Deleted = -2,
+    Sentinel = -1,
+};
+
+constexpr bool is_used_hash_table_bucket(i8 control) { return control >= 0; }
+
+// A group of consecutive control bytes, compared against a byte all at once. Each match method returns
+// a bitmask with bit N set if the Nth control byte in the group matches.
+class HashTableControlGroup {
+public:
+    static constexpr size_t width = 16;
+
+    explicit HashTableControlGroup(i8 const* control)
+    {
+        __builtin_memcpy(&m_control, control, width);
+    }
+
+    u32 match(i8 control) const { return to_bitmask(m_control == control); }
+    u32 match_empty() const { return match(to_underlying(HashTableControl::Empty)); }
+    u32 match_empty_or_deleted() const { return to_bitmask(m_control < to_underlying(HashTableControl::Sentinel)); }
+
+private:
+    static u32 to_bitmask(SIMD::i8x16 mask)
+    {
+#ifdef __SSE2__
+        return static_cast<u16>(__builtin_ia32_pmovmskb128(bit_cast<SIMD::c8x16>(mask)));
+#else
+        u32 bitmask = 0;
+        for (size_t i = 0; i < width; ++i)
+            bitmask |= static_cast<u32>(mask[i] & 1) << i;
+        return bitmask;
+#endif
+    }
+
+    SIMD::i8x16 m_control;
+};
+
+}
+
 template<typename HashTableType, typename T, typename BucketType>
 class HashTableIterator {
     friend HashTableType;
@@ -42,21 +90,29 @@ private:
     {
         if (!m_bucket)
             return;
-        do {
-            ++m_bucket;
-            if (m_bucket->used)
+        ++m_bucket;
+        ++m_control;
+        skip_unused_buckets();
+    }
+
+    void skip_unused_buckets()
+    {
+        for (; !Detail::is_used_hash_table_bucket(*m_control); ++m_bucket, ++m_control) {
+            if (*m_control == to_underlying(Detail::HashTableControl::Sentinel)) {
+                m_bucket = nullptr;
                 return;
-        } while (!m_bucket->end);
-        if (m_bucket->end)
-            m_bucket = nullptr;
+            }
+        }
     }
 
-    explicit HashTableIterator(BucketType* bucket)
+    HashTableIterator(BucketType* bucket, i8 const* control)
         : m_bucket(bucket)
+        , m_control(control)
     {
     }
 
     BucketType* m_bucket { nullptr };
+    i8 const* m_control { nullptr };
 };
 
 template<typename OrderedHashTableType, typename T, typename BucketType>
@@ -82,12 +138,14 @@ private:
 
 template<typename T, typename TraitsForT, bool IsOrdered>
 class HashTable {
-    static constexpr size_t load_factor_in_percent = 60;
+    using Control = Detail::HashTableControl;
+    using ControlGroup = Detail::HashTableControlGroup;
+
+    // The smallest capacity is 7 buckets; every capacity is one less than a power of two so that
+    // it can be used as a mask for bucket indices.
+    static constexpr size_t minimum_capacity = 7;
 
     struct Bucket {
-        bool used;
-        bool deleted;
-        bool end;
         alignas(T) u8 storage[sizeof(T)];
 
         T* slot() { return reinterpret_cast<T*>(storage); }
@@ -97,8 +155,6 @@ class HashTable {
     struct OrderedBucket {
         OrderedBucket* previous;
         OrderedBucket* next;
-        bool used;
-        bool deleted;
         alignas(T) u8 storage[sizeof(T)];
         T* slot() { return reinterpret_cast<T*>(storage); }
         const T* slot() const { return reinterpret_cast<const T*>(storage); }
@@ -116,6 +172,31 @@ class HashTable {
 
     using CollectionDataType = Conditional<IsOrdered, OrderedCollectionData, CollectionData>;
 
+    // Visits the groups of control bytes starting at (hash & capacity) with triangular steps of one group,
+    // which reaches every group exactly once since the number of buckets is a power of two.
+    class ProbeSequence {
+    public:
+        ProbeSequence(unsigned hash, size_t capacity)
+            : m_mask(capacity)
+            , m_offset(hash & capacity)
+        {
+        }
+
+        size_t offset() const { return m_offset; }
+        size_t offset(size_t index_in_group) const { return (m_offset + index_in_group) & m_mask; }
+
+        void next()
+        {
+            m_step += ControlGroup::width;
+            m_offset = (m_offset + m_step) & m_mask;
+        }
+
+    private:
+        size_t m_mask { 0 };
+        size_t m_offset { 0 };
+        size_t m_step { 0 };
+    };
+
 public:
     HashTable() = default;
     explicit HashTable(size_t capacity) { rehash(capacity); }
@@ -125,8 +206,9 @@ public:
         if (!m_buckets)
             return;
 
+        auto* control = control_bytes();
         for (size_t i = 0; i < m_capacity; ++i) {
-            if (m_buckets[i].used)
+            if (Detail::is_used_hash_table_bucket(control[i]))
                 m_buckets[i].slot()->~T();
         }
 
@@ -203,7 +285,11 @@ public:
     void ensure_capacity(size_t capacity)
     {
         VERIFY(capacity >= size());
-        rehash(capacity * 2);
+        auto new_capacity = m_capacity;
+        while (max_used_bucket_count(new_capacity) < capacity)
+            new_capacity = max(new_capacity * 2 + 1, minimum_capacity);
+        if (new_capacity != m_capacity)
+            rehash(new_capacity);
     }
 
     [[nodiscard]] bool contains(T const& value) const
@@ -217,19 +303,23 @@ public:
 
     [[nodiscard]] Iterator begin()
     {
-        if constexpr (IsOrdered)
+        if constexpr (IsOrdered) {
             return Iterator(m_collection_data.head);
-
-        for (size_t i = 0; i < m_capacity; ++i) {
-            if (m_buckets[i].used)
-                return Iterator(&m_buckets[i]);
+        } else {
+            if (!m_buckets)
+                return end();
+            Iterator iterator(m_buckets, control_bytes());
+            iterator.skip_unused_buckets();
+            return iterator;
         }
-        return end();
     }
 
     [[nodiscard]] Iterator end()
     {
-        return Iterator(nullptr);
+        if constexpr (IsOrdered)
+            return Iterator(nullptr);
+        else
+            return Iterator(nullptr, nullptr);
     }
 
     using ConstIterator = Conditional<IsOrdered,
@@ -238,19 +328,23 @@ public:
 
     [[nodiscard]] ConstIterator begin() const
     {
-        if constexpr (IsOrdered)
+        if constexpr (IsOrdered) {
             return ConstIterator(m_collection_data.head);
-
-        for (size_t i = 0; i < m_capacity; ++i) {
-            if (m_buckets[i].used)
-                return ConstIterator(&m_buckets[i]);
+        } else {
+            if (!m_buckets)
+                return end();
+            ConstIterator iterator(m_buckets, control_bytes());
+            iterator.skip_unused_buckets();
+            return iterator;
         }
-        return end();
     }
 
     [[nodiscard]] ConstIterator end() const
     {
-        return ConstIterator(nullptr);
+        if constexpr (IsOrdered)
+            return ConstIterator(nullptr);
+        else
+            return ConstIterator(nullptr, nullptr);
     }
 
     void clear()
@@ -261,33 +355,22 @@ public:
     template<typename U = T>
     HashSetResult try_set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
     {
-        auto* bucket = try_lookup_for_writing(value);
-        if (!bucket)
-            return HashSetResult::Failed;
-        if (bucket->used) {
+        auto hash = TraitsForT::hash(value);
+        if (auto* bucket = lookup_with_hash(hash, [&](auto& other) { return TraitsForT::equals(other, value); })) {
             if (existing_entry_behavior == HashSetExistingEntryBehavior::Keep)
                 return HashSetResult::KeptExistingEntry;
             (*bucket->slot()) = forward<U>(value);
             return HashSetResult::ReplacedExistingEntry;
         }
 
-        new (bucket->slot()) T(forward<U>(value));
-        bucket->used = true;
-        if (bucket->deleted) {
-            bucket->deleted = false;
-            --m_deleted_count;
-        }
-
-        if constexpr (IsOrdered) {
-            if (!m_collection_data.head) [[unlikely]] {
-                m_collection_data.head = bucket;
-            } else {
-                bucket->previous = m_collection_data.tail;
-                m_collection_data.tail->next = bucket;
-            }
-            m_collection_data.tail = bucket;
+        // FIXME: Maybe overrun the "allowed" load factor to avoid OOM
+        if (should_grow()) {
+            if (!try_rehash(grown_capacity()))
+                return HashSetResult::Failed;
         }
 
+        auto& bucket = claim_unused_bucket(hash);
+        new (bucket.slot()) T(forward<U>(value));
         ++m_size;
         return HashSetResult::InsertedNewEntry;
     }
@@ -302,7 +385,7 @@ public:
     template<typename TUnaryPredicate>
     [[nodiscard]] Iterator find(unsigned hash, TUnaryPredicate predicate)
     {
-        return Iterator(lookup_with_hash(hash, move(predicate)));
+        return make_iterator<Iterator>(lookup_with_hash(hash, move(predicate)));
     }
 
     [[nodiscard]] Iterator find(T const& value)
@@ -313,7 +396,7 @@ public:
     template<typename TUnaryPredicate>
     [[nodiscard]] ConstIterator find(unsigned hash, TUnaryPredicate predicate) const
     {
-        return ConstIterator(lookup_with_hash(hash, move(predicate)));
+        return make_iterator<ConstIterator>(lookup_with_hash(hash, move(predicate)));
     }
 
     [[nodiscard]] ConstIterator find(T const& value) const
@@ -335,17 +418,26 @@ public:
     {
         VERIFY(iterator.m_bucket);
         auto& bucket = *iterator.m_bucket;
-        VERIFY(bucket.used);
-        VERIFY(!bucket.deleted);
-
-        if constexpr (!IsOrdered)
-            VERIFY(!bucket.end);
+        size_t index = &bucket - m_buckets;
+        VERIFY(index < m_capacity);
+        VERIFY(Detail::is_used_hash_table_bucket(control_bytes()[index]));
 
         bucket.slot()->~T();
-        bucket.used = false;
-        bucket.deleted = true;
         --m_size;
-        ++m_deleted_count;
+
+        // Lookups only probe past a bucket if its group had no empty buckets when they looked. If the
+        // buckets around this one have never all been used at once, no lookup can have probed past it,
+        // so it can be marked as empty rather than leaving a tombstone behind.
+        auto empty_before = ControlGroup(control_bytes() + ((index - ControlGroup::width) & m_capacity)).match_empty();
+        auto empty_after = ControlGroup(control_bytes() + index).match_empty();
+        bool was_never_in_full_group = empty_before && empty_after
+            && static_cast<size_t>(count_trailing_zeroes_32(empty_after) + __builtin_clz(empty_before) - (32 - ControlGroup::width)) < ControlGroup::width;
+        if (was_never_in_full_group) {
+            set_control(index, to_underlying(Control::Empty));
+        } else {
+            set_control(index, to_underlying(Control::Deleted));
+            ++m_deleted_count;
+        }
 
         if constexpr (IsOrdered) {
             if (bucket.previous)
@@ -361,36 +453,80 @@ public:
     }
 
 private:
-    void insert_during_rehash(T&& value)
+    // The low 7 bits of a hash go into the control byte, the rest pick the group to start probing at.
+    static constexpr unsigned bucket_index_hash(unsigned hash) { return hash >> 7; }
+    static constexpr i8 control_hash(unsigned hash) { return static_cast<i8>(hash & 0x7f); }
+
+    [[nodiscard]] i8* control_bytes() const { return reinterpret_cast<i8*>(m_buckets + m_capacity); }
+
+    // The control bytes are followed by a sentinel that stops iteration, and a copy of the first
+    // (group width - 1) control bytes, so that a group can be loaded starting at any bucket.
+    [[nodiscard]] static constexpr size_t size_in_bytes(size_t capacity)
     {
-        auto& bucket = lookup_for_writing(value);
-        new (bucket.slot()) T(move(value));
-        bucket.used = true;
+        return sizeof(BucketType) * capacity + capacity + ControlGroup::width;
+    }
 
+    // At least one bucket is always left empty, so that unsuccessful lookups are guaranteed to end.
+    [[nodiscard]] static constexpr size_t max_used_bucket_count(size_t capacity) { return capacity - ceil_div(capacity, static_cast<size_t>(8)); }
+
+    void set_control(size_t index, i8 control)
+    {
+        auto* control_bytes = this->control_bytes();
+        control_bytes[index] = control;
+        constexpr size_t cloned_count = ControlGroup::width - 1;
+        control_bytes[((index - cloned_count) & m_capacity) + (cloned_count & m_capacity)] = control;
+    }
+
+    template<typename IteratorType>
+    [[nodiscard]] IteratorType make_iterator(BucketType* bucket) const
+    {
         if constexpr (IsOrdered) {
-            if (!m_collection_data.head) [[unlikely]] {
-                m_collection_data.head = &bucket;
-            } else {
-                bucket.previous = m_collection_data.tail;
-                m_collection_data.tail->next = &bucket;
-            }
-            m_collection_data.tail = &bucket;
+            return IteratorType(bucket);
+        } else {
+            if (!bucket)
+                return IteratorType(nullptr, nullptr);
+            return IteratorType(bucket, control_bytes() + (bucket - m_buckets));
         }
     }
 
-    [[nodiscard]] static constexpr size_t size_in_bytes(size_t capacity)
+    BucketType& claim_unused_bucket(unsigned hash)
     {
+        BucketType* bucket = nullptr;
+        auto* control_bytes = this->control_bytes();
+        for (ProbeSequence probe(bucket_index_hash(hash), m_capacity);; probe.next()) {
+            if (auto unused = ControlGroup(control_bytes + probe.offset()).match_empty_or_deleted()) {
+                auto index = probe.offset(count_trailing_zeroes_32(unused));
+                if (control_bytes[index] == to_underlying(Control::Deleted))
+                    --m_deleted_count;
+                set_control(index, control_hash(hash));
+                bucket = &m_buckets[index];
+                break;
+            }
+        }
+
         if constexpr (IsOrdered) {
-            return sizeof(BucketType) * capacity;
-        } else {
-            return sizeof(BucketType) * (capacity + 1);
+            bucket->previous = m_collection_data.tail;
+            bucket->next = nullptr;
+            if (!m_collection_data.head) [[unlikely]]
+                m_collection_data.head = bucket;
+            else
+                m_collection_data.tail->next = bucket;
+            m_collection_data.tail = bucket;
         }
+        return *bucket;
+    }
+
+    void insert_during_rehash(T&& value)
+    {
+        auto& bucket = claim_unused_bucket(TraitsForT::hash(value));
+        new (bucket.slot()) T(move(value));
     }
 
     bool try_rehash(size_t new_capacity)
     {
-        new_capacity = max(new_capacity, static_cast<size_t>(4));
-        new_capacity = kmalloc_good_size(new_capacity * sizeof(BucketType)) / sizeof(BucketType);
+        // Round up to one less than a power of two.
+        new_capacity = max(new_capacity, minimum_capacity);
+        new_capacity = (static_cast<size_t>(1) << (sizeof(size_t) * 8 - __builtin_clzl(new_capacity))) - 1;
 
         auto* old_buckets = m_buckets;
         auto old_capacity = m_capacity;
@@ -401,15 +537,15 @@ private:
             return false;
 
         m_buckets = (BucketType*)new_buckets;
-        __builtin_memset(m_buckets, 0, size_in_bytes(new_capacity));
-
         m_capacity = new_capacity;
         m_deleted_count = 0;
 
+        auto* control_bytes = this->control_bytes();
+        __builtin_memset(control_bytes, to_underlying(Control::Empty), m_capacity + ControlGroup::width);
+        control_bytes[m_capacity] = to_underlying(Control::Sentinel);
+
         if constexpr (IsOrdered)
             m_collection_data = { nullptr, nullptr };
-        else
-            m_buckets[m_capacity].end = true;
 
         if (!old_buckets)
             return true;
@@ -434,57 +570,31 @@ private:
         if (is_empty())
             return nullptr;
 
-        for (;;) {
-            auto& bucket = m_buckets[hash % m_capacity];
-
-            if (bucket.used && predicate(*bucket.slot()))
-                return &bucket;
+        auto* control_bytes = this->control_bytes();
+        for (ProbeSequence probe(bucket_index_hash(hash), m_capacity);; probe.next()) {
+            ControlGroup group(control_bytes + probe.offset());
+            for (auto matches = group.match(control_hash(hash)); matches; matches &= matches - 1) {
+                auto& bucket = m_buckets[probe.offset(count_trailing_zeroes_32(matches))];
+                if (predicate(*bucket.slot()))
+                    return &bucket;
+            }
 
-            if (!bucket.used && !bucket.deleted)
+            if (group.match_empty())
                 return nullptr;
-
-            hash = double_hash(hash);
         }
     }
 
-    [[nodiscard]] BucketType* try_lookup_for_writing(T const& value)
-    {
-        // FIXME: Maybe overrun the "allowed" load factor to avoid OOM
-        //        If we are allowed to do that, separate that logic from
-        //        the normal lookup_for_writing
-        if (should_grow()) {
-            if (!try_rehash(capacity() * 2))
-                return nullptr;
-        }
-        auto hash = TraitsForT::hash(value);
-        BucketType* first_empty_bucket = nullptr;
-        for (;;) {
-            auto& bucket = m_buckets[hash % m_capacity];
-
-            if (bucket.used && TraitsForT::equals(*bucket.slot(), value))
-                return &bucket;
-
-            if (!bucket.used) {
-                if (!first_empty_bucket)
-                    first_empty_bucket = &bucket;
-
-                if (!bucket.deleted)
-                    return const_cast<BucketType*>(first_empty_bucket);
-            }
+    [[nodiscard]] size_t used_bucket_count() const { return m_size + m_deleted_count; }
+    [[nodiscard]] bool should_grow() const { return used_bucket_count() + 1 > max_used_bucket_count(m_capacity); }
 
-            hash = double_hash(hash);
-        }
-    }
-    [[nodiscard]] BucketType& lookup_for_writing(T const& value)
+    // If most of the used buckets are tombstones, rehashing at the same capacity is enough to get rid of them.
+    [[nodiscard]] size_t grown_capacity() const
     {
-        auto* item = try_lookup_for_writing(value);
-        VERIFY(item);
-        return *item;
+        if ((m_size + 1) * 2 <= max_used_bucket_count(m_capacity))
+            return m_capacity;
+        return m_capacity * 2 + 1;
     }
 
-    [[nodiscard]] size_t used_bucket_count() const { return m_size + m_deleted_count; }
-    [[nodiscard]] bool should_grow() const { return ((used_bucket_count() + 1) * 100) >= (m_capacity * load_factor_in_percent); }
-
     BucketType* m_buckets { nullptr };
 
     [[no_unique_address]] CollectionDataType m_collection_data;
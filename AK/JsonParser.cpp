@@ -16,10 +16,33 @@ constexpr bool is_space(int ch)
     return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
 }
 
+Optional<StringView> JsonParser::consume_string_without_escapes()
+{
+    size_t end = m_index + 1;
+    for (; end < m_input.length(); ++end) {
+        char ch = m_input[end];
+        if (ch == '"')
+            break;
+        if (ch == '\\' || is_ascii_c0_control(ch))
+            return {};
+    }
+    if (end == m_input.length())
+        return {};
+
+    auto string = m_input.substring_view(m_index + 1, end - m_index - 1);
+    m_index = end + 1;
+    return string;
+}
+
 String JsonParser::consume_and_unescape_string()
 {
-    if (!consume_specific('"'))
+    if (peek() != '"')
         return {};
+    // Most strings don't contain any escapes, and can be copied out of the input as they are.
+    if (auto string = consume_string_without_escapes(); string.has_value())
+        return *string;
+
+    ignore();
     StringBuilder final_sb;
 
     for (;;) {
@@ -120,6 +143,36 @@ String JsonParser::consume_and_unescape_string()
     return final_sb.to_string();
 }
 
+String JsonParser::consume_and_unescape_key()
+{
+    if (peek() != '"')
+        return {};
+    auto key = consume_string_without_escapes();
+    if (!key.has_value())
+        return consume_and_unescape_string();
+
+    // Documents like the ones in /proc repeat the same few keys in every object, so each key is only allocated once.
+    auto hash = key->hash();
+    if (auto it = m_keys.find(hash, [&](auto& candidate) { return candidate == *key; }); it != m_keys.end())
+        return *it;
+    String new_key = *key;
+    m_keys.set(new_key);
+    return new_key;
+}
+
+// Strings without escapes are viewed in the input directly, the others are unescaped into `unescaped`.
+Optional<StringView> JsonParser::consume_string_view(String& unescaped)
+{
+    if (peek() != '"')
+        return {};
+    if (auto string = consume_string_without_escapes(); string.has_value())
+        return string;
+    unescaped = consume_and_unescape_string();
+    if (unescaped.is_null())
+        return {};
+    return unescaped.view();
+}
+
 Optional<JsonValue> JsonParser::parse_object()
 {
     JsonObject object;
@@ -130,7 +183,7 @@ Optional<JsonValue> JsonParser::parse_object()
         if (peek() == '}')
             break;
         ignore_while(is_space);
-        auto name = consume_and_unescape_string();
+        auto name = consume_and_unescape_key();
         if (name.is_null())
             return {};
         ignore_while(is_space);
@@ -183,6 +236,66 @@ Optional<JsonValue> JsonParser::parse_array()
     return JsonValue { move(array) };
 }
 
+bool JsonParser::visit_object(JsonVisitor& visitor, StringView key)
+{
+    if (!consume_specific('{'))
+        return false;
+    visitor.visit_object_start(key);
+    for (;;) {
+        ignore_while(is_space);
+        if (peek() == '}')
+            break;
+        String unescaped_name;
+        auto name = consume_string_view(unescaped_name);
+        if (!name.has_value())
+            return false;
+        ignore_while(is_space);
+        if (!consume_specific(':'))
+            return false;
+        if (!visit_helper(visitor, *name))
+            return false;
+        ignore_while(is_space);
+        if (peek() == '}')
+            break;
+        if (!consume_specific(','))
+            return false;
+        ignore_while(is_space);
+        if (peek() == '}')
+            return false;
+    }
+    if (!consume_specific('}'))
+        return false;
+    visitor.visit_object_end();
+    return true;
+}
+
+bool JsonParser::visit_array(JsonVisitor& visitor, StringView key)
+{
+    if (!consume_specific('['))
+        return false;
+    visitor.visit_array_start(key);
+    for (;;) {
+        ignore_while(is_space);
+        if (peek() == ']')
+            break;
+        if (!visit_helper(visitor, {}))
+            return false;
+        ignore_while(is_space);
+        if (peek() == ']')
+            break;
+        if (!consume_specific(','))
+            return false;
+        ignore_while(is_space);
+        if (peek() == ']')
+            return false;
+    }
+    ignore_while(is_space);
+    if (!consume_specific(']'))
+        return false;
+    visitor.visit_array_end();
+    return true;
+}
+
 Optional<JsonValue> JsonParser::parse_string()
 {
     auto result = consume_and_unescape_string();
@@ -342,6 +455,32 @@ Optional<JsonValue> JsonParser::parse_helper()
     return {};
 }
 
+bool JsonParser::visit_helper(JsonVisitor& visitor, StringView key)
+{
+    ignore_while(is_space);
+    switch (peek()) {
+    case '{':
+        return visit_object(visitor, key);
+    case '[':
+        return visit_array(visitor, key);
+    case '"': {
+        String unescaped_string;
+        auto string = consume_string_view(unescaped_string);
+        if (!string.has_value())
+            return false;
+        visitor.visit_string(key, *string);
+        return true;
+    }
+    }
+
+    // Numbers, booleans and null don't need any allocations, so they're parsed the same way as for a tree.
+    auto value = parse_helper();
+    if (!value.has_value())
+        return false;
+    visitor.visit_value(key, *value);
+    return true;
+}
+
 Optional<JsonValue> JsonParser::parse()
 {
     auto result = parse_helper();
@@ -353,4 +492,12 @@ Optional<JsonValue> JsonParser::parse()
     return result;
 }
 
+bool JsonParser::parse(JsonVisitor& visitor)
+{
+    if (!visit_helper(visitor, {}))
+        return false;
+    ignore_while(is_space);
+    return is_eof();
+}
+
 }
@@ -7,10 +7,32 @@
 #pragma once
 
 #include <AK/GenericLexer.h>
+#include <AK/HashTable.h>
 #include <AK/JsonValue.h>
 
 namespace AK {
 
+// Receives the contents of a document from JsonParser::parse(JsonVisitor&) as they are parsed, without a tree of
+// JsonValues being built. `key` is the name of the member that the value belongs to, and null for array elements
+// and the document itself. Keys and strings are only valid until the callback returns.
+//
+// NOTE: This is the allocation-free way to read a document; there is deliberately no arena-backed JsonValue mode.
+//       JsonValues own refcounted Strings, JsonObjects and JsonArrays, and get copied and kept around by their
+//       users, so a tree allocated from a BumpAllocator would need a second set of value types that borrow from
+//       the input and the arena instead.
+class JsonVisitor {
+public:
+    virtual ~JsonVisitor() = default;
+
+    virtual void visit_object_start([[maybe_unused]] StringView key) { }
+    virtual void visit_object_end() { }
+    virtual void visit_array_start([[maybe_unused]] StringView key) { }
+    virtual void visit_array_end() { }
+    virtual void visit_string([[maybe_unused]] StringView key, [[maybe_unused]] StringView value) { }
+    // Numbers, booleans and null.
+    virtual void visit_value([[maybe_unused]] StringView key, [[maybe_unused]] JsonValue const& value) { }
+};
+
 class JsonParser : private GenericLexer {
 public:
     explicit JsonParser(const StringView& input)
@@ -19,11 +41,17 @@ public:
     }
 
     Optional<JsonValue> parse();
+    // Returns false if the input isn't valid JSON, in which case the visitor will have seen part of it already.
+    bool parse(JsonVisitor&);
 
 private:
     Optional<JsonValue> parse_helper();
+    bool visit_helper(JsonVisitor&, StringView key);
 
+    Optional<StringView> consume_string_without_escapes();
     String consume_and_unescape_string();
+    String consume_and_unescape_key();
+    Optional<StringView> consume_string_view(String& unescaped);
     Optional<JsonValue> parse_array();
     Optional<JsonValue> parse_object();
     Optional<JsonValue> parse_number();
@@ -31,10 +59,13 @@ private:
     Optional<JsonValue> parse_false();
     Optional<JsonValue> parse_true();
     Optional<JsonValue> parse_null();
+    bool visit_array(JsonVisitor&, StringView key);
+    bool visit_object(JsonVisitor&, StringView key);
 
-    String m_last_string_starting_with_character[256];
+    HashTable<String> m_keys;
 };
 
 }
 
 using AK::JsonParser;
+using AK::JsonVisitor;
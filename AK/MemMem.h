@@ -28,18 +28,67 @@ const static void* bitap_bitwise(const void* haystack, size_t haystack_length, c
         needle_mask[i] = 0xffffffff;
 
     for (size_t i = 0; i < needle_length; ++i)
-        needle_mask[((const u8*)needle)[i]] &= ~(0x00000001 << i);
+        needle_mask[((const u8*)needle)[i]] &= ~((u64)1 << i);
 
     for (size_t i = 0; i < haystack_length; ++i) {
         lookup |= needle_mask[((const u8*)haystack)[i]];
         lookup <<= 1;
 
-        if (!(lookup & (0x00000001 << needle_length)))
+        if (!(lookup & ((u64)1 << needle_length)))
             return ((const u8*)haystack) + i - needle_length + 1;
     }
 
     return nullptr;
 }
+
+// Finds the first occurrence of `byte`, comparing a whole word of the haystack at a time.
+const static u8* find_byte(const u8* haystack, size_t haystack_length, u8 byte)
+{
+    constexpr u64 low_bits = 0x0101010101010101ull;
+    constexpr u64 high_bits = 0x8080808080808080ull;
+    u64 pattern = low_bits * byte;
+
+    size_t i = 0;
+    for (; i + sizeof(u64) <= haystack_length; i += sizeof(u64)) {
+        u64 word;
+        __builtin_memcpy(&word, haystack + i, sizeof(word));
+        word ^= pattern;
+        // Non-zero iff some byte of `word` is zero, i.e. some byte of the haystack equals `byte`.
+        if (((word - low_bits) & ~word & high_bits) != 0)
+            break;
+    }
+    for (; i < haystack_length; ++i) {
+        if (haystack[i] == byte)
+            return haystack + i;
+    }
+    return nullptr;
+}
+
+// Looks for the first byte of the needle and checks whether the rest follows. This is very fast for the common
+// case of needles whose first byte is rare in the haystack, but gets slow when it isn't. In that case, we give up
+// and return the offset that the caller should continue searching from with a different algorithm.
+const static void* find_by_first_byte(const u8* haystack, size_t haystack_length, const u8* needle, size_t needle_length, size_t& give_up_offset)
+{
+    constexpr size_t max_false_candidates = 64;
+    size_t false_candidates = 0;
+
+    size_t last_possible_start = haystack_length - needle_length;
+    size_t offset = 0;
+    while (offset <= last_possible_start) {
+        auto* candidate = find_byte(haystack + offset, last_possible_start - offset + 1, needle[0]);
+        if (!candidate)
+            break;
+        if (__builtin_memcmp(candidate + 1, needle + 1, needle_length - 1) == 0)
+            return candidate;
+        offset = candidate - haystack + 1;
+        if (++false_candidates == max_false_candidates) {
+            give_up_offset = offset;
+            return nullptr;
+        }
+    }
+    give_up_offset = haystack_length;
+    return nullptr;
+}
 }
 
 template<typename HaystackIterT>
@@ -114,16 +163,28 @@ static inline Optional<size_t> memmem_optional(const void* haystack, size_t hays
         return {};
     }
 
+    size_t offset = 0;
+    if (auto ptr = find_by_first_byte((const u8*)haystack, haystack_length, (const u8*)needle, needle_length, offset))
+        return static_cast<size_t>((FlatPtr)ptr - (FlatPtr)haystack);
+    if (offset + needle_length > haystack_length)
+        return {};
+
+    auto* remaining_haystack = (const u8*)haystack + offset;
+    auto remaining_length = haystack_length - offset;
+
     if (needle_length < 32) {
-        auto ptr = bitap_bitwise(haystack, haystack_length, needle, needle_length);
+        auto ptr = bitap_bitwise(remaining_haystack, remaining_length, needle, needle_length);
         if (ptr)
             return static_cast<size_t>((FlatPtr)ptr - (FlatPtr)haystack);
         return {};
     }
 
     // Fallback to KMP.
-    Array<Span<const u8>, 1> spans { Span<const u8> { (const u8*)haystack, haystack_length } };
-    return memmem(spans.begin(), spans.end(), { (const u8*)needle, needle_length });
+    Array<Span<const u8>, 1> spans { Span<const u8> { remaining_haystack, remaining_length } };
+    auto result = memmem(spans.begin(), spans.end(), { (const u8*)needle, needle_length });
+    if (result.has_value())
+        return offset + *result;
+    return {};
 }
 
 static inline const void* memmem(const void* haystack, size_t haystack_length, const void* needle, size_t needle_length)
@@ -99,23 +99,34 @@ void StringBuilder::append_code_point(u32 code_point)
 {
     if (code_point <= 0x7f) {
         append((char)code_point);
-    } else if (code_point <= 0x07ff) {
-        append((char)(((code_point >> 6) & 0x1f) | 0xc0));
-        append((char)(((code_point >> 0) & 0x3f) | 0x80));
+        return;
+    }
+
+    // Encode the whole sequence first, so that it only needs to be appended once.
+    char bytes[4];
+    size_t length;
+    if (code_point <= 0x07ff) {
+        bytes[0] = (char)(((code_point >> 6) & 0x1f) | 0xc0);
+        bytes[1] = (char)(((code_point >> 0) & 0x3f) | 0x80);
+        length = 2;
     } else if (code_point <= 0xffff) {
-        append((char)(((code_point >> 12) & 0x0f) | 0xe0));
-        append((char)(((code_point >> 6) & 0x3f) | 0x80));
-        append((char)(((code_point >> 0) & 0x3f) | 0x80));
+        bytes[0] = (char)(((code_point >> 12) & 0x0f) | 0xe0);
+        bytes[1] = (char)(((code_point >> 6) & 0x3f) | 0x80);
+        bytes[2] = (char)(((code_point >> 0) & 0x3f) | 0x80);
+        length = 3;
     } else if (code_point <= 0x10ffff) {
-        append((char)(((code_point >> 18) & 0x07) | 0xf0));
-        append((char)(((code_point >> 12) & 0x3f) | 0x80));
-        append((char)(((code_point >> 6) & 0x3f) | 0x80));
-        append((char)(((code_point >> 0) & 0x3f) | 0x80));
+        bytes[0] = (char)(((code_point >> 18) & 0x07) | 0xf0);
+        bytes[1] = (char)(((code_point >> 12) & 0x3f) | 0x80);
+        bytes[2] = (char)(((code_point >> 6) & 0x3f) | 0x80);
+        bytes[3] = (char)(((code_point >> 0) & 0x3f) | 0x80);
+        length = 4;
     } else {
-        append(0xef);
-        append(0xbf);
-        append(0xbd);
+        bytes[0] = (char)0xef;
+        bytes[1] = (char)0xbf;
+        bytes[2] = (char)0xbd;
+        length = 3;
     }
+    append(bytes, length);
 }
 
 void StringBuilder::append(Utf16View const& utf16_view)
@@ -6,20 +6,114 @@
 
 #pragma once
 
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
 namespace AK {
 
-constexpr u32 string_hash(char const* characters, size_t length)
+namespace Detail {
+
+// This is a variant of wyhash (https://github.com/wangyi-fudan/wyhash), which reads its input
+// eight bytes at a time and mixes them in with 64x64 -> 128-bit multiplications.
+
+static constexpr u64 string_hash_secret[4] = { 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull };
+
+constexpr void string_hash_multiply(u64& a, u64& b)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 result = a;
+    result *= b;
+    a = static_cast<u64>(result);
+    b = static_cast<u64>(result >> 64);
+#else
+    u64 a_high = a >> 32, a_low = static_cast<u32>(a);
+    u64 b_high = b >> 32, b_low = static_cast<u32>(b);
+    u64 high = a_high * b_high, middle0 = a_high * b_low, middle1 = b_high * a_low, low = a_low * b_low;
+    u64 temporary = low + (middle0 << 32);
+    u64 carry = temporary < low;
+    u64 result_low = temporary + (middle1 << 32);
+    carry += result_low < temporary;
+    a = result_low;
+    b = high + (middle0 >> 32) + (middle1 >> 32) + carry;
+#endif
+}
+
+constexpr u64 string_hash_mix(u64 a, u64 b)
+{
+    string_hash_multiply(a, b);
+    return a ^ b;
+}
+
+// Loads are always little-endian, so that hashes computed at compile time match those computed at run time.
+template<size_t Size>
+constexpr u64 string_hash_read(char const* characters)
 {
-    u32 hash = 0;
-    for (size_t i = 0; i < length; ++i) {
-        hash += (u32)characters[i];
-        hash += (hash << 10);
-        hash ^= (hash >> 6);
+    if (!is_constant_evaluated()) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        Conditional<Size == 8, u64, u32> value;
+        __builtin_memcpy(&value, characters, Size);
+        return value;
+#endif
     }
-    hash += hash << 3;
-    hash ^= hash >> 11;
-    hash += hash << 15;
-    return hash;
+    u64 value = 0;
+    for (size_t i = 0; i < Size; ++i)
+        value |= static_cast<u64>(static_cast<u8>(characters[i])) << (i * 8);
+    return value;
+}
+
+constexpr u32 string_hash_impl(char const* characters, size_t length)
+{
+    auto const* secret = string_hash_secret;
+    u64 seed = secret[0];
+    u64 a = 0;
+    u64 b = 0;
+
+    if (length <= 16) [[likely]] {
+        if (length >= 4) {
+            size_t middle = (length >> 3) << 2;
+            a = (string_hash_read<4>(characters) << 32) | string_hash_read<4>(characters + middle);
+            b = (string_hash_read<4>(characters + length - 4) << 32) | string_hash_read<4>(characters + length - 4 - middle);
+        } else if (length > 0) {
+            a = (static_cast<u64>(static_cast<u8>(characters[0])) << 16)
+                | (static_cast<u64>(static_cast<u8>(characters[length >> 1])) << 8)
+                | static_cast<u8>(characters[length - 1]);
+        }
+    } else {
+        size_t remaining = length;
+        if (remaining > 48) {
+            // Three independent lanes, so that the multiplications can overlap.
+            u64 seed1 = seed;
+            u64 seed2 = seed;
+            do {
+                seed = string_hash_mix(string_hash_read<8>(characters) ^ secret[1], string_hash_read<8>(characters + 8) ^ seed);
+                seed1 = string_hash_mix(string_hash_read<8>(characters + 16) ^ secret[2], string_hash_read<8>(characters + 24) ^ seed1);
+                seed2 = string_hash_mix(string_hash_read<8>(characters + 32) ^ secret[3], string_hash_read<8>(characters + 40) ^ seed2);
+                characters += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (remaining > 16) {
+            seed = string_hash_mix(string_hash_read<8>(characters) ^ secret[1], string_hash_read<8>(characters + 8) ^ seed);
+            characters += 16;
+            remaining -= 16;
+        }
+        a = string_hash_read<8>(characters + remaining - 16);
+        b = string_hash_read<8>(characters + remaining - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    string_hash_multiply(a, b);
+    auto hash = string_hash_mix(a ^ secret[0] ^ length, b ^ secret[1]);
+    return static_cast<u32>(hash) ^ static_cast<u32>(hash >> 32);
+}
+
+}
+
+constexpr u32 string_hash(char const* characters, size_t length)
+{
+    return Detail::string_hash_impl(characters, length);
 }
 
 }
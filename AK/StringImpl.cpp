@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/CharacterTypes.h>
 #include <AK/FlyString.h>
 #include <AK/HashTable.h>
@@ -26,6 +27,28 @@ StringImpl& StringImpl::the_empty_stringimpl()
     return *s_the_empty_stringimpl;
 }
 
+static Atomic<StringImpl*> s_the_single_byte_stringimpls[256];
+
+StringImpl& StringImpl::the_single_byte_stringimpl(u8 byte)
+{
+    auto& slot = s_the_single_byte_stringimpls[byte];
+    if (auto* impl = slot.load(AK::memory_order_acquire))
+        return *impl;
+
+    // This reference is never released, so the impl lives forever.
+    char* buffer;
+    auto* impl = &create_uninitialized(1, buffer).leak_ref();
+    buffer[0] = (char)byte;
+
+    StringImpl* expected = nullptr;
+    if (slot.compare_exchange_strong(expected, impl, AK::memory_order_acq_rel))
+        return *impl;
+
+    // Another thread got there first.
+    impl->unref();
+    return *expected;
+}
+
 StringImpl::StringImpl(ConstructWithInlineBufferTag, size_t length)
     : m_length(length)
 {
@@ -65,6 +88,8 @@ RefPtr<StringImpl> StringImpl::create(const char* cstring, size_t length, Should
 
     if (!length)
         return the_empty_stringimpl();
+    if (length == 1)
+        return the_single_byte_stringimpl(cstring[0]);
 
     char* buffer;
     auto new_stringimpl = create_uninitialized(length, buffer);
@@ -40,6 +40,8 @@ public:
     }
 
     static StringImpl& the_empty_stringimpl();
+    // Strings made of a single byte are very common, and are all shared instead of being allocated every time.
+    static StringImpl& the_single_byte_stringimpl(u8);
 
     ~StringImpl();
 
@@ -4,8 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <AK/CharacterTypes.h>
-#include <AK/StringBuilder.h>
+#include <AK/SIMD.h>
 #include <AK/StringView.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf32View.h>
@@ -20,30 +21,99 @@ static constexpr u16 low_surrogate_max = 0xdfff;
 static constexpr u32 replacement_code_point = 0xfffd;
 static constexpr u32 first_supplementary_plane_code_point = 0x10000;
 
-template<typename UtfViewType>
-static Vector<u16> to_utf16_impl(UtfViewType const& view) requires(IsSame<UtfViewType, Utf8View> || IsSame<UtfViewType, Utf32View>)
+// Converts a run of ASCII bytes to the same number of code units, a whole vector at a time.
+static void widen_ascii(u8 const* bytes, size_t length, u16* output)
 {
-    Vector<u16> utf16_data;
+    constexpr size_t chunk_size = sizeof(SIMD::u8x16);
+    size_t offset = 0;
+    for (; offset + chunk_size <= length; offset += chunk_size) {
+        SIMD::u8x16 chunk;
+        __builtin_memcpy(&chunk, bytes + offset, chunk_size);
+        auto wide_chunk = __builtin_convertvector(chunk, SIMD::u16x16);
+        __builtin_memcpy(output + offset, &wide_chunk, sizeof(wide_chunk));
+    }
+    for (; offset < length; ++offset)
+        output[offset] = bytes[offset];
+}
 
-    for (auto code_point : view)
-        code_point_to_utf16(utf16_data, code_point);
+// Writes the code point to `output`, and returns how many code units that took.
+static size_t encode_code_point(u16* output, u32 code_point)
+{
+    VERIFY(is_unicode(code_point));
 
-    return utf16_data;
+    if (code_point < first_supplementary_plane_code_point) {
+        output[0] = static_cast<u16>(code_point);
+        return 1;
+    }
+    code_point -= first_supplementary_plane_code_point;
+    output[0] = static_cast<u16>(high_surrogate_min | (code_point >> 10));
+    output[1] = static_cast<u16>(low_surrogate_min | (code_point & 0x3ff));
+    return 2;
 }
 
 Vector<u16> utf8_to_utf16(StringView const& utf8_view)
 {
-    return to_utf16_impl(Utf8View { utf8_view });
+    return utf8_to_utf16(Utf8View { utf8_view });
 }
 
 Vector<u16> utf8_to_utf16(Utf8View const& utf8_view)
 {
-    return to_utf16_impl(utf8_view);
+    auto const* bytes = utf8_view.bytes();
+    auto length = utf8_view.byte_length();
+
+    // No code point takes more UTF-16 code units than it takes UTF-8 bytes, so this is always enough room.
+    Vector<u16> utf16_data;
+    utf16_data.resize(length);
+    auto* output = utf16_data.data();
+    size_t output_length = 0;
+
+    for (size_t offset = 0; offset < length;) {
+        u8 lead_byte = bytes[offset];
+        if (lead_byte < 0x80) {
+            auto ascii_length = Detail::ascii_prefix_length(bytes + offset, length - offset);
+            widen_ascii(bytes + offset, ascii_length, output + output_length);
+            offset += ascii_length;
+            output_length += ascii_length;
+            continue;
+        }
+
+        // Well-formed two and three byte sequences are decoded right here, the same way the iterator would.
+        auto is_continuation_byte = [&](size_t index) { return index < length && (bytes[index] & 0xc0) == 0x80; };
+        if ((lead_byte & 0xe0) == 0xc0 && is_continuation_byte(offset + 1)) {
+            output[output_length++] = static_cast<u16>(((lead_byte & 0x1f) << 6) | (bytes[offset + 1] & 0x3f));
+            offset += 2;
+            continue;
+        }
+        if ((lead_byte & 0xf0) == 0xe0 && is_continuation_byte(offset + 1) && is_continuation_byte(offset + 2)) {
+            output[output_length++] = static_cast<u16>(((lead_byte & 0x0f) << 12) | ((bytes[offset + 1] & 0x3f) << 6) | (bytes[offset + 2] & 0x3f));
+            offset += 3;
+            continue;
+        }
+
+        // Everything else, including invalid sequences, is left to the iterator.
+        auto iterator = utf8_view.substring_view(offset).begin();
+        output_length += encode_code_point(output + output_length, *iterator);
+        offset += iterator.underlying_code_point_length_in_bytes();
+    }
+
+    // Text that is mostly not ASCII takes a lot fewer code units than bytes, so don't keep all that room around.
+    if (output_length < utf16_data.size() / 4 * 3) {
+        Vector<u16> exact_utf16_data;
+        exact_utf16_data.append(output, output_length);
+        return exact_utf16_data;
+    }
+    utf16_data.shrink(output_length);
+    return utf16_data;
 }
 
 Vector<u16> utf32_to_utf16(Utf32View const& utf32_view)
 {
-    return to_utf16_impl(utf32_view);
+    Vector<u16> utf16_data;
+
+    for (auto code_point : utf32_view)
+        code_point_to_utf16(utf16_data, code_point);
+
+    return utf16_data;
 }
 
 void code_point_to_utf16(Vector<u16>& string, u32 code_point)
@@ -77,31 +147,110 @@ u32 Utf16View::decode_surrogate_pair(u16 high_surrogate, u16 low_surrogate)
     return ((high_surrogate - high_surrogate_min) << 10) + (low_surrogate - low_surrogate_min) + first_supplementary_plane_code_point;
 }
 
+// Returns how many of the code units at `ptr` are ASCII, looking at a whole vector at a time.
+static size_t ascii_code_unit_prefix_length(u16 const* ptr, size_t length)
+{
+    constexpr size_t chunk_size = sizeof(SIMD::u16x8) / sizeof(u16);
+    size_t offset = 0;
+    for (; offset + chunk_size <= length; offset += chunk_size) {
+        SIMD::u16x8 chunk;
+        __builtin_memcpy(&chunk, ptr + offset, sizeof(chunk));
+        auto non_ascii_bits = bit_cast<SIMD::u64x2>(chunk & 0xff80);
+        if ((non_ascii_bits[0] | non_ascii_bits[1]) != 0)
+            break;
+    }
+    while (offset < length && ptr[offset] < 0x80)
+        ++offset;
+    return offset;
+}
+
+// Converts a run of ASCII code units to the same number of bytes, a whole vector at a time.
+static void narrow_ascii(u16 const* ptr, size_t length, char* output)
+{
+    constexpr size_t chunk_size = sizeof(SIMD::u16x8) / sizeof(u16);
+    size_t offset = 0;
+    for (; offset + chunk_size <= length; offset += chunk_size) {
+        SIMD::u16x8 chunk;
+        __builtin_memcpy(&chunk, ptr + offset, sizeof(chunk));
+        auto narrow_chunk = __builtin_convertvector(chunk, SIMD::u8x8);
+        __builtin_memcpy(output + offset, &narrow_chunk, chunk_size);
+    }
+    for (; offset < length; ++offset)
+        output[offset] = static_cast<char>(ptr[offset]);
+}
+
+// Writes the code point to `output` as UTF-8, and returns how many bytes that took.
+static size_t encode_code_point(char* output, u32 code_point)
+{
+    if (code_point < 0x800) {
+        output[0] = static_cast<char>(((code_point >> 6) & 0x1f) | 0xc0);
+        output[1] = static_cast<char>((code_point & 0x3f) | 0x80);
+        return 2;
+    }
+    if (code_point < first_supplementary_plane_code_point) {
+        output[0] = static_cast<char>(((code_point >> 12) & 0x0f) | 0xe0);
+        output[1] = static_cast<char>(((code_point >> 6) & 0x3f) | 0x80);
+        output[2] = static_cast<char>((code_point & 0x3f) | 0x80);
+        return 3;
+    }
+    output[0] = static_cast<char>(((code_point >> 18) & 0x07) | 0xf0);
+    output[1] = static_cast<char>(((code_point >> 12) & 0x3f) | 0x80);
+    output[2] = static_cast<char>(((code_point >> 6) & 0x3f) | 0x80);
+    output[3] = static_cast<char>((code_point & 0x3f) | 0x80);
+    return 4;
+}
+
 String Utf16View::to_utf8(AllowInvalidCodeUnits allow_invalid_code_units) const
 {
-    StringBuilder builder;
-
-    if (allow_invalid_code_units == AllowInvalidCodeUnits::Yes) {
-        for (auto const* ptr = begin_ptr(); ptr < end_ptr(); ++ptr) {
-            if (is_high_surrogate(*ptr)) {
-                auto const* next = ptr + 1;
-
-                if ((next < end_ptr()) && is_low_surrogate(*next)) {
-                    auto code_point = decode_surrogate_pair(*ptr, *next);
-                    builder.append_code_point(code_point);
-                    ++ptr;
-                    continue;
-                }
-            }
-
-            builder.append_code_point(static_cast<u32>(*ptr));
+    // A lone surrogate takes three bytes whether it is kept or replaced, so the length of the result can be
+    // worked out up front, and the result encoded straight into the string.
+    size_t utf8_length = 0;
+    for (auto const* ptr = begin_ptr(); ptr < end_ptr();) {
+        if (*ptr < 0x80) {
+            auto ascii_length = ascii_code_unit_prefix_length(ptr, end_ptr() - ptr);
+            utf8_length += ascii_length;
+            ptr += ascii_length;
+        } else if (*ptr < 0x800) {
+            utf8_length += 2;
+            ++ptr;
+        } else if (is_high_surrogate(*ptr) && (ptr + 1 < end_ptr()) && is_low_surrogate(*(ptr + 1))) {
+            utf8_length += 4;
+            ptr += 2;
+        } else {
+            utf8_length += 3;
+            ++ptr;
         }
-    } else {
-        for (auto code_point : *this)
-            builder.append_code_point(code_point);
     }
 
-    return builder.build();
+    if (utf8_length == 0)
+        return String::empty();
+
+    char* output;
+    auto impl = StringImpl::create_uninitialized(utf8_length, output);
+
+    for (auto const* ptr = begin_ptr(); ptr < end_ptr();) {
+        if (*ptr < 0x80) {
+            auto ascii_length = ascii_code_unit_prefix_length(ptr, end_ptr() - ptr);
+            narrow_ascii(ptr, ascii_length, output);
+            output += ascii_length;
+            ptr += ascii_length;
+            continue;
+        }
+
+        auto code_point = static_cast<u32>(*ptr);
+        size_t code_units = 1;
+        if (is_high_surrogate(*ptr) && (ptr + 1 < end_ptr()) && is_low_surrogate(*(ptr + 1))) {
+            code_point = decode_surrogate_pair(*ptr, *(ptr + 1));
+            code_units = 2;
+        } else if (allow_invalid_code_units == AllowInvalidCodeUnits::No && (is_high_surrogate(*ptr) || is_low_surrogate(*ptr))) {
+            code_point = replacement_code_point;
+        }
+
+        output += encode_code_point(output, code_point);
+        ptr += code_units;
+    }
+
+    return impl;
 }
 
 size_t Utf16View::length_in_code_points() const
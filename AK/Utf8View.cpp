@@ -6,11 +6,39 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/BitCast.h>
 #include <AK/Format.h>
+#include <AK/SIMD.h>
 #include <AK/Utf8View.h>
 
 namespace AK {
 
+namespace Detail {
+
+size_t ascii_prefix_length(u8 const* bytes, size_t length)
+{
+    constexpr size_t chunk_size = sizeof(SIMD::u8x16);
+    size_t offset = 0;
+    for (; offset + chunk_size <= length; offset += chunk_size) {
+        SIMD::u8x16 chunk;
+        __builtin_memcpy(&chunk, bytes + offset, chunk_size);
+#ifdef __SSE2__
+        // Gathers the top bit of every byte, which is only set in non-ASCII ones.
+        if (u32 non_ascii = static_cast<u16>(__builtin_ia32_pmovmskb128(bit_cast<SIMD::c8x16>(chunk))); non_ascii != 0)
+            return offset + count_trailing_zeroes_32(non_ascii);
+#else
+        auto words = bit_cast<SIMD::u64x2>(chunk);
+        if (((words[0] | words[1]) & 0x8080808080808080ull) != 0)
+            break;
+#endif
+    }
+    while (offset < length && bytes[offset] < 0x80)
+        ++offset;
+    return offset;
+}
+
+}
+
 Utf8CodePointIterator Utf8View::iterator_at_byte_offset(size_t byte_offset) const
 {
     size_t current_offset = 0;
@@ -100,6 +128,14 @@ bool Utf8View::validate(size_t& valid_bytes) const
 {
     valid_bytes = 0;
     for (auto ptr = begin_ptr(); ptr < end_ptr(); ptr++) {
+        if (*ptr < 0x80) {
+            // ASCII is always valid, so runs of it are skipped over in bulk.
+            auto ascii_length = Detail::ascii_prefix_length(ptr, end_ptr() - ptr);
+            valid_bytes += ascii_length;
+            ptr += ascii_length - 1;
+            continue;
+        }
+
         size_t code_point_length_in_bytes;
         u32 value;
         bool first_byte_makes_sense = decode_first_byte(*ptr, code_point_length_in_bytes, value);
@@ -123,8 +159,15 @@ bool Utf8View::validate(size_t& valid_bytes) const
 size_t Utf8View::calculate_length() const
 {
     size_t length = 0;
-    for ([[maybe_unused]] auto code_point : *this) {
-        ++length;
+    for (auto ptr = begin_ptr(); ptr < end_ptr(); ++length) {
+        if (*ptr < 0x80) {
+            // Every ASCII byte is a code point of its own.
+            auto ascii_length = Detail::ascii_prefix_length(ptr, end_ptr() - ptr);
+            ptr += ascii_length;
+            length += ascii_length - 1;
+            continue;
+        }
+        ptr += Utf8CodePointIterator { ptr, static_cast<size_t>(end_ptr() - ptr) }.underlying_code_point_length_in_bytes();
     }
     return length;
 }
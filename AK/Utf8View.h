@@ -15,6 +15,13 @@ namespace AK {
 
 class Utf8View;
 
+namespace Detail {
+
+// Returns how many of the bytes at the start of `bytes` are ASCII, checking a whole vector of them at a time.
+size_t ascii_prefix_length(u8 const* bytes, size_t length);
+
+}
+
 class Utf8CodePointIterator {
     friend class Utf8View;
 
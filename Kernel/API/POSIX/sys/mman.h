@@ -33,6 +33,8 @@ extern "C" {
 
 #define MADV_SET_VOLATILE 0x100
 #define MADV_SET_NONVOLATILE 0x200
+#define MADV_SEQUENTIAL 0x400
+#define MADV_WILLNEED 0x800
 
 #ifdef __cplusplus
 }
@@ -17,6 +17,8 @@
 constexpr int syscall_vector = 0x82;
 
 extern "C" {
+struct epoll_event;
+struct iovec;
 struct pollfd;
 struct timeval;
 struct timespec;
@@ -60,6 +62,7 @@ enum class NeedsBigProcessLock {
     S(clock_settime, NeedsBigProcessLock::Yes)              \
     S(close, NeedsBigProcessLock::Yes)                      \
     S(connect, NeedsBigProcessLock::Yes)                    \
+    S(copy_file_range, NeedsBigProcessLock::No)             \
     S(create_inode_watcher, NeedsBigProcessLock::Yes)       \
     S(create_thread, NeedsBigProcessLock::Yes)              \
     S(dbgputch, NeedsBigProcessLock::No)                    \
@@ -69,6 +72,9 @@ enum class NeedsBigProcessLock {
     S(dump_backtrace, NeedsBigProcessLock::No)              \
     S(dup2, NeedsBigProcessLock::Yes)                       \
     S(emuctl, NeedsBigProcessLock::Yes)                     \
+    S(epoll_create, NeedsBigProcessLock::Yes)               \
+    S(epoll_ctl, NeedsBigProcessLock::Yes)                  \
+    S(epoll_wait, NeedsBigProcessLock::Yes)                 \
     S(execve, NeedsBigProcessLock::Yes)                     \
     S(exit, NeedsBigProcessLock::Yes)                       \
     S(exit_thread, NeedsBigProcessLock::Yes)                \
@@ -77,11 +83,11 @@ enum class NeedsBigProcessLock {
     S(fchown, NeedsBigProcessLock::Yes)                     \
     S(fcntl, NeedsBigProcessLock::Yes)                      \
     S(fork, NeedsBigProcessLock::Yes)                       \
-    S(fstat, NeedsBigProcessLock::Yes)                      \
+    S(fstat, NeedsBigProcessLock::No)                       \
     S(fstatvfs, NeedsBigProcessLock::Yes)                   \
     S(fsync, NeedsBigProcessLock::Yes)                      \
     S(ftruncate, NeedsBigProcessLock::Yes)                  \
-    S(futex, NeedsBigProcessLock::Yes)                      \
+    S(futex, NeedsBigProcessLock::No)                       \
     S(get_dir_entries, NeedsBigProcessLock::Yes)            \
     S(get_process_name, NeedsBigProcessLock::Yes)           \
     S(get_stack_bounds, NeedsBigProcessLock::No)            \
@@ -115,12 +121,12 @@ enum class NeedsBigProcessLock {
     S(killpg, NeedsBigProcessLock::Yes)                     \
     S(link, NeedsBigProcessLock::Yes)                       \
     S(listen, NeedsBigProcessLock::Yes)                     \
-    S(lseek, NeedsBigProcessLock::Yes)                      \
+    S(lseek, NeedsBigProcessLock::No)                       \
     S(madvise, NeedsBigProcessLock::Yes)                    \
     S(map_time_page, NeedsBigProcessLock::Yes)              \
     S(mkdir, NeedsBigProcessLock::Yes)                      \
     S(mknod, NeedsBigProcessLock::Yes)                      \
-    S(mmap, NeedsBigProcessLock::Yes)                       \
+    S(mmap, NeedsBigProcessLock::No)                        \
     S(mount, NeedsBigProcessLock::Yes)                      \
     S(mprotect, NeedsBigProcessLock::Yes)                   \
     S(mremap, NeedsBigProcessLock::Yes)                     \
@@ -133,25 +139,30 @@ enum class NeedsBigProcessLock {
     S(pledge, NeedsBigProcessLock::Yes)                     \
     S(poll, NeedsBigProcessLock::Yes)                       \
     S(prctl, NeedsBigProcessLock::Yes)                      \
+    S(pread, NeedsBigProcessLock::No)                       \
+    S(preadv, NeedsBigProcessLock::No)                      \
     S(profiling_disable, NeedsBigProcessLock::Yes)          \
     S(profiling_enable, NeedsBigProcessLock::Yes)           \
     S(profiling_free_buffer, NeedsBigProcessLock::Yes)      \
     S(ptrace, NeedsBigProcessLock::Yes)                     \
     S(ptsname, NeedsBigProcessLock::Yes)                    \
     S(purge, NeedsBigProcessLock::Yes)                      \
-    S(read, NeedsBigProcessLock::Yes)                       \
+    S(pwrite, NeedsBigProcessLock::No)                      \
+    S(pwritev, NeedsBigProcessLock::No)                     \
+    S(read, NeedsBigProcessLock::No)                        \
     S(readlink, NeedsBigProcessLock::Yes)                   \
-    S(readv, NeedsBigProcessLock::Yes)                      \
+    S(readv, NeedsBigProcessLock::No)                       \
     S(realpath, NeedsBigProcessLock::Yes)                   \
     S(recvfd, NeedsBigProcessLock::Yes)                     \
-    S(recvmsg, NeedsBigProcessLock::Yes)                    \
+    S(recvmsg, NeedsBigProcessLock::No)                     \
     S(rename, NeedsBigProcessLock::Yes)                     \
     S(rmdir, NeedsBigProcessLock::Yes)                      \
     S(sched_getparam, NeedsBigProcessLock::Yes)             \
     S(sched_setparam, NeedsBigProcessLock::Yes)             \
     S(select, NeedsBigProcessLock::Yes)                     \
     S(sendfd, NeedsBigProcessLock::Yes)                     \
-    S(sendmsg, NeedsBigProcessLock::Yes)                    \
+    S(sendfile, NeedsBigProcessLock::No)                    \
+    S(sendmsg, NeedsBigProcessLock::No)                     \
     S(set_coredump_metadata, NeedsBigProcessLock::Yes)      \
     S(set_mmap_name, NeedsBigProcessLock::Yes)              \
     S(set_process_name, NeedsBigProcessLock::Yes)           \
@@ -190,8 +201,8 @@ enum class NeedsBigProcessLock {
     S(unveil, NeedsBigProcessLock::Yes)                     \
     S(utime, NeedsBigProcessLock::Yes)                      \
     S(waitid, NeedsBigProcessLock::Yes)                     \
-    S(write, NeedsBigProcessLock::Yes)                      \
-    S(writev, NeedsBigProcessLock::Yes)                     \
+    S(write, NeedsBigProcessLock::No)                       \
+    S(writev, NeedsBigProcessLock::No)                      \
     S(yield, NeedsBigProcessLock::No)
 
 namespace Syscall {
@@ -261,6 +272,50 @@ struct SC_open_params {
     u16 mode;
 };
 
+struct SC_pread_params {
+    int fd;
+    void* buffer;
+    size_t size;
+    int64_t offset;
+};
+
+struct SC_pwrite_params {
+    int fd;
+    const void* data;
+    size_t size;
+    int64_t offset;
+};
+
+struct SC_preadv_params {
+    int fd;
+    const struct iovec* iov;
+    int iov_count;
+    int64_t offset;
+};
+
+struct SC_pwritev_params {
+    int fd;
+    const struct iovec* iov;
+    int iov_count;
+    int64_t offset;
+};
+
+struct SC_sendfile_params {
+    int out_fd;
+    int in_fd;
+    int64_t* offset;
+    size_t count;
+};
+
+struct SC_copy_file_range_params {
+    int fd_in;
+    int64_t* offset_in;
+    int fd_out;
+    int64_t* offset_out;
+    size_t length;
+    unsigned flags;
+};
+
 struct SC_select_params {
     int nfds;
     fd_set* readfds;
@@ -277,6 +332,21 @@ struct SC_poll_params {
     const u32* sigmask;
 };
 
+struct SC_epoll_ctl_params {
+    int epfd;
+    int op;
+    int fd;
+    struct epoll_event* event;
+};
+
+struct SC_epoll_wait_params {
+    int epfd;
+    struct epoll_event* events;
+    int maxevents;
+    const struct timespec* timeout;
+    const u32* sigmask;
+};
+
 struct SC_clock_nanosleep_params {
     int clock_id;
     int flags;
@@ -7,6 +7,7 @@
 #include <AK/IntrusiveList.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
+#include <Kernel/FileSystem/ReadaheadState.h>
 #include <Kernel/Process.h>
 
 namespace Kernel {
@@ -21,10 +22,14 @@ struct CacheEntry {
 class DiskCache {
 public:
     static constexpr size_t EntryCount = 10000;
-    explicit DiskCache(BlockBasedFileSystem& fs, NonnullOwnPtr<KBuffer> cached_block_data, NonnullOwnPtr<KBuffer> entries_buffer)
+    // The most we read from the device in one request when filling the cache ahead of time.
+    static constexpr size_t PrefetchBufferSize = ReadaheadState::max_window;
+
+    explicit DiskCache(BlockBasedFileSystem& fs, NonnullOwnPtr<KBuffer> cached_block_data, NonnullOwnPtr<KBuffer> entries_buffer, NonnullOwnPtr<KBuffer> prefetch_buffer)
         : m_fs(fs)
         , m_cached_block_data(move(cached_block_data))
         , m_entries(move(entries_buffer))
+        , m_prefetch_buffer(move(prefetch_buffer))
     {
         for (size_t i = 0; i < EntryCount; ++i) {
             entries()[i].data = m_cached_block_data->data() + i * m_fs.block_size();
@@ -84,6 +89,14 @@ public:
         return new_entry;
     }
 
+    bool has_data(BlockBasedFileSystem::BlockIndex block_index) const
+    {
+        auto it = m_hash.find(block_index);
+        return it != m_hash.end() && it->value->has_data;
+    }
+
+    KBuffer& prefetch_buffer() { return *m_prefetch_buffer; }
+
     const CacheEntry* entries() const { return (const CacheEntry*)m_entries->data(); }
     CacheEntry* entries() { return (CacheEntry*)m_entries->data(); }
 
@@ -101,6 +114,7 @@ private:
     mutable IntrusiveList<&CacheEntry::list_node> m_dirty_list;
     NonnullOwnPtr<KBuffer> m_cached_block_data;
     NonnullOwnPtr<KBuffer> m_entries;
+    NonnullOwnPtr<KBuffer> m_prefetch_buffer;
     bool m_dirty { false };
 };
 
@@ -119,7 +133,8 @@ KResult BlockBasedFileSystem::initialize()
     VERIFY(block_size() != 0);
     auto cached_block_data = TRY(KBuffer::try_create_with_size(DiskCache::EntryCount * block_size()));
     auto entries_data = TRY(KBuffer::try_create_with_size(DiskCache::EntryCount * sizeof(CacheEntry)));
-    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(*this, move(cached_block_data), move(entries_data))));
+    auto prefetch_buffer = TRY(KBuffer::try_create_with_size(max<u64>(DiskCache::PrefetchBufferSize, block_size())));
+    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(*this, move(cached_block_data), move(entries_data), move(prefetch_buffer))));
 
     m_cache.with_exclusive([&](auto& cache) {
         cache = move(disk_cache);
@@ -241,6 +256,8 @@ KResult BlockBasedFileSystem::read_blocks(BlockIndex index, unsigned count, User
         return EINVAL;
     if (count == 1)
         return read_block(index, &buffer, block_size(), 0, allow_cache);
+    if (allow_cache)
+        TRY(prefetch_blocks(index, count));
     auto out = buffer;
     for (unsigned i = 0; i < count; ++i) {
         TRY(read_block(BlockIndex { index.value() + i }, &out, block_size(), 0, allow_cache));
@@ -250,6 +267,44 @@ KResult BlockBasedFileSystem::read_blocks(BlockIndex index, unsigned count, User
     return KSuccess;
 }
 
+KResult BlockBasedFileSystem::prefetch_blocks(BlockIndex index, size_t count) const
+{
+    VERIFY(m_logical_block_size);
+    dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem::prefetch_blocks {}, count={}", index, count);
+
+    return m_cache.with_exclusive([&](auto& cache) -> KResult {
+        auto& prefetch_buffer = cache->prefetch_buffer();
+        size_t max_blocks_per_read = prefetch_buffer.size() / block_size();
+
+        // Fill each run of blocks we don't have yet with a single read, instead of going to the device once per block.
+        size_t i = 0;
+        while (i < count) {
+            if (cache->has_data(BlockIndex { index.value() + i })) {
+                ++i;
+                continue;
+            }
+            size_t run_length = 1;
+            while (i + run_length < count && run_length < max_blocks_per_read && !cache->has_data(BlockIndex { index.value() + i + run_length }))
+                ++run_length;
+
+            auto base_offset = (index.value() + i) * block_size();
+            auto buffer = UserOrKernelBuffer::for_kernel_buffer(prefetch_buffer.data());
+            auto nread = TRY(file_description().read(buffer, base_offset, run_length * block_size()));
+            for (size_t j = 0; j < nread / block_size(); ++j) {
+                auto& entry = cache->get(BlockIndex { index.value() + i + j });
+                if (entry.has_data)
+                    continue;
+                memcpy(entry.data, prefetch_buffer.data() + j * block_size(), block_size());
+                entry.has_data = true;
+            }
+            if (nread < run_length * block_size())
+                break;
+            i += run_length;
+        }
+        return KSuccess;
+    });
+}
+
 void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
 {
     m_cache.with_exclusive([&](auto& cache) {
@@ -28,6 +28,7 @@ protected:
 
     KResult read_block(BlockIndex, UserOrKernelBuffer*, size_t count, size_t offset = 0, bool allow_cache = true) const;
     KResult read_blocks(BlockIndex, unsigned count, UserOrKernelBuffer&, bool allow_cache = true) const;
+    KResult prefetch_blocks(BlockIndex, size_t count) const;
 
     bool raw_read(BlockIndex, UserOrKernelBuffer&);
     bool raw_write(BlockIndex, const UserOrKernelBuffer&);
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/Epoll.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+static BlockFlags block_flags_for(u32 events)
+{
+    auto block_flags = BlockFlags::None;
+    if (events & EPOLLIN)
+        block_flags |= BlockFlags::Read;
+    if (events & EPOLLOUT)
+        block_flags |= BlockFlags::Write;
+    if (events & EPOLLPRI)
+        block_flags |= BlockFlags::ReadPriority;
+    return block_flags;
+}
+
+Epoll::Watch::Watch(Epoll& epoll, int fd, OpenFileDescription& description, epoll_event const& event)
+    : Thread::FileBlocker(NotBlockingAnyThread {})
+    , m_epoll(epoll)
+    , m_fd(fd)
+    , m_description(description)
+    , m_description_ptr(&description)
+    , m_file(description.file())
+    , m_event(event)
+{
+}
+
+Epoll::Watch::~Watch()
+{
+    VERIFY(!m_ready_list_node.is_in_list());
+    stop_watching();
+}
+
+void Epoll::Watch::stop_watching()
+{
+    // The file may go away along with m_file, before ~Blocker would get to leave its blocker set.
+    m_file->blocker_set().remove_blocker(*this);
+    set_blocker_set_raw_locked(nullptr);
+}
+
+u32 Epoll::Watch::ready_events(OpenFileDescription& description) const
+{
+    auto unblocked_flags = description.should_unblock(block_flags_for(m_event.events));
+    u32 events = 0;
+    if (has_flag(unblocked_flags, BlockFlags::Read))
+        events |= EPOLLIN;
+    if (has_flag(unblocked_flags, BlockFlags::Write))
+        events |= EPOLLOUT;
+    if (has_flag(unblocked_flags, BlockFlags::ReadPriority))
+        events |= EPOLLPRI;
+    return events;
+}
+
+bool Epoll::Watch::unblock_if_conditions_are_met(bool, void*)
+{
+    // This is called with the file's blocker set locked, which the description's destructor may need as well,
+    // so we can't take a reference to the description here. Whether it is really ready is checked later.
+    m_epoll.did_change_readiness(*this);
+
+    // Never leave the blocker set, so that we keep hearing about the file.
+    return false;
+}
+
+KResultOr<NonnullRefPtr<Epoll>> Epoll::try_create()
+{
+    return adopt_nonnull_ref_or_enomem(new (nothrow) Epoll);
+}
+
+Epoll::~Epoll()
+{
+    (void)close();
+}
+
+bool Epoll::can_read(const OpenFileDescription&, size_t) const
+{
+    SpinlockLocker lock(m_ready_lock);
+    return !m_ready_watches.is_empty();
+}
+
+KResult Epoll::close()
+{
+    MutexLocker locker(m_lock);
+    while (!m_watches.is_empty())
+        remove_watch_locked(m_watches.begin()->key);
+    return KSuccess;
+}
+
+void Epoll::did_close_description(OpenFileDescription const& description)
+{
+    MutexLocker locker(m_lock);
+    // The description may have been watched under several fds.
+    for (;;) {
+        auto it = m_watches.begin();
+        while (it != m_watches.end() && it->key.description != &description)
+            ++it;
+        if (it == m_watches.end())
+            break;
+        remove_watch_locked(it->key);
+    }
+}
+
+void Epoll::did_change_readiness(Watch& watch)
+{
+    {
+        SpinlockLocker lock(m_ready_lock);
+        if (!watch.m_event.events || watch.m_ready_list_node.is_in_list())
+            return;
+        m_ready_watches.append(watch);
+    }
+    evaluate_block_conditions();
+}
+
+KResult Epoll::add_watch(int fd, OpenFileDescription& description, epoll_event const& event)
+{
+    if (description.is_epoll())
+        return EINVAL;
+
+    MutexLocker locker(m_lock);
+    WatchKey key { fd, &description };
+    if (m_watches.contains(key))
+        return EEXIST;
+
+    TRY(description.did_start_being_watched_by(*this));
+    auto watch = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Watch(*this, fd, description, event)));
+    auto& watch_ref = *watch;
+    if (m_watches.try_set(key, move(watch)) == AK::HashSetResult::Failed)
+        return ENOMEM;
+    // Joining the blocker set reports whether the description is ready right away, but never fails, as we
+    // don't ever want to leave it.
+    bool did_start_watching = watch_ref.start_watching();
+    VERIFY(did_start_watching);
+    return KSuccess;
+}
+
+KResult Epoll::modify_watch(int fd, OpenFileDescription& description, epoll_event const& event)
+{
+    MutexLocker locker(m_lock);
+    auto it = m_watches.find({ fd, &description });
+    if (it == m_watches.end())
+        return ENOENT;
+
+    auto& watch = *it->value;
+    {
+        SpinlockLocker lock(m_ready_lock);
+        watch.set_event(event);
+    }
+    // Edge-triggered or not, whatever the description is ready for now counts as a new event.
+    did_change_readiness(watch);
+    return KSuccess;
+}
+
+KResult Epoll::remove_watch(int fd, OpenFileDescription& description)
+{
+    MutexLocker locker(m_lock);
+    WatchKey key { fd, &description };
+    if (!m_watches.contains(key))
+        return ENOENT;
+    remove_watch_locked(key);
+    return KSuccess;
+}
+
+void Epoll::remove_watch_locked(WatchKey key)
+{
+    VERIFY(m_lock.is_locked());
+    auto it = m_watches.find(key);
+    VERIFY(it != m_watches.end());
+    auto& watch = *it->value;
+
+    // Leave the file's blocker set first, so that the watch can't be put on the ready list again.
+    watch.stop_watching();
+    {
+        SpinlockLocker lock(m_ready_lock);
+        if (watch.m_ready_list_node.is_in_list())
+            m_ready_watches.remove(watch);
+    }
+    m_watches.remove(it);
+}
+
+KResultOr<size_t> Epoll::collect_ready_events(Span<epoll_event> events)
+{
+    MutexLocker locker(m_lock);
+
+    // Checking whether a description is ready can't be done with a spinlock held, so take the whole ready list.
+    // Holding m_lock keeps the watches around until we're done. The descriptions we look at are kept alive
+    // until then as well, since a description that goes away removes its watches.
+    Vector<Watch*, 32> candidates;
+    Vector<Watch*, 32> still_ready;
+    Vector<WatchKey, 32> closed_watches;
+    Vector<NonnullRefPtr<OpenFileDescription>, 32> descriptions;
+    {
+        SpinlockLocker lock(m_ready_lock);
+        auto ready_watch_count = m_ready_watches.size_slow();
+        if (!candidates.try_ensure_capacity(ready_watch_count) || !still_ready.try_ensure_capacity(ready_watch_count)
+            || !closed_watches.try_ensure_capacity(ready_watch_count) || !descriptions.try_ensure_capacity(ready_watch_count))
+            return ENOMEM;
+        while (!m_ready_watches.is_empty())
+            candidates.unchecked_append(m_ready_watches.take_first());
+    }
+
+    size_t event_count = 0;
+    for (auto* watch : candidates) {
+        if (event_count == events.size()) {
+            still_ready.unchecked_append(watch);
+            continue;
+        }
+
+        // The description normally removes its watches when it goes away, but it may be on the way out right now.
+        auto description = watch->m_description.strong_ref();
+        if (!description) {
+            closed_watches.unchecked_append({ watch->fd(), watch->description_ptr() });
+            continue;
+        }
+
+        // The file has changed since the watch was put on the ready list, but not necessarily in a way we care about.
+        auto ready_events = watch->ready_events(*description);
+        descriptions.unchecked_append(description.release_nonnull());
+        if (!ready_events)
+            continue;
+
+        events[event_count++] = { ready_events, watch->event().data };
+        if (watch->event().events & EPOLLONESHOT) {
+            SpinlockLocker lock(m_ready_lock);
+            watch->disable();
+        } else if (!(watch->event().events & EPOLLET)) {
+            still_ready.unchecked_append(watch);
+        }
+    }
+
+    {
+        SpinlockLocker lock(m_ready_lock);
+        for (auto* watch : still_ready) {
+            // The file may have put it back already.
+            if (!watch->m_ready_list_node.is_in_list())
+                m_ready_watches.append(*watch);
+        }
+    }
+
+    for (auto key : closed_watches)
+        remove_watch_locked(key);
+
+    return event_count;
+}
+
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/WeakPtr.h>
+#include <Kernel/API/POSIX/sys/epoll.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Locking/Mutex.h>
+#include <Kernel/Locking/Spinlock.h>
+
+namespace Kernel {
+
+// The interest set behind epoll_create(), epoll_ctl() and epoll_wait().
+//
+// Like on Linux, a watch is identified by the fd *and* the description it was added under, and goes away along
+// with the description. Every watch is a FileBlocker that stays in its file's blocker set for as long as the
+// description is watched, without blocking any thread. Whenever the file evaluates its block conditions, that
+// blocker moves the watch onto the ready list instead of unblocking anyone, so waiting only has to look at the
+// watches that may have become ready, and not at every watched description like select() and poll() do.
+class Epoll final : public File {
+public:
+    static KResultOr<NonnullRefPtr<Epoll>> try_create();
+    virtual ~Epoll() override;
+
+    virtual bool can_read(const OpenFileDescription&, size_t) const override;
+    // Events are only delivered through epoll_wait().
+    virtual KResultOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual bool can_write(const OpenFileDescription&, size_t) const override { return false; }
+    virtual KResultOr<size_t> write(OpenFileDescription&, u64, const UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual KResult close() override;
+
+    virtual String absolute_path(const OpenFileDescription&) const override { return "epoll"; }
+    virtual StringView class_name() const override { return "Epoll"; };
+    virtual bool is_epoll() const override { return true; }
+
+    KResult add_watch(int fd, OpenFileDescription&, epoll_event const&);
+    KResult modify_watch(int fd, OpenFileDescription&, epoll_event const&);
+    KResult remove_watch(int fd, OpenFileDescription&);
+
+    // Called by a description that goes away, so that we don't keep its file alive.
+    void did_close_description(OpenFileDescription const&);
+
+    // Fills `events` with the watches that are ready, and returns how many there were.
+    // Level-triggered watches stay on the ready list, so they are reported again until they stop being ready.
+    KResultOr<size_t> collect_ready_events(Span<epoll_event> events);
+
+private:
+    class Watch final : public Thread::FileBlocker {
+    public:
+        Watch(Epoll&, int fd, OpenFileDescription&, epoll_event const&);
+        virtual ~Watch() override;
+
+        bool start_watching() { return add_to_blocker_set(m_file->blocker_set()); }
+        void stop_watching();
+
+        int fd() const { return m_fd; }
+        // Only for identifying the watch, as the description may be gone.
+        OpenFileDescription const* description_ptr() const { return m_description_ptr; }
+
+        epoll_event const& event() const { return m_event; }
+        void set_event(epoll_event const& event) { m_event = event; }
+        void disable() { m_event.events = 0; }
+
+        // Returns the watched events that the description is ready for right now.
+        u32 ready_events(OpenFileDescription&) const;
+
+        virtual StringView state_string() const override { return "Watching"sv; }
+        virtual void will_unblock_immediately_without_blocking(UnblockImmediatelyReason) override { }
+        virtual bool unblock_if_conditions_are_met(bool, void*) override;
+
+    private:
+        friend class Epoll;
+
+        Epoll& m_epoll;
+        int m_fd { -1 };
+        // The watch must not keep the description open, but it has to keep the file alive, since it is in the
+        // file's blocker set.
+        WeakPtr<OpenFileDescription> m_description;
+        OpenFileDescription const* m_description_ptr { nullptr };
+        NonnullRefPtr<File> m_file;
+        epoll_event m_event {};
+        IntrusiveListNode<Watch> m_ready_list_node;
+    };
+
+    struct WatchKey {
+        int fd { -1 };
+        OpenFileDescription const* description { nullptr };
+
+        bool operator==(WatchKey const&) const = default;
+    };
+    struct WatchKeyTraits : public GenericTraits<WatchKey> {
+        static unsigned hash(WatchKey const& key) { return pair_int_hash(key.fd, ptr_hash(key.description)); }
+    };
+
+    Epoll() = default;
+
+    void did_change_readiness(Watch&);
+    void remove_watch_locked(WatchKey);
+
+    mutable Mutex m_lock;
+    HashMap<WatchKey, NonnullOwnPtr<Watch>, WatchKeyTraits> m_watches;
+
+    mutable Spinlock m_ready_lock;
+    IntrusiveList<&Watch::m_ready_list_node> m_ready_watches;
+};
+
+}
@@ -13,6 +13,7 @@
 #include <Kernel/Devices/BlockDevice.h>
 #include <Kernel/FileSystem/Ext2FileSystem.h>
 #include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/FileSystem/ReadaheadState.h>
 #include <Kernel/FileSystem/ext2_fs.h>
 #include <Kernel/Process.h>
 #include <Kernel/UnixTypes.h>
@@ -866,7 +867,14 @@ KResultOr<size_t> Ext2FSInode::read_bytes(off_t offset, size_t count, UserOrKern
 
     dbgln_if(EXT2_VERY_DEBUG, "Ext2FSInode[{}]::read_bytes(): Reading up to {} bytes, {} bytes into inode to {}", identifier(), count, offset, buffer.user_or_kernel_ptr());
 
+    const size_t blocks_per_prefetch = max<u64>(1, ReadaheadState::max_window / block_size);
+
     for (auto bi = first_block_logical_index; remaining_count && bi <= last_block_logical_index; bi = bi.value() + 1) {
+        if (allow_cache && (bi.value() - first_block_logical_index.value()) % blocks_per_prefetch == 0) {
+            // Get the next stretch of blocks into the cache with as few device requests as we can, instead of one per block.
+            auto last_block_to_prefetch = min(bi.value() + blocks_per_prefetch - 1, last_block_logical_index.value());
+            [[maybe_unused]] auto result = prefetch_blocks(bi.value(), last_block_to_prefetch);
+        }
         auto block_index = m_block_list[bi.value()];
         size_t offset_into_block = (bi == first_block_logical_index) ? offset_into_first_block : 0;
         size_t num_bytes_to_copy = min((size_t)block_size - offset_into_block, (size_t)remaining_count);
@@ -887,6 +895,47 @@ KResultOr<size_t> Ext2FSInode::read_bytes(off_t offset, size_t count, UserOrKern
     return nread;
 }
 
+KResult Ext2FSInode::prefetch(off_t offset, size_t count) const
+{
+    MutexLocker inode_locker(m_inode_lock);
+    VERIFY(offset >= 0);
+    if (count == 0 || static_cast<u64>(offset) >= size())
+        return KSuccess;
+    if (is_symlink() && size() < max_inline_symlink_length)
+        return KSuccess;
+
+    if (m_block_list.is_empty())
+        m_block_list = compute_block_list();
+    if (m_block_list.is_empty())
+        return KSuccess;
+
+    const u64 block_size = fs().block_size();
+    auto end = min(static_cast<u64>(offset) + count, size());
+    size_t first_block_logical_index = offset / block_size;
+    size_t last_block_logical_index = min<u64>((end - 1) / block_size, m_block_list.size() - 1);
+    return prefetch_blocks(first_block_logical_index, last_block_logical_index);
+}
+
+KResult Ext2FSInode::prefetch_blocks(size_t first_block_logical_index, size_t last_block_logical_index) const
+{
+    VERIFY(m_inode_lock.is_locked());
+
+    // Blocks that are next to each other on disk can be fetched with one request.
+    for (size_t bi = first_block_logical_index; bi <= last_block_logical_index;) {
+        auto block_index = m_block_list[bi];
+        if (block_index.value() == 0) {
+            ++bi;
+            continue;
+        }
+        size_t run_length = 1;
+        while (bi + run_length <= last_block_logical_index && m_block_list[bi + run_length].value() == block_index.value() + run_length)
+            ++run_length;
+        TRY(fs().prefetch_blocks(block_index, run_length));
+        bi += run_length;
+    }
+    return KSuccess;
+}
+
 KResult Ext2FSInode::resize(u64 new_size)
 {
     auto old_size = size();
@@ -39,6 +39,7 @@ public:
 private:
     // ^Inode
     virtual KResultOr<size_t> read_bytes(off_t, size_t, UserOrKernelBuffer& buffer, OpenFileDescription*) const override;
+    virtual KResult prefetch(off_t, size_t) const override;
     virtual InodeMetadata metadata() const override;
     virtual KResult traverse_as_directory(Function<bool(FileSystem::DirectoryEntryView const&)>) const override;
     virtual KResultOr<NonnullRefPtr<Inode>> lookup(StringView name) override;
@@ -59,6 +60,7 @@ private:
 
     KResult write_directory(Vector<Ext2FSDirectoryEntry>&);
     KResult populate_lookup_cache() const;
+    KResult prefetch_blocks(size_t first_block_logical_index, size_t last_block_logical_index) const;
     KResult resize(u64);
     KResult write_indirect_block(BlockBasedFileSystem::BlockIndex, Span<BlockBasedFileSystem::BlockIndex>);
     KResult grow_doubly_indirect_block(BlockBasedFileSystem::BlockIndex, size_t, Span<BlockBasedFileSystem::BlockIndex>, Vector<BlockBasedFileSystem::BlockIndex>&, unsigned&);
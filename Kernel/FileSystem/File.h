@@ -113,6 +113,7 @@ public:
     virtual bool is_character_device() const { return false; }
     virtual bool is_socket() const { return false; }
     virtual bool is_inode_watcher() const { return false; }
+    virtual bool is_epoll() const { return false; }
 
     virtual FileBlockerSet& blocker_set() { return m_blocker_set; }
 
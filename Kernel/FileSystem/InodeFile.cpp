@@ -32,6 +32,13 @@ KResultOr<size_t> InodeFile::read(OpenFileDescription& description, u64 offset,
         return EOVERFLOW;
 
     auto nread = TRY(m_inode->read_bytes(offset, count, buffer, &description));
+    if (!description.is_direct() && nread == count) {
+        // If this looks like a sequential scan, get the next part of the file into the cache before it is asked for.
+        // Failing to do so is fine, the next read will simply go to the disk itself.
+        if (auto readahead = description.readahead_state().did_access(offset, nread); readahead > 0) {
+            [[maybe_unused]] auto result = m_inode->prefetch(offset + nread, readahead);
+        }
+    }
     if (nread > 0) {
         Thread::current()->did_file_read(nread);
         evaluate_block_conditions();
@@ -9,6 +9,7 @@
 #include <Kernel/Debug.h>
 #include <Kernel/Devices/BlockDevice.h>
 #include <Kernel/FileSystem/Custody.h>
+#include <Kernel/FileSystem/Epoll.h>
 #include <Kernel/FileSystem/FIFO.h>
 #include <Kernel/FileSystem/FileSystem.h>
 #include <Kernel/FileSystem/InodeFile.h>
@@ -52,6 +53,17 @@ OpenFileDescription::OpenFileDescription(File& file)
 
 OpenFileDescription::~OpenFileDescription()
 {
+    // Closing a description takes it out of every epoll watching it, just like on Linux.
+    Vector<WeakPtr<Epoll>, 1> epolls;
+    {
+        SpinlockLocker locker(m_epolls_lock);
+        epolls = move(m_epolls);
+    }
+    for (auto& weak_epoll : epolls) {
+        if (auto epoll = weak_epoll.strong_ref())
+            epoll->did_close_description(*this);
+    }
+
     m_file->detach(*this);
     if (is_fifo())
         static_cast<FIFO*>(m_file.ptr())->detach(m_fifo_direction);
@@ -176,6 +188,15 @@ KResultOr<size_t> OpenFileDescription::read(UserOrKernelBuffer& buffer, size_t c
 KResultOr<size_t> OpenFileDescription::write(const UserOrKernelBuffer& data, size_t size)
 {
     MutexLocker locker(m_lock);
+    // Moving to the end has to happen under the same lock as the write, or another thread could append in between.
+    if (m_should_append && m_file->is_seekable()) {
+        if (!metadata().is_valid())
+            return EIO;
+        m_current_offset = metadata().size;
+        m_file->did_seek(*this, m_current_offset);
+        if (m_inode)
+            m_inode->did_seek(*this, m_current_offset);
+    }
     if (Checked<off_t>::addition_would_overflow(m_current_offset, size))
         return EOVERFLOW;
     auto nwritten = TRY(m_file->write(*this, offset(), data, size));
@@ -323,6 +344,25 @@ InodeWatcher* OpenFileDescription::inode_watcher()
     return static_cast<InodeWatcher*>(m_file.ptr());
 }
 
+bool OpenFileDescription::is_epoll() const
+{
+    return m_file->is_epoll();
+}
+
+const Epoll* OpenFileDescription::epoll() const
+{
+    if (!is_epoll())
+        return nullptr;
+    return static_cast<const Epoll*>(m_file.ptr());
+}
+
+Epoll* OpenFileDescription::epoll()
+{
+    if (!is_epoll())
+        return nullptr;
+    return static_cast<Epoll*>(m_file.ptr());
+}
+
 bool OpenFileDescription::is_master_pty() const
 {
     return m_file->is_master_pty();
@@ -342,6 +382,19 @@ MasterPTY* OpenFileDescription::master_pty()
     return static_cast<MasterPTY*>(m_file.ptr());
 }
 
+KResult OpenFileDescription::did_start_being_watched_by(Epoll& epoll)
+{
+    SpinlockLocker locker(m_epolls_lock);
+    m_epolls.remove_all_matching([](auto& other) { return other.is_null(); });
+    for (auto& other : m_epolls) {
+        if (other.unsafe_ptr() == &epoll)
+            return KSuccess;
+    }
+    if (!m_epolls.try_append(epoll.make_weak_ptr<Epoll>()))
+        return ENOMEM;
+    return KSuccess;
+}
+
 KResult OpenFileDescription::close()
 {
     if (m_file->attach_count() > 0)
@@ -9,9 +9,13 @@
 #include <AK/Badge.h>
 #include <AK/ByteBuffer.h>
 #include <AK/RefCounted.h>
+#include <AK/Vector.h>
+#include <AK/WeakPtr.h>
+#include <AK/Weakable.h>
 #include <Kernel/FileSystem/FIFO.h>
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/FileSystem/InodeMetadata.h>
+#include <Kernel/FileSystem/ReadaheadState.h>
 #include <Kernel/FileSystem/VirtualFileSystem.h>
 #include <Kernel/KBuffer.h>
 #include <Kernel/VirtualAddress.h>
@@ -23,7 +27,9 @@ public:
     virtual ~OpenFileDescriptionData() = default;
 };
 
-class OpenFileDescription : public RefCounted<OpenFileDescription> {
+class OpenFileDescription
+    : public RefCounted<OpenFileDescription>
+    , public Weakable<OpenFileDescription> {
     MAKE_SLAB_ALLOCATED(OpenFileDescription)
 public:
     static KResultOr<NonnullRefPtr<OpenFileDescription>> try_create(Custody&);
@@ -86,6 +92,10 @@ public:
     const InodeWatcher* inode_watcher() const;
     InodeWatcher* inode_watcher();
 
+    bool is_epoll() const;
+    const Epoll* epoll() const;
+    Epoll* epoll();
+
     bool is_master_pty() const;
     const MasterPTY* master_pty() const;
     MasterPTY* master_pty();
@@ -130,6 +140,11 @@ public:
 
     FileBlockerSet& blocker_set();
 
+    ReadaheadState& readahead_state() { return m_readahead_state; }
+
+    // Remembers the epoll, so that we can take ourselves out of its interest set when we go away.
+    KResult did_start_being_watched_by(Epoll&);
+
     KResult apply_flock(Process const&, Userspace<flock const*>);
     KResult get_flock(Userspace<flock*>) const;
 
@@ -150,6 +165,11 @@ private:
 
     off_t m_current_offset { 0 };
 
+    ReadaheadState m_readahead_state;
+
+    Spinlock m_epolls_lock;
+    Vector<WeakPtr<Epoll>, 1> m_epolls;
+
     OwnPtr<OpenFileDescriptionData> m_data;
 
     u32 m_file_flags { 0 };
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+#include <Kernel/Locking/Spinlock.h>
+
+namespace Kernel {
+
+// Watches the accesses made through one file description (or one mapping of a file) and decides how far
+// past each access it is worth reading ahead.
+//
+// As long as every access starts where the previous one ended, the window doubles up to max_window. Any
+// other access looks random, so the window collapses and we stop reading ahead until the pattern comes back.
+class ReadaheadState {
+public:
+    static constexpr size_t initial_window = 16 * KiB;
+    static constexpr size_t max_window = 128 * KiB;
+
+    // Records an access of `size` bytes at `offset`, and returns how many bytes past its end to read ahead.
+    size_t did_access(u64 offset, size_t size)
+    {
+        SpinlockLocker locker(m_lock);
+        if (offset == m_next_offset || m_is_sequential)
+            m_window = m_is_sequential ? max_window : clamp(m_window * 2, initial_window, max_window);
+        else
+            m_window = 0;
+        m_next_offset = offset + size;
+        return m_window;
+    }
+
+    // Records that the caller went on to read `size` more bytes past the last access, so that the next access
+    // picking up after those still counts as sequential.
+    void did_read_ahead(size_t size)
+    {
+        SpinlockLocker locker(m_lock);
+        m_next_offset += size;
+    }
+
+    // Set through madvise(MADV_SEQUENTIAL), for callers that know their pattern up front.
+    void set_sequential(bool sequential)
+    {
+        SpinlockLocker locker(m_lock);
+        m_is_sequential = sequential;
+    }
+
+private:
+    Spinlock m_lock;
+    u64 m_next_offset { 0 };
+    size_t m_window { 0 };
+    bool m_is_sequential { false };
+};
+
+}
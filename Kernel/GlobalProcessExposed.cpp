@@ -549,6 +549,31 @@ private:
         return KSuccess;
     }
 };
+class ProcFSRunQueues final : public ProcFSGlobalInformation {
+public:
+    static NonnullRefPtr<ProcFSRunQueues> must_create();
+
+private:
+    ProcFSRunQueues();
+    virtual KResult try_generate(KBufferBuilder& builder) override
+    {
+        JsonArraySerializer array { builder };
+        Processor::for_each(
+            [&](Processor& proc) {
+                // Processors beyond what an affinity mask can describe never get any threads queued.
+                auto statistics = Scheduler::get_processor_queue_statistics(proc.id());
+                if (!statistics.has_value())
+                    return;
+                auto obj = array.add_object();
+                obj.add("processor", proc.id());
+                obj.add("ready_threads", statistics->ready_threads);
+                obj.add("stolen_threads", statistics->stolen_threads);
+                obj.add("migrated_threads", statistics->migrated_threads);
+            });
+        array.finish();
+        return KSuccess;
+    }
+};
 class ProcFSDmesg final : public ProcFSGlobalInformation {
 public:
     static NonnullRefPtr<ProcFSDmesg> must_create();
@@ -738,6 +763,10 @@ UNMAP_AFTER_INIT NonnullRefPtr<ProcFSCPUInformation> ProcFSCPUInformation::must_
 {
     return adopt_ref_if_nonnull(new (nothrow) ProcFSCPUInformation).release_nonnull();
 }
+UNMAP_AFTER_INIT NonnullRefPtr<ProcFSRunQueues> ProcFSRunQueues::must_create()
+{
+    return adopt_ref_if_nonnull(new (nothrow) ProcFSRunQueues).release_nonnull();
+}
 UNMAP_AFTER_INIT NonnullRefPtr<ProcFSDmesg> ProcFSDmesg::must_create()
 {
     return adopt_ref_if_nonnull(new (nothrow) ProcFSDmesg).release_nonnull();
@@ -796,6 +825,10 @@ UNMAP_AFTER_INIT ProcFSCPUInformation::ProcFSCPUInformation()
     : ProcFSGlobalInformation("cpuinfo"sv)
 {
 }
+UNMAP_AFTER_INIT ProcFSRunQueues::ProcFSRunQueues()
+    : ProcFSGlobalInformation("runqueues"sv)
+{
+}
 UNMAP_AFTER_INIT ProcFSDmesg::ProcFSDmesg()
     : ProcFSGlobalInformation("dmesg"sv)
 {
@@ -856,6 +889,7 @@ UNMAP_AFTER_INIT NonnullRefPtr<ProcFSRootDirectory> ProcFSRootDirectory::must_cr
     directory->m_components.append(ProcFSMemoryStatus::must_create());
     directory->m_components.append(ProcFSOverallProcesses::must_create());
     directory->m_components.append(ProcFSCPUInformation::must_create());
+    directory->m_components.append(ProcFSRunQueues::must_create());
     directory->m_components.append(ProcFSDmesg::must_create());
     directory->m_components.append(ProcFSInterrupts::must_create());
     directory->m_components.append(ProcFSKeymap::must_create());
@@ -203,6 +203,7 @@ void AddressSpace::deallocate_region(Region& region)
 
 NonnullOwnPtr<Region> AddressSpace::take_region(Region& region)
 {
+    VERIFY(m_mmap_lock.is_locked_by_current_thread());
     SpinlockLocker lock(m_lock);
 
     if (m_region_lookup_cache.region.unsafe_ptr() == &region)
@@ -266,6 +267,7 @@ Vector<Region*> AddressSpace::find_regions_intersecting(VirtualRange const& rang
 
 KResultOr<Region*> AddressSpace::add_region(NonnullOwnPtr<Region> region)
 {
+    VERIFY(m_mmap_lock.is_locked_by_current_thread());
     auto* ptr = region.ptr();
     SpinlockLocker lock(m_lock);
     if (!m_regions.try_insert(region->vaddr().get(), move(region)))
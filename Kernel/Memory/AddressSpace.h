@@ -10,6 +10,7 @@
 #include <AK/RedBlackTree.h>
 #include <AK/Vector.h>
 #include <AK/WeakPtr.h>
+#include <Kernel/Locking/Mutex.h>
 #include <Kernel/Memory/AllocationStrategy.h>
 #include <Kernel/Memory/PageDirectory.h>
 #include <Kernel/UnixTypes.h>
@@ -57,6 +58,11 @@ public:
 
     RecursiveSpinlock& get_lock() const { return m_lock; }
 
+    // Serializes the memory syscalls, so that a region can't be unmapped or split while another thread is still
+    // setting it up. m_lock only protects the region tree itself, and can't be held across allocations.
+    // Everything that adds or removes regions has to hold it, even in address spaces nobody else can see yet.
+    Mutex& mmap_lock() { return m_mmap_lock; }
+
     size_t amount_clean_inode() const;
     size_t amount_dirty_private() const;
     size_t amount_virtual() const;
@@ -69,6 +75,7 @@ private:
     explicit AddressSpace(NonnullRefPtr<PageDirectory>);
 
     mutable RecursiveSpinlock m_lock;
+    Mutex m_mmap_lock { "AddressSpace" };
 
     RefPtr<PageDirectory> m_page_directory;
 
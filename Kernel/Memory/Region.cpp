@@ -416,6 +416,49 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
     if (current_thread)
         current_thread->did_inode_fault();
 
+    // When the faults walk through the mapping in order, read ahead of them and map the following pages right away,
+    // so the file system can fetch them with one request and we don't take a fault on every single page.
+    auto& inode = inode_vmobject.inode();
+    size_t readahead_page_count = m_readahead_state.did_access(page_index_in_vmobject * PAGE_SIZE, PAGE_SIZE) / PAGE_SIZE;
+    readahead_page_count = min(readahead_page_count, page_count() - page_index_in_region - 1);
+    size_t page_count_in_file = ceil_div(inode.size(), static_cast<size_t>(PAGE_SIZE));
+    if (page_index_in_vmobject + readahead_page_count >= page_count_in_file)
+        readahead_page_count = page_count_in_file > page_index_in_vmobject ? page_count_in_file - page_index_in_vmobject - 1 : 0;
+    if (readahead_page_count > 0) {
+        // Failing here is fine, reading the pages below will simply go to the disk itself.
+        [[maybe_unused]] auto result = inode.prefetch(page_index_in_vmobject * PAGE_SIZE, (readahead_page_count + 1) * PAGE_SIZE);
+    }
+
+    if (auto response = read_inode_page_into_vmobject(page_index_in_vmobject); response != PageFaultResponse::Continue)
+        return response;
+    if (!remap_vmobject_page(page_index_in_vmobject))
+        return PageFaultResponse::OutOfMemory;
+
+    size_t mapped_readahead_page_count = 0;
+    for (size_t i = 1; i <= readahead_page_count; ++i) {
+        if (read_inode_page_into_vmobject(page_index_in_vmobject + i) != PageFaultResponse::Continue)
+            break;
+        if (!remap_vmobject_page(page_index_in_vmobject + i))
+            break;
+        ++mapped_readahead_page_count;
+    }
+    // The next fault of a sequential scan comes right after the pages we just mapped, not after the faulting one.
+    m_readahead_state.did_read_ahead(mapped_readahead_page_count * PAGE_SIZE);
+
+    return PageFaultResponse::Continue;
+}
+
+PageFaultResponse Region::read_inode_page_into_vmobject(size_t page_index_in_vmobject)
+{
+    auto& inode_vmobject = static_cast<InodeVMObject&>(vmobject());
+    auto& vmobject_physical_page_entry = inode_vmobject.physical_pages()[page_index_in_vmobject];
+
+    {
+        SpinlockLocker locker(inode_vmobject.m_lock);
+        if (!vmobject_physical_page_entry.is_null())
+            return PageFaultResponse::Continue;
+    }
+
     u8 page_buffer[PAGE_SIZE];
     auto& inode = inode_vmobject.inode();
 
@@ -437,10 +480,8 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
 
     if (!vmobject_physical_page_entry.is_null()) {
         // Someone else faulted in this page while we were reading from the inode.
-        // No harm done (other than some duplicate work), remap the page here and return.
-        dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else, remapping.");
-        if (!remap_vmobject_page(page_index_in_vmobject))
-            return PageFaultResponse::OutOfMemory;
+        // No harm done (other than some duplicate work), the caller will just map their page.
+        dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else.");
         return PageFaultResponse::Continue;
     }
 
@@ -458,9 +499,6 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
         MM.unquickmap_page();
     }
 
-    if (!remap_vmobject_page(page_index_in_vmobject))
-        return PageFaultResponse::OutOfMemory;
-
     return PageFaultResponse::Continue;
 }
 
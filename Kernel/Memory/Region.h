@@ -10,6 +10,7 @@
 #include <AK/IntrusiveList.h>
 #include <AK/Weakable.h>
 #include <Kernel/Arch/x86/PageFault.h>
+#include <Kernel/FileSystem/ReadaheadState.h>
 #include <Kernel/Forward.h>
 #include <Kernel/Heap/SlabAllocator.h>
 #include <Kernel/KString.h>
@@ -182,6 +183,8 @@ public:
     [[nodiscard]] bool is_syscall_region() const { return m_syscall_region; }
     void set_syscall_region(bool b) { m_syscall_region = b; }
 
+    ReadaheadState& readahead_state() { return m_readahead_state; }
+
 private:
     Region(VirtualRange const&, NonnullRefPtr<VMObject>, size_t offset_in_vmobject, OwnPtr<KString>, Region::Access access, Cacheable, bool shared);
 
@@ -198,6 +201,7 @@ private:
 
     [[nodiscard]] PageFaultResponse handle_cow_fault(size_t page_index);
     [[nodiscard]] PageFaultResponse handle_inode_fault(size_t page_index);
+    [[nodiscard]] PageFaultResponse read_inode_page_into_vmobject(size_t page_index_in_vmobject);
     [[nodiscard]] PageFaultResponse handle_zero_fault(size_t page_index);
 
     [[nodiscard]] bool map_individual_page_impl(size_t page_index);
@@ -213,6 +217,7 @@ private:
     bool m_stack : 1 { false };
     bool m_mmap : 1 { false };
     bool m_syscall_region : 1 { false };
+    ReadaheadState m_readahead_state;
     IntrusiveListNode<Region> m_memory_manager_list_node;
     IntrusiveListNode<Region> m_vmobject_list_node;
 
@@ -254,7 +254,7 @@ KResultOr<size_t> IPv4Socket::receive_byte_buffered(OpenFileDescription& descrip
     if (m_receive_buffer->is_empty()) {
         if (protocol_is_disconnected())
             return 0;
-        if (!description.is_blocking())
+        if (!description.is_blocking() || (flags & MSG_DONTWAIT))
             return set_so_error(EAGAIN);
 
         locker.unlock();
@@ -295,7 +295,7 @@ KResultOr<size_t> IPv4Socket::receive_packet_buffered(OpenFileDescription& descr
             //        But if so, we still need to deliver at least one EOF read to userspace.. right?
             if (protocol_is_disconnected())
                 return 0;
-            if (!description.is_blocking())
+            if (!description.is_blocking() || (flags & MSG_DONTWAIT))
                 return set_so_error(EAGAIN);
         }
 
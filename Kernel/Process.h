@@ -297,6 +297,12 @@ public:
     KResultOr<FlatPtr> sys$readv(int fd, Userspace<const struct iovec*> iov, int iov_count);
     KResultOr<FlatPtr> sys$write(int fd, Userspace<const u8*>, size_t);
     KResultOr<FlatPtr> sys$writev(int fd, Userspace<const struct iovec*> iov, int iov_count);
+    KResultOr<FlatPtr> sys$pread(Userspace<const Syscall::SC_pread_params*>);
+    KResultOr<FlatPtr> sys$preadv(Userspace<const Syscall::SC_preadv_params*>);
+    KResultOr<FlatPtr> sys$pwrite(Userspace<const Syscall::SC_pwrite_params*>);
+    KResultOr<FlatPtr> sys$pwritev(Userspace<const Syscall::SC_pwritev_params*>);
+    KResultOr<FlatPtr> sys$sendfile(Userspace<const Syscall::SC_sendfile_params*>);
+    KResultOr<FlatPtr> sys$copy_file_range(Userspace<const Syscall::SC_copy_file_range_params*>);
     KResultOr<FlatPtr> sys$fstat(int fd, Userspace<stat*>);
     KResultOr<FlatPtr> sys$stat(Userspace<const Syscall::SC_stat_params*>);
     KResultOr<FlatPtr> sys$lseek(int fd, Userspace<off_t*>, int whence);
@@ -315,6 +321,9 @@ public:
     KResultOr<FlatPtr> sys$purge(int mode);
     KResultOr<FlatPtr> sys$select(Userspace<const Syscall::SC_select_params*>);
     KResultOr<FlatPtr> sys$poll(Userspace<const Syscall::SC_poll_params*>);
+    KResultOr<FlatPtr> sys$epoll_create(int flags);
+    KResultOr<FlatPtr> sys$epoll_ctl(Userspace<const Syscall::SC_epoll_ctl_params*>);
+    KResultOr<FlatPtr> sys$epoll_wait(Userspace<const Syscall::SC_epoll_wait_params*>);
     KResultOr<FlatPtr> sys$get_dir_entries(int fd, Userspace<void*>, size_t);
     KResultOr<FlatPtr> sys$getcwd(Userspace<char*>, size_t);
     KResultOr<FlatPtr> sys$chdir(Userspace<const char*>, size_t);
@@ -533,6 +542,7 @@ private:
 
     KResult do_exec(NonnullRefPtr<OpenFileDescription> main_program_description, NonnullOwnPtrVector<KString> arguments, NonnullOwnPtrVector<KString> environment, RefPtr<OpenFileDescription> interpreter_description, Thread*& new_main_thread, u32& prev_flags, const ElfW(Ehdr) & main_program_header);
     KResultOr<FlatPtr> do_write(OpenFileDescription&, const UserOrKernelBuffer&, size_t);
+    KResultOr<FlatPtr> do_copy_file_range(OpenFileDescription& source, u64 source_offset, OpenFileDescription& destination, Optional<u64> destination_offset, size_t length);
 
     KResultOr<FlatPtr> do_statvfs(StringView path, statvfs* buf);
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/NumericLimits.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Singleton.h>
 #include <AK/Time.h>
@@ -17,8 +18,9 @@
 #include <Kernel/Sections.h>
 #include <Kernel/Time/TimeManagement.h>
 
-// Remove this once SMP is stable and can be enabled by default
-#define SCHEDULE_ON_ALL_PROCESSORS 0
+// SMP itself is still opt-in (smp=on), but once it is enabled, every processor schedules threads from its own ready queues.
+// Setting this to 0 confines all threads to the bootstrap processor again.
+#define SCHEDULE_ON_ALL_PROCESSORS 1
 
 namespace Kernel {
 
@@ -45,9 +47,89 @@ struct ThreadReadyQueues {
     u32 mask {};
     static constexpr size_t count = sizeof(mask) * 8;
     Array<ThreadReadyQueue, count> queues;
+
+    Thread* find_runnable_thread(u32 affinity_mask)
+    {
+        auto priority_mask = mask;
+        while (priority_mask != 0) {
+            auto priority = __builtin_ffsl(priority_mask);
+            VERIFY(priority > 0);
+            auto& ready_queue = queues[--priority];
+            for (auto& thread : ready_queue.thread_list) {
+                VERIFY(thread.m_runnable_priority == (int)priority);
+                if (thread.is_active())
+                    continue;
+                if (!(thread.affinity() & affinity_mask))
+                    continue;
+                return &thread;
+            }
+            priority_mask &= ~(1u << priority);
+        }
+        return nullptr;
+    }
+
+    void append(Thread& thread, u32 priority)
+    {
+        VERIFY(thread.m_runnable_priority < 0);
+        thread.m_runnable_priority = (int)priority;
+        VERIFY(!thread.m_ready_queue_node.is_in_list());
+        auto& ready_queue = queues[priority];
+        bool was_empty = ready_queue.thread_list.is_empty();
+        ready_queue.thread_list.append(thread);
+        if (was_empty)
+            mask |= (1u << priority);
+    }
+
+    void remove(Thread& thread)
+    {
+        auto priority = thread.m_runnable_priority;
+        VERIFY(mask & (1u << priority));
+        auto& ready_queue = queues[priority];
+        thread.m_runnable_priority = -1;
+        ready_queue.thread_list.remove(thread);
+        if (ready_queue.thread_list.is_empty())
+            mask &= ~(1u << priority);
+    }
+
+    // Moves the next thread that may run on processor `destination_cpu` over to the ready queues of that processor.
+    Thread* move_runnable_thread_to(ThreadReadyQueues& destination, u32 destination_cpu)
+    {
+        auto* thread = find_runnable_thread(1u << destination_cpu);
+        if (!thread)
+            return nullptr;
+        auto priority = (u32)thread->m_runnable_priority;
+        remove(*thread);
+        destination.append(*thread, priority);
+        AK::atomic_store(&thread->m_runnable_processor, destination_cpu, AK::MemoryOrder::memory_order_relaxed);
+        return thread;
+    }
 };
 
-static Singleton<SpinlockProtected<ThreadReadyQueues>> g_ready_queues;
+// Every processor has its own ready queues, so that processors picking their next thread don't contend with each other.
+struct ProcessorReadyQueues {
+    SpinlockProtected<ThreadReadyQueues> ready_queues;
+    // Kept outside of the lock, so that other processors can cheaply look for the busiest processor to steal from.
+    Atomic<u32> thread_count { 0 };
+    Atomic<u32> stolen_thread_count { 0 };
+    Atomic<u32> migrated_thread_count { 0 };
+    // Only ever touched by the processor itself, from its timer interrupt.
+    u32 ticks_until_balance { 0 };
+};
+
+// Affinity masks have one bit per processor, so this is also the most processors that can schedule threads.
+static constexpr size_t max_scheduling_processor_count = sizeof(u32) * 8;
+
+static Singleton<Array<ProcessorReadyQueues, max_scheduling_processor_count>> g_ready_queues;
+
+// How often (in timer ticks) a busy processor checks whether it should take over threads queued on a busier one.
+static constexpr u32 ticks_between_load_balancing = 25;
+// How many more threads another processor may have queued before we pull one over.
+static constexpr u32 max_imbalance = 1;
+
+static bool can_schedule_on(u32 cpu)
+{
+    return cpu < max_scheduling_processor_count;
+}
 
 static SpinlockProtected<TotalTimeScheduled> g_total_time_scheduled;
 
@@ -60,7 +142,7 @@ static void dump_thread_list(bool = false);
 static inline u32 thread_priority_to_priority_index(u32 thread_priority)
 {
     // Converts the priority in the range of THREAD_PRIORITY_MIN...THREAD_PRIORITY_MAX
-    // to a index into g_ready_queues where 0 is the highest priority bucket
+    // to a index into a processor's ready queues where 0 is the highest priority bucket
     VERIFY(thread_priority >= THREAD_PRIORITY_MIN && thread_priority <= THREAD_PRIORITY_MAX);
     constexpr u32 thread_priority_count = THREAD_PRIORITY_MAX - THREAD_PRIORITY_MIN + 1;
     static_assert(thread_priority_count > 0);
@@ -69,70 +151,98 @@ static inline u32 thread_priority_to_priority_index(u32 thread_priority)
     return priority_bucket;
 }
 
-Thread& Scheduler::pull_next_runnable_thread()
+static u32 scheduling_processor_mask()
+{
+#if SCHEDULE_ON_ALL_PROCESSORS
+    auto processor_count = min<u32>(Processor::count(), max_scheduling_processor_count);
+    return processor_count == max_scheduling_processor_count ? NumericLimits<u32>::max() : (1u << processor_count) - 1;
+#else
+    return 1u;
+#endif
+}
+
+// Takes the next thread that may run on the current processor from the ready queues of processor `cpu`.
+static Thread* take_runnable_thread(u32 cpu)
 {
     auto affinity_mask = 1u << Processor::current_id();
+    auto& processor_ready_queues = (*g_ready_queues)[cpu];
+
+    return processor_ready_queues.ready_queues.with([&](auto& ready_queues) -> Thread* {
+        auto* thread = ready_queues.find_runnable_thread(affinity_mask);
+        if (!thread)
+            return nullptr;
+        ready_queues.remove(*thread);
+        processor_ready_queues.thread_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+        // Mark it as active because we are using this thread. This is similar
+        // to comparing it with Processor::current_thread, but when there are
+        // multiple processors there's no easy way to check whether the thread
+        // is actually still needed. This prevents accidental finalization when
+        // a thread is no longer in Running state, but running on another core.
+
+        // We need to mark it active here so that this thread won't be
+        // scheduled on another core if it were to be queued before actually
+        // switching to it.
+        // FIXME: Figure out a better way maybe?
+        thread->set_active(true);
+        return thread;
+    });
+}
 
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread& {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = __builtin_ffsl(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                thread.m_runnable_priority = -1;
-                ready_queue.thread_list.remove(thread);
-                if (ready_queue.thread_list.is_empty())
-                    ready_queues.mask &= ~(1u << priority);
-                // Mark it as active because we are using this thread. This is similar
-                // to comparing it with Processor::current_thread, but when there are
-                // multiple processors there's no easy way to check whether the thread
-                // is actually still needed. This prevents accidental finalization when
-                // a thread is no longer in Running state, but running on another core.
-
-                // We need to mark it active here so that this thread won't be
-                // scheduled on another core if it were to be queued before actually
-                // switching to it.
-                // FIXME: Figure out a better way maybe?
-                thread.set_active(true);
-                return thread;
+// Takes a thread from the busiest processor that has one that may run on the current processor.
+static Thread* steal_runnable_thread()
+{
+    auto current_id = Processor::current_id();
+    auto candidate_mask = scheduling_processor_mask() & ~(1u << current_id);
+
+    while (candidate_mask != 0) {
+        u32 busiest_cpu = 0;
+        u32 busiest_thread_count = 0;
+        for (auto mask = candidate_mask; mask != 0; mask &= mask - 1) {
+            u32 cpu = __builtin_ctz(mask);
+            auto thread_count = (*g_ready_queues)[cpu].thread_count.load(AK::MemoryOrder::memory_order_relaxed);
+            if (thread_count > busiest_thread_count) {
+                busiest_cpu = cpu;
+                busiest_thread_count = thread_count;
             }
-            priority_mask &= ~(1u << priority);
         }
+        if (busiest_thread_count == 0)
+            return nullptr;
+
+        if (auto* thread = take_runnable_thread(busiest_cpu)) {
+            (*g_ready_queues)[current_id].stolen_thread_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            dbgln_if(SCHEDULER_DEBUG, "Scheduler[{}]: Stole {} from processor {}", current_id, *thread, busiest_cpu);
+            return thread;
+        }
+        // Everything queued there is either running or may not run here.
+        candidate_mask &= ~(1u << busiest_cpu);
+    }
+    return nullptr;
+}
+
+Thread& Scheduler::pull_next_runnable_thread()
+{
+    if (!can_schedule_on(Processor::current_id()))
         return *Processor::idle_thread();
-    });
+    if (auto* thread = take_runnable_thread(Processor::current_id()))
+        return *thread;
+    // Rather than going idle while other processors have threads waiting, take one of theirs.
+    if (auto* thread = steal_runnable_thread())
+        return *thread;
+    return *Processor::idle_thread();
 }
 
 Thread* Scheduler::peek_next_runnable_thread()
 {
-    auto affinity_mask = 1u << Processor::current_id();
-
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread* {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = __builtin_ffsl(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                return &thread;
-            }
-            priority_mask &= ~(1u << priority);
-        }
-
-        // Unlike in pull_next_runnable_thread() we don't want to fall back to
-        // the idle thread. We just want to see if we have any other thread ready
-        // to be scheduled.
+    auto current_id = Processor::current_id();
+    if (!can_schedule_on(current_id))
         return nullptr;
+    auto affinity_mask = 1u << current_id;
+
+    // Unlike in pull_next_runnable_thread() we don't want to fall back to
+    // the idle thread, or to threads waiting on other processors. We just
+    // want to see if we have any other thread ready to be scheduled.
+    return (*g_ready_queues)[current_id].ready_queues.with([&](auto& ready_queues) {
+        return ready_queues.find_runnable_thread(affinity_mask);
     });
 }
 
@@ -141,45 +251,143 @@ bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
     if (thread.is_idle_thread())
         return true;
 
-    return g_ready_queues->with([&](auto& ready_queues) {
-        auto priority = thread.m_runnable_priority;
-        if (priority < 0) {
-            VERIFY(!thread.m_ready_queue_node.is_in_list());
-            return false;
-        }
+    if (thread.m_runnable_priority < 0) {
+        VERIFY(!thread.m_ready_queue_node.is_in_list());
+        return false;
+    }
 
-        if (check_affinity && !(thread.affinity() & (1 << Processor::current_id())))
-            return false;
+    // Load balancing may move the thread to another processor's ready queues until we hold the lock of the ones it is on.
+    for (;;) {
+        u32 cpu = AK::atomic_load(&thread.m_runnable_processor, AK::MemoryOrder::memory_order_relaxed);
+        auto& processor_ready_queues = (*g_ready_queues)[cpu];
+        Optional<bool> did_dequeue = processor_ready_queues.ready_queues.with([&](auto& ready_queues) -> Optional<bool> {
+            if (thread.m_runnable_priority < 0) {
+                VERIFY(!thread.m_ready_queue_node.is_in_list());
+                return false;
+            }
+            if (thread.m_runnable_processor != cpu)
+                return {};
 
-        VERIFY(ready_queues.mask & (1u << priority));
-        auto& ready_queue = ready_queues.queues[priority];
-        thread.m_runnable_priority = -1;
-        ready_queue.thread_list.remove(thread);
-        if (ready_queue.thread_list.is_empty())
-            ready_queues.mask &= ~(1u << priority);
-        return true;
-    });
+            if (check_affinity && !(thread.affinity() & (1 << Processor::current_id())))
+                return false;
+
+            ready_queues.remove(thread);
+            processor_ready_queues.thread_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+            return true;
+        });
+        if (did_dequeue.has_value())
+            return did_dequeue.value();
+    }
+}
+
+// Prefers the processor that the thread last ran on, as long as that isn't much busier than the least busy one.
+static u32 pick_processor_for(Thread const& thread)
+{
+    auto candidate_mask = thread.affinity() & scheduling_processor_mask();
+    if (candidate_mask == 0) {
+        // The thread may only run on processors that don't schedule threads yet. Queue it on one of those anyway,
+        // just like it would have waited in a shared queue.
+        VERIFY(thread.affinity() != 0);
+        return __builtin_ctz(thread.affinity());
+    }
+
+    auto thread_count_of = [](u32 cpu) {
+        return (*g_ready_queues)[cpu].thread_count.load(AK::MemoryOrder::memory_order_relaxed);
+    };
+
+    u32 least_busy_cpu = __builtin_ctz(candidate_mask);
+    for (auto mask = candidate_mask; mask != 0; mask &= mask - 1) {
+        u32 cpu = __builtin_ctz(mask);
+        if (thread_count_of(cpu) < thread_count_of(least_busy_cpu))
+            least_busy_cpu = cpu;
+    }
+
+    auto last_cpu = thread.cpu();
+    if (can_schedule_on(last_cpu) && (candidate_mask & (1u << last_cpu)) && thread_count_of(last_cpu) <= thread_count_of(least_busy_cpu) + max_imbalance)
+        return last_cpu;
+    return least_busy_cpu;
 }
 
 void Scheduler::enqueue_runnable_thread(Thread& thread)
 {
-    VERIFY(g_scheduler_lock.is_locked_by_current_processor());
     if (thread.is_idle_thread())
         return;
     auto priority = thread_priority_to_priority_index(thread.priority());
+    auto cpu = pick_processor_for(thread);
+    auto& processor_ready_queues = (*g_ready_queues)[cpu];
 
-    g_ready_queues->with([&](auto& ready_queues) {
-        VERIFY(thread.m_runnable_priority < 0);
-        thread.m_runnable_priority = (int)priority;
-        VERIFY(!thread.m_ready_queue_node.is_in_list());
-        auto& ready_queue = ready_queues.queues[priority];
-        bool was_empty = ready_queue.thread_list.is_empty();
-        ready_queue.thread_list.append(thread);
-        if (was_empty)
-            ready_queues.mask |= (1u << priority);
+    processor_ready_queues.ready_queues.with([&](auto& ready_queues) {
+        ready_queues.append(thread, priority);
+        AK::atomic_store(&thread.m_runnable_processor, cpu, AK::MemoryOrder::memory_order_relaxed);
+        processor_ready_queues.thread_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
     });
 }
 
+// Locks the ready queues of both processors, always the lower numbered one first, so that two processors
+// balancing against each other can't deadlock.
+template<typename Callback>
+static void with_ready_queues_of(u32 source_cpu, u32 destination_cpu, Callback callback)
+{
+    VERIFY(source_cpu != destination_cpu);
+    auto& source = (*g_ready_queues)[source_cpu].ready_queues;
+    auto& destination = (*g_ready_queues)[destination_cpu].ready_queues;
+    if (source_cpu < destination_cpu) {
+        source.with([&](auto& source_queues) {
+            destination.with([&](auto& destination_queues) { callback(source_queues, destination_queues); });
+        });
+    } else {
+        destination.with([&](auto& destination_queues) {
+            source.with([&](auto& source_queues) { callback(source_queues, destination_queues); });
+        });
+    }
+}
+
+// Stealing only kicks in once a processor has run out of threads. This evens out the ready queues of processors
+// that are all busy, by moving a thread from the busiest one over to the current processor.
+static void balance_ready_queues()
+{
+    auto current_id = Processor::current_id();
+    auto candidate_mask = scheduling_processor_mask() & ~(1u << current_id);
+    auto thread_count_of = [](u32 cpu) {
+        return (*g_ready_queues)[cpu].thread_count.load(AK::MemoryOrder::memory_order_relaxed);
+    };
+
+    u32 busiest_cpu = current_id;
+    u32 busiest_thread_count = thread_count_of(current_id) + max_imbalance;
+    for (auto mask = candidate_mask; mask != 0; mask &= mask - 1) {
+        u32 cpu = __builtin_ctz(mask);
+        auto thread_count = thread_count_of(cpu);
+        if (thread_count > busiest_thread_count) {
+            busiest_cpu = cpu;
+            busiest_thread_count = thread_count;
+        }
+    }
+    if (busiest_cpu == current_id)
+        return;
+
+    with_ready_queues_of(busiest_cpu, current_id, [&](ThreadReadyQueues& source_queues, ThreadReadyQueues& destination_queues) {
+        auto* thread = source_queues.move_runnable_thread_to(destination_queues, current_id);
+        if (!thread)
+            return;
+        (*g_ready_queues)[busiest_cpu].thread_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+        (*g_ready_queues)[current_id].thread_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        (*g_ready_queues)[current_id].migrated_thread_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        dbgln_if(SCHEDULER_DEBUG, "Scheduler[{}]: Moved {} over from processor {}", current_id, *thread, busiest_cpu);
+    });
+}
+
+Optional<ProcessorQueueStatistics> Scheduler::get_processor_queue_statistics(u32 cpu)
+{
+    if (!can_schedule_on(cpu))
+        return {};
+    auto& processor_ready_queues = (*g_ready_queues)[cpu];
+    return ProcessorQueueStatistics {
+        .ready_threads = processor_ready_queues.thread_count.load(AK::MemoryOrder::memory_order_relaxed),
+        .stolen_threads = processor_ready_queues.stolen_thread_count.load(AK::MemoryOrder::memory_order_relaxed),
+        .migrated_threads = processor_ready_queues.migrated_thread_count.load(AK::MemoryOrder::memory_order_relaxed),
+    };
+}
+
 UNMAP_AFTER_INIT void Scheduler::start()
 {
     VERIFY_INTERRUPTS_DISABLED();
@@ -219,13 +427,22 @@ bool Scheduler::pick_next()
             Processor::set_current_in_scheduler(false);
         });
 
+    // Picking the next thread only takes the locks of the ready queues involved. The scheduler lock is only needed
+    // to switch to it, and by the time we have it, the thread may have stopped being runnable.
+    auto* next_thread = &pull_next_runnable_thread();
+
     SpinlockLocker lock(g_scheduler_lock);
 
+    while (!next_thread->is_idle_thread() && next_thread->state() != Thread::Runnable) {
+        next_thread->set_active(false);
+        next_thread = &pull_next_runnable_thread();
+    }
+    auto& thread_to_schedule = *next_thread;
+
     if constexpr (SCHEDULER_RUNNABLE_DEBUG) {
         dump_thread_list();
     }
 
-    auto& thread_to_schedule = pull_next_runnable_thread();
     if constexpr (SCHEDULER_DEBUG) {
         dbgln("Scheduler[{}]: Switch to {} @ {:#04x}:{:p}",
             Processor::current_id(),
@@ -483,6 +700,15 @@ void Scheduler::timer_tick(const RegisterState& regs)
         return;
     }
 
+    auto current_id = Processor::current_id();
+    if (can_schedule_on(current_id)) {
+        auto& ticks_until_balance = (*g_ready_queues)[current_id].ticks_until_balance;
+        if (ticks_until_balance-- == 0) {
+            ticks_until_balance = ticks_between_load_balancing;
+            balance_ready_queues();
+        }
+    }
+
     if (current_thread->tick())
         return;
 
@@ -9,6 +9,7 @@
 #include <AK/Assertions.h>
 #include <AK/Function.h>
 #include <AK/IntrusiveList.h>
+#include <AK/Optional.h>
 #include <AK/Types.h>
 #include <Kernel/Forward.h>
 #include <Kernel/Locking/Spinlock.h>
@@ -29,6 +30,12 @@ struct TotalTimeScheduled {
     u64 total_kernel { 0 };
 };
 
+struct ProcessorQueueStatistics {
+    u32 ready_threads { 0 };
+    u32 stolen_threads { 0 };
+    u32 migrated_threads { 0 };
+};
+
 class Scheduler {
 public:
     static void initialize();
@@ -54,6 +61,7 @@ public:
     static void dump_scheduler_state(bool = false);
     static bool is_initialized();
     static TotalTimeScheduled get_total_time_scheduled();
+    static Optional<ProcessorQueueStatistics> get_processor_queue_statistics(u32 cpu);
     static void add_time_scheduled(u64, bool);
     static u64 (*current_time)();
 };
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ScopeGuard.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/Epoll.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Process.h>
+#include <Kernel/Time/TimeManagement.h>
+
+namespace Kernel {
+
+// Enough for any reasonable caller, without letting userspace make us allocate arbitrary amounts of memory.
+static constexpr size_t max_events_per_wait = 1024;
+
+KResultOr<FlatPtr> Process::sys$epoll_create(int flags)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(stdio);
+
+    if (flags & ~EPOLL_CLOEXEC)
+        return EINVAL;
+
+    auto fd_allocation = TRY(m_fds.allocate());
+    auto epoll = TRY(Epoll::try_create());
+    auto description = TRY(OpenFileDescription::try_create(move(epoll)));
+
+    description->set_readable(true);
+
+    u32 fd_flags = 0;
+    if (flags & EPOLL_CLOEXEC)
+        fd_flags |= FD_CLOEXEC;
+
+    m_fds[fd_allocation.fd].set(move(description), fd_flags);
+    return fd_allocation.fd;
+}
+
+KResultOr<FlatPtr> Process::sys$epoll_ctl(Userspace<const Syscall::SC_epoll_ctl_params*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    auto epoll_description = TRY(fds().open_file_description(params.epfd));
+    if (!epoll_description->is_epoll())
+        return EINVAL;
+    auto& epoll = *epoll_description->epoll();
+
+    auto description = TRY(fds().open_file_description(params.fd));
+    if (description.ptr() == epoll_description.ptr())
+        return EINVAL;
+
+    epoll_event event {};
+    if (params.op == EPOLL_CTL_ADD || params.op == EPOLL_CTL_MOD)
+        TRY(copy_from_user(&event, params.event));
+
+    switch (params.op) {
+    case EPOLL_CTL_ADD:
+        return epoll.add_watch(params.fd, *description, event);
+    case EPOLL_CTL_MOD:
+        return epoll.modify_watch(params.fd, *description, event);
+    case EPOLL_CTL_DEL:
+        return epoll.remove_watch(params.fd, *description);
+    default:
+        return EINVAL;
+    }
+}
+
+KResultOr<FlatPtr> Process::sys$epoll_wait(Userspace<const Syscall::SC_epoll_wait_params*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.maxevents <= 0)
+        return EINVAL;
+
+    auto description = TRY(fds().open_file_description(params.epfd));
+    if (!description->is_epoll())
+        return EINVAL;
+    auto& epoll = *description->epoll();
+
+    // The deadline is fixed up front, so that waking up for nothing doesn't extend the wait.
+    Thread::BlockTimeout timeout;
+    if (params.timeout) {
+        auto timeout_time = TRY(copy_time_from_user(params.timeout));
+        auto deadline = TimeManagement::the().current_time(CLOCK_MONOTONIC_COARSE) + timeout_time;
+        timeout = Thread::BlockTimeout(true, &deadline, nullptr, CLOCK_MONOTONIC_COARSE);
+    }
+
+    sigset_t sigmask = {};
+    if (params.sigmask)
+        TRY(copy_from_user(&sigmask, params.sigmask));
+
+    Vector<epoll_event, 32> events;
+    if (!events.try_resize(min(static_cast<size_t>(params.maxevents), max_events_per_wait)))
+        return ENOMEM;
+
+    auto current_thread = Thread::current();
+
+    u32 previous_signal_mask = 0;
+    if (params.sigmask)
+        previous_signal_mask = current_thread->update_signal_mask(sigmask);
+    ScopeGuard rollback_signal_mask([&]() {
+        if (params.sigmask)
+            current_thread->update_signal_mask(previous_signal_mask);
+    });
+
+    for (;;) {
+        auto event_count = TRY(epoll.collect_ready_events(events.span()));
+        if (event_count > 0) {
+            TRY(copy_n_to_user(params.events, events.data(), event_count));
+            return event_count;
+        }
+
+        dbgln_if(POLL_SELECT_DEBUG, "epoll_wait: no events yet, blocking with timeout={}", params.timeout);
+
+        // The epoll description becomes readable once some watch might be ready, which may still turn out to be a
+        // false alarm, so keep collecting until there really is something or we run out of time.
+        auto unblock_flags = Thread::FileBlocker::BlockFlags::None;
+        auto block_result = current_thread->block<Thread::ReadBlocker>(timeout, *description, unblock_flags);
+        if (block_result.was_interrupted())
+            return EINTR;
+        if (block_result == Thread::BlockResult::InterruptedByTimeout)
+            return 0;
+    }
+}
+
+}
@@ -254,6 +254,7 @@ enum class ShouldAllowSyscalls {
 static KResultOr<LoadResult> load_elf_object(NonnullOwnPtr<Memory::AddressSpace> new_space, OpenFileDescription& object_description,
     FlatPtr load_offset, ShouldAllocateTls should_allocate_tls, ShouldAllowSyscalls should_allow_syscalls)
 {
+    MutexLocker mmap_locker(new_space->mmap_lock());
     auto& inode = *(object_description.inode());
     auto vmobject = TRY(Memory::SharedInodeVMObject::try_create_with_inode(inode));
 
@@ -463,8 +464,12 @@ KResult Process::do_exec(NonnullRefPtr<OpenFileDescription> main_program_descrip
     bool has_interpreter = interpreter_description;
     interpreter_description = nullptr;
 
-    auto signal_trampoline_range = TRY(load_result.space->try_allocate_range({}, PAGE_SIZE));
-    auto signal_trampoline_region = TRY(load_result.space->allocate_region_with_vmobject(signal_trampoline_range, g_signal_trampoline_region->vmobject(), 0, "Signal trampoline", PROT_READ | PROT_EXEC, true));
+    Memory::Region* signal_trampoline_region = nullptr;
+    {
+        MutexLocker mmap_locker(load_result.space->mmap_lock());
+        auto signal_trampoline_range = TRY(load_result.space->try_allocate_range({}, PAGE_SIZE));
+        signal_trampoline_region = TRY(load_result.space->allocate_region_with_vmobject(signal_trampoline_range, g_signal_trampoline_region->vmobject(), 0, "Signal trampoline", PROT_READ | PROT_EXEC, true));
+    }
     signal_trampoline_region->set_syscall_region(true);
 
     // (For dynamically linked executable) Allocate an FD for passing the main executable to the dynamic loader.
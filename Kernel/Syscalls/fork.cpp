@@ -91,6 +91,8 @@ KResultOr<FlatPtr> Process::sys$fork(RegisterState& regs)
 #endif
 
     {
+        MutexLocker mmap_locker(address_space().mmap_lock());
+        MutexLocker child_mmap_locker(child->address_space().mmap_lock());
         SpinlockLocker lock(address_space().get_lock());
         for (auto& region : address_space().regions()) {
             dbgln_if(FORK_DEBUG, "fork: cloning Region({}) '{}' @ {}", region, region->name(), region->vaddr());
@@ -126,7 +126,7 @@ static bool validate_inode_mmap_prot(const Process& process, int prot, const Ino
 
 KResultOr<FlatPtr> Process::sys$mmap(Userspace<const Syscall::SC_mmap_params*> user_params)
 {
-    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
     REQUIRE_PROMISE(stdio);
     auto params = TRY(copy_typed_from_user(user_params));
 
@@ -190,6 +190,7 @@ KResultOr<FlatPtr> Process::sys$mmap(Userspace<const Syscall::SC_mmap_params*> u
     if (map_stack && (!map_private || !map_anonymous))
         return EINVAL;
 
+    MutexLocker mmap_locker(address_space().mmap_lock());
     Memory::Region* region = nullptr;
 
     auto range = TRY([&]() -> KResultOr<Memory::VirtualRange> {
@@ -287,6 +288,7 @@ KResultOr<FlatPtr> Process::sys$mprotect(Userspace<void*> addr, size_t size, int
     if (!is_user_range(range_to_mprotect))
         return EFAULT;
 
+    MutexLocker mmap_locker(address_space().mmap_lock());
     if (auto* whole_region = address_space().find_region_from_range(range_to_mprotect)) {
         if (!whole_region->is_mmap())
             return EPERM;
@@ -423,6 +425,7 @@ KResultOr<FlatPtr> Process::sys$madvise(Userspace<void*> address, size_t size, i
     if (!is_user_range(range_to_madvise))
         return EFAULT;
 
+    MutexLocker mmap_locker(address_space().mmap_lock());
     auto* region = address_space().find_region_from_range(range_to_madvise);
     if (!region)
         return EINVAL;
@@ -442,6 +445,15 @@ KResultOr<FlatPtr> Process::sys$madvise(Userspace<void*> address, size_t size, i
         TRY(vmobject.set_volatile(set_volatile, was_purged));
         return was_purged ? 1 : 0;
     }
+    if (advice & (MADV_SEQUENTIAL | MADV_WILLNEED)) {
+        if (advice & MADV_SEQUENTIAL)
+            region->readahead_state().set_sequential(true);
+        if ((advice & MADV_WILLNEED) && region->vmobject().is_inode()) {
+            auto& inode = static_cast<Memory::InodeVMObject&>(region->vmobject()).inode();
+            TRY(inode.prefetch(region->offset_in_vmobject_from_vaddr(range_to_madvise.base()), range_to_madvise.size()));
+        }
+        return 0;
+    }
     return EINVAL;
 }
 
@@ -457,6 +469,7 @@ KResultOr<FlatPtr> Process::sys$set_mmap_name(Userspace<const Syscall::SC_set_mm
     auto name = TRY(try_copy_kstring_from_user(params.name));
     auto range = TRY(expand_range_to_page_boundaries((FlatPtr)params.addr, params.size));
 
+    MutexLocker mmap_locker(address_space().mmap_lock());
     auto* region = address_space().find_region_from_range(range);
     if (!region)
         return EINVAL;
@@ -473,6 +486,7 @@ KResultOr<FlatPtr> Process::sys$munmap(Userspace<void*> addr, size_t size)
 {
     VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
     REQUIRE_PROMISE(stdio);
+    MutexLocker mmap_locker(address_space().mmap_lock());
     return address_space().unmap_mmap_range(VirtualAddress { addr }, size);
 }
 
@@ -484,6 +498,7 @@ KResultOr<FlatPtr> Process::sys$mremap(Userspace<const Syscall::SC_mremap_params
 
     auto old_range = TRY(expand_range_to_page_boundaries((FlatPtr)params.old_address, params.old_size));
 
+    MutexLocker mmap_locker(address_space().mmap_lock());
     auto* old_region = address_space().find_region_from_range(old_range);
     if (!old_region)
         return EINVAL;
@@ -540,6 +555,7 @@ KResultOr<FlatPtr> Process::sys$allocate_tls(Userspace<const char*> initial_data
     if (multiple_threads)
         return EINVAL;
 
+    MutexLocker mmap_locker(address_space().mmap_lock());
     auto range = TRY(address_space().try_allocate_range({}, size));
     auto region = TRY(address_space().allocate_region(range, String("Master TLS"), PROT_READ | PROT_WRITE));
 
@@ -571,6 +587,7 @@ KResultOr<FlatPtr> Process::sys$allocate_tls(Userspace<const char*> initial_data
 KResultOr<FlatPtr> Process::sys$msyscall(Userspace<void*> address)
 {
     VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    MutexLocker mmap_locker(address_space().mmap_lock());
     if (address_space().enforces_syscall_regions())
         return EPERM;
 
@@ -14,7 +14,7 @@ using BlockFlags = Thread::FileBlocker::BlockFlags;
 
 KResultOr<FlatPtr> Process::sys$readv(int fd, Userspace<const struct iovec*> iov, int iov_count)
 {
-    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
     REQUIRE_PROMISE(stdio);
     if (iov_count < 0)
         return EINVAL;
@@ -64,7 +64,7 @@ KResultOr<FlatPtr> Process::sys$readv(int fd, Userspace<const struct iovec*> iov
 
 KResultOr<FlatPtr> Process::sys$read(int fd, Userspace<u8*> buffer, size_t size)
 {
-    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
     REQUIRE_PROMISE(stdio);
     if (size == 0)
         return 0;
@@ -92,4 +92,77 @@ KResultOr<FlatPtr> Process::sys$read(int fd, Userspace<u8*> buffer, size_t size)
     return TRY(description->read(user_buffer.value(), size));
 }
 
+// The positional variants leave the description's offset alone, so they only make sense on files that have one.
+static KResultOr<NonnullRefPtr<OpenFileDescription>> open_readable_file_description_for_positional_io(Process& process, int fd)
+{
+    auto description = TRY(process.fds().open_file_description(fd));
+    if (!description->is_readable())
+        return EBADF;
+    if (description->is_directory())
+        return EISDIR;
+    if (!description->file().is_seekable())
+        return ESPIPE;
+    return description;
+}
+
+KResultOr<FlatPtr> Process::sys$pread(Userspace<const Syscall::SC_pread_params*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+    if (params.size == 0)
+        return 0;
+    if (params.size > NumericLimits<ssize_t>::max())
+        return EINVAL;
+    if (params.offset < 0)
+        return EINVAL;
+    dbgln_if(IO_DEBUG, "sys$pread({}, {}, {}, {})", params.fd, params.buffer, params.size, params.offset);
+    auto description = TRY(open_readable_file_description_for_positional_io(*this, params.fd));
+    auto user_buffer = UserOrKernelBuffer::for_user_buffer((u8*)params.buffer, params.size);
+    if (!user_buffer.has_value())
+        return EFAULT;
+    return TRY(description->read(user_buffer.value(), params.offset, params.size));
+}
+
+KResultOr<FlatPtr> Process::sys$preadv(Userspace<const Syscall::SC_preadv_params*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+    if (params.iov_count < 0)
+        return EINVAL;
+    if (params.offset < 0)
+        return EINVAL;
+
+    // Arbitrary pain threshold.
+    if (params.iov_count > (int)MiB)
+        return EFAULT;
+
+    u64 total_length = 0;
+    Vector<iovec, 32> vecs;
+    if (!vecs.try_resize(params.iov_count))
+        return ENOMEM;
+    TRY(copy_n_from_user(vecs.data(), params.iov, params.iov_count));
+    for (auto& vec : vecs) {
+        total_length += vec.iov_len;
+        if (total_length > NumericLimits<i32>::max())
+            return EINVAL;
+    }
+
+    auto description = TRY(open_readable_file_description_for_positional_io(*this, params.fd));
+
+    size_t nread = 0;
+    for (auto& vec : vecs) {
+        auto buffer = UserOrKernelBuffer::for_user_buffer((u8*)vec.iov_base, vec.iov_len);
+        if (!buffer.has_value())
+            return EFAULT;
+        auto nread_here = TRY(description->read(buffer.value(), params.offset + nread, vec.iov_len));
+        nread += nread_here;
+        if (nread_here < vec.iov_len)
+            break;
+    }
+
+    return nread;
+}
+
 }
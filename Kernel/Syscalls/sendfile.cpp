@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Checked.h>
+#include <AK/NumericLimits.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/KBuffer.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+// Large enough to amortize the per-chunk overhead, small enough that a handful of concurrent copies don't pin much memory.
+static constexpr size_t copy_buffer_size = 64 * KiB;
+
+KResultOr<FlatPtr> Process::do_copy_file_range(OpenFileDescription& source, u64 source_offset, OpenFileDescription& destination, Optional<u64> destination_offset, size_t length)
+{
+    auto buffer_size = min(length, copy_buffer_size);
+    auto kernel_buffer = TRY(KBuffer::try_create_with_size(buffer_size, Memory::Region::Access::ReadWrite, "Copy file range"));
+    auto buffer = UserOrKernelBuffer::for_kernel_buffer(kernel_buffer->data());
+
+    size_t total_copied = 0;
+    while (total_copied < length) {
+        auto chunk_size = min(length - total_copied, buffer_size);
+        auto nread_or_error = source.read(buffer, source_offset + total_copied, chunk_size);
+        if (nread_or_error.is_error()) {
+            if (total_copied > 0)
+                return total_copied;
+            return nread_or_error.error();
+        }
+        auto nread = nread_or_error.value();
+        if (nread == 0)
+            break;
+
+        auto nwritten_or_error = [&]() -> KResultOr<size_t> {
+            if (destination_offset.has_value())
+                return destination.write(destination_offset.value() + total_copied, buffer, nread);
+            return TRY(do_write(destination, buffer, nread));
+        }();
+        if (nwritten_or_error.is_error()) {
+            if (total_copied > 0)
+                return total_copied;
+            return nwritten_or_error.error();
+        }
+        total_copied += nwritten_or_error.value();
+
+        // A non-blocking destination filled up, or the source ran out; either way the caller has to come back later.
+        if (nwritten_or_error.value() < nread || nread < chunk_size)
+            break;
+    }
+    return total_copied;
+}
+
+static KResultOr<NonnullRefPtr<OpenFileDescription>> open_copy_source(Process& process, int fd)
+{
+    auto description = TRY(process.fds().open_file_description(fd));
+    if (!description->is_readable())
+        return EBADF;
+    if (description->is_directory())
+        return EISDIR;
+    // We read the source at explicit offsets, which only works for things backed by an inode.
+    if (!description->file().is_inode())
+        return EINVAL;
+    return description;
+}
+
+static KResultOr<u64> copy_offset_from_user(i64* user_offset)
+{
+    i64 offset;
+    TRY(copy_from_user(&offset, user_offset));
+    if (offset < 0)
+        return EINVAL;
+    return static_cast<u64>(offset);
+}
+
+KResultOr<FlatPtr> Process::sys$sendfile(Userspace<const Syscall::SC_sendfile_params*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+    if (params.count > NumericLimits<ssize_t>::max())
+        return EINVAL;
+
+    dbgln_if(IO_DEBUG, "sys$sendfile({}, {}, {}, {})", params.out_fd, params.in_fd, params.offset, params.count);
+    auto source = TRY(open_copy_source(*this, params.in_fd));
+    auto destination = TRY(fds().open_file_description(params.out_fd));
+    if (!destination->is_writable())
+        return EBADF;
+    if (params.count == 0)
+        return 0;
+
+    if (params.offset) {
+        auto offset = TRY(copy_offset_from_user(params.offset));
+        auto ncopied = TRY(do_copy_file_range(*source, offset, *destination, {}, params.count));
+        i64 new_offset = offset + ncopied;
+        TRY(copy_to_user(params.offset, &new_offset));
+        return ncopied;
+    }
+
+    auto offset = source->offset();
+    auto ncopied = TRY(do_copy_file_range(*source, offset, *destination, {}, params.count));
+    TRY(source->seek(offset + ncopied, SEEK_SET));
+    return ncopied;
+}
+
+KResultOr<FlatPtr> Process::sys$copy_file_range(Userspace<const Syscall::SC_copy_file_range_params*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+    if (params.flags != 0)
+        return EINVAL;
+    if (params.length > NumericLimits<ssize_t>::max())
+        return EINVAL;
+
+    dbgln_if(IO_DEBUG, "sys$copy_file_range({}, {}, {}, {}, {})", params.fd_in, params.offset_in, params.fd_out, params.offset_out, params.length);
+    auto source = TRY(open_copy_source(*this, params.fd_in));
+    auto destination = TRY(fds().open_file_description(params.fd_out));
+    if (!destination->is_writable() || destination->should_append())
+        return EBADF;
+    if (destination->is_directory())
+        return EISDIR;
+    if (!destination->file().is_inode())
+        return EINVAL;
+
+    u64 source_offset = params.offset_in ? TRY(copy_offset_from_user(params.offset_in)) : source->offset();
+    u64 destination_offset = params.offset_out ? TRY(copy_offset_from_user(params.offset_out)) : destination->offset();
+    if (Checked<u64>::addition_would_overflow(source_offset, params.length) || Checked<u64>::addition_would_overflow(destination_offset, params.length))
+        return EOVERFLOW;
+
+    if (source->inode() == destination->inode()) {
+        bool ranges_overlap = source_offset < destination_offset + params.length && destination_offset < source_offset + params.length;
+        if (ranges_overlap)
+            return EINVAL;
+    }
+    if (params.length == 0)
+        return 0;
+
+    auto ncopied = TRY(do_copy_file_range(*source, source_offset, *destination, destination_offset, params.length));
+
+    if (params.offset_in) {
+        i64 new_offset = source_offset + ncopied;
+        TRY(copy_to_user(params.offset_in, &new_offset));
+    } else {
+        TRY(source->seek(source_offset + ncopied, SEEK_SET));
+    }
+    if (params.offset_out) {
+        i64 new_offset = destination_offset + ncopied;
+        TRY(copy_to_user(params.offset_out, &new_offset));
+    } else {
+        TRY(destination->seek(destination_offset + ncopied, SEEK_SET));
+    }
+    return ncopied;
+}
+
+}
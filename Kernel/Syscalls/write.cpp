@@ -13,7 +13,7 @@ namespace Kernel {
 
 KResultOr<FlatPtr> Process::sys$writev(int fd, Userspace<const struct iovec*> iov, int iov_count)
 {
-    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
     REQUIRE_PROMISE(stdio);
     if (iov_count < 0)
         return EINVAL;
@@ -54,14 +54,87 @@ KResultOr<FlatPtr> Process::sys$writev(int fd, Userspace<const struct iovec*> io
     return nwritten;
 }
 
-KResultOr<FlatPtr> Process::do_write(OpenFileDescription& description, const UserOrKernelBuffer& data, size_t data_size)
+// The positional variants leave the description's offset alone, so they only make sense on files that have one.
+static KResultOr<NonnullRefPtr<OpenFileDescription>> open_writable_file_description_for_positional_io(Process& process, int fd)
 {
-    size_t total_nwritten = 0;
+    auto description = TRY(process.fds().open_file_description(fd));
+    if (!description->is_writable())
+        return EBADF;
+    if (!description->file().is_seekable())
+        return ESPIPE;
+    return description;
+}
+
+KResultOr<FlatPtr> Process::sys$pwrite(Userspace<const Syscall::SC_pwrite_params*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+    if (params.size == 0)
+        return 0;
+    if (params.size > NumericLimits<ssize_t>::max())
+        return EINVAL;
+    if (params.offset < 0)
+        return EINVAL;
+
+    dbgln_if(IO_DEBUG, "sys$pwrite({}, {}, {}, {})", params.fd, params.data, params.size, params.offset);
+    auto description = TRY(open_writable_file_description_for_positional_io(*this, params.fd));
+    auto buffer = UserOrKernelBuffer::for_user_buffer((u8*)params.data, params.size);
+    if (!buffer.has_value())
+        return EFAULT;
+    return TRY(description->write(params.offset, buffer.value(), params.size));
+}
+
+KResultOr<FlatPtr> Process::sys$pwritev(Userspace<const Syscall::SC_pwritev_params*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+    if (params.iov_count < 0)
+        return EINVAL;
+    if (params.offset < 0)
+        return EINVAL;
+
+    // Arbitrary pain threshold.
+    if (params.iov_count > (int)MiB)
+        return EFAULT;
+
+    u64 total_length = 0;
+    Vector<iovec, 32> vecs;
+    if (!vecs.try_resize(params.iov_count))
+        return ENOMEM;
+    TRY(copy_n_from_user(vecs.data(), params.iov, params.iov_count));
+    for (auto& vec : vecs) {
+        total_length += vec.iov_len;
+        if (total_length > NumericLimits<i32>::max())
+            return EINVAL;
+    }
 
-    if (description.should_append() && description.file().is_seekable()) {
-        TRY(description.seek(0, SEEK_END));
+    auto description = TRY(open_writable_file_description_for_positional_io(*this, params.fd));
+
+    size_t nwritten = 0;
+    for (auto& vec : vecs) {
+        auto buffer = UserOrKernelBuffer::for_user_buffer((u8*)vec.iov_base, vec.iov_len);
+        if (!buffer.has_value())
+            return EFAULT;
+        auto result = description->write(params.offset + nwritten, buffer.value(), vec.iov_len);
+        if (result.is_error()) {
+            if (nwritten == 0)
+                return result.error();
+            return nwritten;
+        }
+        nwritten += result.value();
+        if (result.value() < vec.iov_len)
+            break;
     }
 
+    return nwritten;
+}
+
+KResultOr<FlatPtr> Process::do_write(OpenFileDescription& description, const UserOrKernelBuffer& data, size_t data_size)
+{
+    size_t total_nwritten = 0;
+
     while (total_nwritten < data_size) {
         while (!description.can_write()) {
             if (!description.is_blocking()) {
@@ -93,7 +166,7 @@ KResultOr<FlatPtr> Process::do_write(OpenFileDescription& description, const Use
 
 KResultOr<FlatPtr> Process::sys$write(int fd, Userspace<const u8*> data, size_t size)
 {
-    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
     REQUIRE_PROMISE(stdio);
     if (size == 0)
         return 0;
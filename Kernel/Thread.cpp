@@ -385,6 +385,7 @@ void Thread::exit(void* exit_value)
     u32 unlock_count;
     [[maybe_unused]] auto rc = unlock_process_if_locked(unlock_count);
     if (m_thread_specific_range.has_value()) {
+        MutexLocker mmap_locker(process().address_space().mmap_lock());
         auto* region = process().address_space().find_region_from_range(m_thread_specific_range.value());
         process().address_space().deallocate_region(*region);
     }
@@ -1188,6 +1189,7 @@ KResult Thread::make_thread_specific_region(Badge<Process>)
     if (!process().m_master_tls_region)
         return KSuccess;
 
+    MutexLocker mmap_locker(process().address_space().mmap_lock());
     auto range = TRY(process().address_space().try_allocate_range({}, thread_specific_region_size()));
     auto* region = TRY(process().address_space().allocate_region(range, "Thread-specific", PROT_READ | PROT_WRITE));
 
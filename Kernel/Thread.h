@@ -156,6 +156,7 @@ class Thread
     friend class Process;
     friend class Scheduler;
     friend struct ThreadReadyQueue;
+    friend struct ThreadReadyQueues;
 
 public:
     inline static Thread* current()
@@ -302,7 +303,7 @@ public:
         virtual bool can_be_interrupted() const { return true; }
         virtual bool setup_blocker();
 
-        Thread& thread() { return m_thread; }
+        Thread& thread() { return *m_thread; }
 
         enum class UnblockImmediatelyReason {
             UnblockConditionAlreadyMet,
@@ -354,6 +355,11 @@ public:
         {
         }
 
+        // For blockers that only listen to a blocker set on behalf of some object, and never block a thread.
+        struct NotBlockingAnyThread {
+        };
+        explicit Blocker(NotBlockingAnyThread) { }
+
         void do_set_interrupted_by_death()
         {
             m_was_interrupted_by_death = true;
@@ -394,7 +400,7 @@ public:
 
     private:
         BlockerSet* m_blocker_set { nullptr };
-        NonnullRefPtr<Thread> m_thread;
+        RefPtr<Thread> m_thread;
         u8 m_was_interrupted_by_signal { 0 };
         bool m_is_blocking { false };
         bool m_was_interrupted_by_death { false };
@@ -604,6 +610,13 @@ public:
         virtual Type blocker_type() const override { return Type::File; }
 
         virtual bool unblock_if_conditions_are_met(bool, void*) = 0;
+
+    protected:
+        FileBlocker() = default;
+        explicit FileBlocker(NotBlockingAnyThread tag)
+            : Blocker(tag)
+        {
+        }
     };
 
     class OpenFileDescriptionBlocker : public FileBlocker {
@@ -1213,6 +1226,8 @@ private:
 
     IntrusiveListNode<Thread> m_process_thread_list_node;
     int m_runnable_priority { -1 };
+    // The processor whose ready queues the thread is in, if m_runnable_priority says that it is in any.
+    u32 m_runnable_processor { 0 };
 
     friend class WaitQueue;
 
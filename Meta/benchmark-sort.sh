@@ -0,0 +1,50 @@
+#!/usr/bin/env bash
+
+# Times sort(1) on a large generated input with different thread counts, both when everything
+# fits into memory and when the input has to be spilled to temporary files.
+#
+# Usage: Meta/benchmark-sort.sh [sort binary] [line count] [thread counts...]
+#
+# The sort binary can be a host build of Userland/Utilities/sort.cpp, or /bin/sort when run
+# inside Serenity. The outputs of all runs are compared against each other.
+
+set -e
+
+sort_binary=${1:-sort}
+line_count=${2:-2000000}
+shift 2 || shift $#
+thread_counts=("$@")
+if [ ${#thread_counts[@]} -eq 0 ]; then
+    thread_counts=(1 2 4)
+fi
+
+work_directory=$(mktemp -d)
+trap 'rm -rf "$work_directory"' EXIT
+
+# Fixed seed, so that runs on different machines sort the same input.
+awk -v count="$line_count" 'BEGIN {
+    srand(1);
+    for (i = 0; i < count; ++i)
+        printf "%08x %d line %d\n", int(rand() * 4294967295), int(rand() * 1000000), i;
+}' > "$work_directory/input"
+
+echo "$sort_binary: $line_count lines, $(wc -c < "$work_directory/input") bytes"
+
+TIMEFORMAT="%R"
+run() {
+    local name=$1
+    shift
+    local seconds
+    seconds=$( { time "$sort_binary" "$@" "$work_directory/input" > "$work_directory/$name" 2> /dev/null; } 2>&1 )
+    printf "  %-28s %ss\n" "$name" "$seconds"
+    if [ -e "$work_directory/expected" ]; then
+        cmp -s "$work_directory/expected" "$work_directory/$name" || { echo "  output of $name differs!"; exit 1; }
+    else
+        cp "$work_directory/$name" "$work_directory/expected"
+    fi
+}
+
+for threads in "${thread_counts[@]}"; do
+    run "in-memory-$threads-threads" --parallel "$threads"
+    run "spilled-$threads-threads" --parallel "$threads" -S 16M -T "$work_directory"
+done
@@ -7,7 +7,9 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/HashTable.h>
+#include <AK/Optional.h>
 #include <AK/String.h>
+#include <AK/Vector.h>
 
 TEST_CASE(construct)
 {
@@ -198,3 +200,149 @@ TEST_CASE(basic_contains)
     EXPECT_EQ(table.remove(1), true);
     EXPECT_EQ(table.contains(1), false);
 }
+
+TEST_CASE(iterate_after_removing_and_reinserting)
+{
+    HashTable<int> table;
+    for (int i = 0; i < 1000; ++i)
+        table.set(i);
+    for (int i = 0; i < 1000; i += 2)
+        EXPECT_EQ(table.remove(i), true);
+    for (int i = 2000; i < 2100; ++i)
+        table.set(i);
+
+    size_t count = 0;
+    int sum = 0;
+    for (auto value : table) {
+        EXPECT(value % 2 == 1 || value >= 2000);
+        ++count;
+        sum += value;
+    }
+    EXPECT_EQ(count, 600u);
+    EXPECT_EQ(table.size(), 600u);
+    EXPECT_EQ(sum, 250000 + 204950);
+}
+
+TEST_CASE(ordered_remove_keeps_insertion_order)
+{
+    OrderedHashTable<int> table;
+    for (int i = 0; i < 100; ++i)
+        table.set(i);
+    for (int i = 0; i < 100; i += 3)
+        table.remove(i);
+    table.set(0);
+
+    Vector<int> expected;
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 != 0)
+            expected.append(i);
+    }
+    expected.append(0);
+
+    Vector<int> values;
+    for (auto value : table)
+        values.append(value);
+    EXPECT_EQ(values, expected);
+}
+
+TEST_CASE(tombstones_do_not_grow_table)
+{
+    HashTable<int> table;
+    for (int i = 0; i < 100; ++i)
+        table.set(i);
+
+    Optional<size_t> capacity;
+    for (int i = 100; i < 100000; ++i) {
+        table.set(i);
+        EXPECT_EQ(table.remove(i - 100), true);
+
+        // Give the table a chance to settle on a capacity first.
+        if (i == 1000)
+            capacity = table.capacity();
+    }
+
+    EXPECT_EQ(table.size(), 100u);
+    EXPECT_EQ(table.capacity(), capacity.value());
+    for (int i = 99900; i < 100000; ++i)
+        EXPECT(table.contains(i));
+}
+
+TEST_CASE(ensure_capacity)
+{
+    HashTable<int> table;
+    table.ensure_capacity(1000);
+    auto capacity = table.capacity();
+    EXPECT(capacity >= 1000u);
+
+    for (int i = 0; i < 1000; ++i)
+        table.set(i);
+    EXPECT_EQ(table.capacity(), capacity);
+}
+
+static constexpr int benchmark_key_count = 100000;
+
+BENCHMARK_CASE(benchmark_insert)
+{
+    for (int i = 0; i < 10; ++i) {
+        HashTable<int> table;
+        for (int key = 0; key < benchmark_key_count; ++key)
+            table.set(key);
+        EXPECT_EQ(table.size(), static_cast<size_t>(benchmark_key_count));
+    }
+}
+
+BENCHMARK_CASE(benchmark_find)
+{
+    HashTable<int> table;
+    for (int key = 0; key < benchmark_key_count; ++key)
+        table.set(key * 2);
+
+    size_t found = 0;
+    for (int i = 0; i < 10; ++i) {
+        // Half of these lookups hit and half of them miss.
+        for (int key = 0; key < benchmark_key_count * 2; ++key)
+            found += table.contains(key);
+    }
+    EXPECT_EQ(found, 10u * benchmark_key_count);
+}
+
+BENCHMARK_CASE(benchmark_find_strings)
+{
+    Vector<String> keys;
+    HashTable<String> table;
+    for (int key = 0; key < benchmark_key_count; ++key) {
+        keys.append(String::formatted("key{}", key));
+        table.set(keys.last());
+    }
+
+    size_t found = 0;
+    for (int i = 0; i < 10; ++i) {
+        for (auto& key : keys)
+            found += table.contains(key);
+    }
+    EXPECT_EQ(found, 10u * benchmark_key_count);
+}
+
+BENCHMARK_CASE(benchmark_erase)
+{
+    for (int i = 0; i < 10; ++i) {
+        HashTable<int> table;
+        for (int key = 0; key < benchmark_key_count; ++key)
+            table.set(key);
+        for (int key = 0; key < benchmark_key_count; ++key)
+            table.remove(key);
+        EXPECT(table.is_empty());
+    }
+}
+
+BENCHMARK_CASE(benchmark_insert_and_erase_churn)
+{
+    HashTable<int> table;
+    for (int key = 0; key < 1000; ++key)
+        table.set(key);
+    for (int key = 1000; key < benchmark_key_count * 10; ++key) {
+        table.set(key);
+        table.remove(key - 1000);
+    }
+    EXPECT_EQ(table.size(), 1000u);
+}
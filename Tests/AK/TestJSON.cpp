@@ -7,7 +7,9 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/HashMap.h>
+#include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
+#include <AK/JsonParser.h>
 #include <AK/JsonValue.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
@@ -122,3 +124,140 @@ TEST_CASE(json_u64_roundtrip)
     EXPECT_EQ_FORCE(value.has_value(), true);
     EXPECT_EQ(value->as_u64(), big_value);
 }
+
+TEST_CASE(json_strings_with_and_without_escapes)
+{
+    auto json = JsonValue::from_string(R"({"plain":"value","escaped\"key":"a\nb","":"","plain":"again","u":"\u00e9"})");
+    EXPECT_EQ_FORCE(json.has_value(), true);
+    auto& object = json->as_object();
+    EXPECT_EQ(object.size(), 4u);
+    EXPECT_EQ(object.get("plain").as_string(), "again");
+    EXPECT_EQ(object.get("escaped\"key").as_string(), "a\nb");
+    EXPECT_EQ(object.get("").as_string(), "");
+    EXPECT_EQ(object.get("u").as_string(), "\xc3\xa9");
+
+    EXPECT(!JsonValue::from_string(R"({"unterminated)").has_value());
+    EXPECT(!JsonValue::from_string("\"control\tcharacter\"").has_value());
+}
+
+TEST_CASE(json_repeated_keys_share_storage)
+{
+    auto json = JsonValue::from_string(R"([{"pid":1,"name":"a"},{"pid":2,"name":"b"}])");
+    EXPECT_EQ_FORCE(json.has_value(), true);
+    auto& array = json->as_array();
+
+    Vector<String> first_keys;
+    array.at(0).as_object().for_each_member([&](auto& key, auto&) { first_keys.append(key); });
+    size_t index = 0;
+    array.at(1).as_object().for_each_member([&](auto& key, auto&) { EXPECT(key.impl() == first_keys[index++].impl()); });
+    EXPECT_EQ(index, 2u);
+}
+
+// Shaped like /proc/all, which system monitors re-parse every second.
+static String make_process_list_json()
+{
+    StringBuilder builder;
+    builder.append('[');
+    for (size_t i = 0; i < 500; ++i) {
+        if (i != 0)
+            builder.append(',');
+        builder.appendff(R"({{"pid":{},"pgid":{},"pgp":{},"sid":{},"uid":100,"gid":100,"ppid":1,"nfds":12,"name":"Process{}",)", i, i, i, i, i);
+        builder.append(R"("executable":"/bin/Process","tty":"/dev/tty0","pledge":"stdio rpath","veil":"None","amount_virtual":1234567,)");
+        builder.append(R"("amount_resident":123456,"amount_shared":12345,"icon_id":-1,"threads":[{"tid":1,"times_scheduled":123,)");
+        builder.append(R"("name":"main","state":"Running","cpu":0,"priority":30,"syscall_count":4567,"inode_faults":0,"zero_faults":12}]})");
+    }
+    builder.append(']');
+    return builder.to_string();
+}
+
+BENCHMARK_CASE(parse_process_list)
+{
+    auto json = make_process_list_json();
+    for (size_t i = 0; i < 100; ++i) {
+        auto value = JsonValue::from_string(json);
+        EXPECT_EQ(value->as_array().size(), 500u);
+    }
+}
+
+// Every distinct StringImpl in a parsed document is one string allocation made by the parser.
+static void collect_string_impls(JsonValue const& value, HashTable<StringImpl const*>& impls, size_t& strings)
+{
+    if (value.is_string()) {
+        impls.set(value.as_string().impl());
+        ++strings;
+    } else if (value.is_array()) {
+        value.as_array().for_each([&](auto& element) { collect_string_impls(element, impls, strings); });
+    } else if (value.is_object()) {
+        value.as_object().for_each_member([&](auto& key, auto& member) {
+            impls.set(key.impl());
+            ++strings;
+            collect_string_impls(member, impls, strings);
+        });
+    }
+}
+
+BENCHMARK_CASE(process_list_string_allocations)
+{
+    auto value = JsonValue::from_string(make_process_list_json());
+    EXPECT_EQ_FORCE(value.has_value(), true);
+
+    HashTable<StringImpl const*> impls;
+    size_t strings = 0;
+    collect_string_impls(*value, impls, strings);
+    outln("{} strings in the document, backed by {} string allocations", strings, impls.size());
+
+    // Every process has the same keys, which should only be allocated once per document rather than once per object.
+    EXPECT(impls.size() * 4 < strings);
+}
+
+class EventRecorder final : public JsonVisitor {
+public:
+    Vector<String> events;
+
+    virtual void visit_object_start(StringView key) override { events.append(String::formatted("{}{{", prefix(key))); }
+    virtual void visit_object_end() override { events.append("}"); }
+    virtual void visit_array_start(StringView key) override { events.append(String::formatted("{}[", prefix(key))); }
+    virtual void visit_array_end() override { events.append("]"); }
+    virtual void visit_string(StringView key, StringView value) override { events.append(String::formatted("{}'{}'", prefix(key), value)); }
+    virtual void visit_value(StringView key, JsonValue const& value) override { events.append(String::formatted("{}{}", prefix(key), value.to_string())); }
+
+private:
+    static String prefix(StringView key) { return key.is_null() ? String::empty() : String::formatted("{}=", key); }
+};
+
+TEST_CASE(json_visitor)
+{
+    EventRecorder recorder;
+    EXPECT(JsonParser(R"( {"a": [1, -2.5, true, null, "x\ty"], "b\"": {}, "": "" } )").parse(recorder));
+    Vector<String> expected { "{", "a=[", "1", "-2.5", "true", "null", "'x\ty'", "]", "b\"={", "}", "=''", "}" };
+    EXPECT_EQ(recorder.events, expected);
+
+    EventRecorder scalar_recorder;
+    EXPECT(JsonParser("42").parse(scalar_recorder));
+    EXPECT_EQ(scalar_recorder.events, Vector<String> { "42" });
+
+    EventRecorder invalid_recorder;
+    EXPECT(!JsonParser(R"({"a":1,})").parse(invalid_recorder));
+    EXPECT(!JsonParser(R"({"a":1} trailing)").parse(invalid_recorder));
+    EXPECT(!JsonParser(R"(["unterminated)").parse(invalid_recorder));
+}
+
+BENCHMARK_CASE(visit_process_list)
+{
+    class PidCounter final : public JsonVisitor {
+    public:
+        size_t pids { 0 };
+        virtual void visit_value(StringView key, JsonValue const&) override
+        {
+            if (key == "pid"sv)
+                ++pids;
+        }
+    };
+
+    auto json = make_process_list_json();
+    for (size_t i = 0; i < 100; ++i) {
+        PidCounter counter;
+        EXPECT(JsonParser(json).parse(counter));
+        EXPECT_EQ(counter.pids, 500u);
+    }
+}
@@ -7,6 +7,8 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/MemMem.h>
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
 
 TEST_CASE(bitap)
 {
@@ -66,3 +68,82 @@ TEST_CASE(kmp_two_chunks)
     EXPECT_EQ(result_2.value_or(9), 4u);
     EXPECT(!result_3.has_value());
 }
+
+static Optional<size_t> naive_memmem(ReadonlyBytes haystack, ReadonlyBytes needle)
+{
+    for (size_t i = 0; i + needle.size() <= haystack.size(); ++i) {
+        if (haystack.slice(i, needle.size()) == needle)
+            return i;
+    }
+    return {};
+}
+
+TEST_CASE(first_byte_search_matches_naive_search)
+{
+    // A small alphabet makes for lots of candidates that only partially match.
+    u32 seed = 42;
+    auto next_byte = [&] {
+        seed = seed * 1103515245 + 12345;
+        return static_cast<u8>('a' + (seed >> 16) % 3);
+    };
+
+    Vector<u8> haystack;
+    for (size_t i = 0; i < 4096; ++i)
+        haystack.append(next_byte());
+
+    for (size_t needle_length = 1; needle_length < 40; ++needle_length) {
+        for (size_t start = 0; start < 64; ++start) {
+            Vector<u8> needle;
+            for (size_t i = 0; i < needle_length; ++i)
+                needle.append(next_byte());
+            // Sometimes search for something that is definitely there, at a word-unaligned offset.
+            if (start % 2) {
+                needle.clear();
+                needle.append(haystack.span().slice(start * 61 + 3, needle_length).data(), needle_length);
+            }
+
+            auto haystack_bytes = haystack.span().slice(start);
+            auto expected = naive_memmem(haystack_bytes, needle);
+            auto result = AK::memmem_optional(haystack_bytes.data(), haystack_bytes.size(), needle.data(), needle.size());
+            EXPECT_EQ(result, expected);
+        }
+    }
+}
+
+TEST_CASE(many_false_candidates)
+{
+    // Every byte is a candidate for the first byte of the needle, so this falls back to bitap and KMP.
+    Vector<u8> haystack;
+    haystack.resize(1000);
+    haystack.span().fill('a');
+    haystack.append('b');
+
+    auto short_needle = "aaab"sv;
+    EXPECT_EQ(AK::memmem_optional(haystack.data(), haystack.size(), short_needle.characters_without_null_termination(), short_needle.length()), 997u);
+
+    auto long_needle = String::formatted("{}b", String::repeated('a', 40));
+    EXPECT_EQ(AK::memmem_optional(haystack.data(), haystack.size(), long_needle.characters(), long_needle.length()), 960u);
+
+    auto missing_needle = "aac"sv;
+    EXPECT(!AK::memmem_optional(haystack.data(), haystack.size(), missing_needle.characters_without_null_termination(), missing_needle.length()).has_value());
+}
+
+BENCHMARK_CASE(search_log_lines)
+{
+    // Looks for a word that doesn't occur in a lot of short lines, as a log search would.
+    StringBuilder builder;
+    for (size_t i = 0; i < 64; ++i)
+        builder.appendff("2021-10-17 12:{:02}:00 [info] request {} handled in {}ms\n", i % 60, i, i * 7 % 100);
+    auto line_block = builder.build();
+    auto lines = line_block.split_view('\n');
+    auto needle = "[error]"sv;
+
+    size_t found = 0;
+    for (size_t i = 0; i < 100'000; ++i) {
+        for (auto line : lines) {
+            if (AK::memmem_optional(line.characters_without_null_termination(), line.length(), needle.characters_without_null_termination(), needle.length()).has_value())
+                ++found;
+        }
+    }
+    EXPECT_EQ(found, 0u);
+}
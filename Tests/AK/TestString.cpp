@@ -24,6 +24,22 @@ TEST_CASE(construct_empty)
     EXPECT(String("").impl() == String::empty().impl());
 }
 
+TEST_CASE(construct_single_byte)
+{
+    String a = "a";
+    EXPECT_EQ(a, "a");
+    EXPECT_EQ(a.length(), 1u);
+    EXPECT(!strcmp(a.characters(), "a"));
+    EXPECT(a.impl() == String("a").impl());
+    EXPECT(a.impl() == String("ab", 1).impl());
+    EXPECT(a.impl() != String("b").impl());
+    EXPECT(String("A").to_lowercase() == a);
+
+    auto fly = FlyString("a");
+    EXPECT(fly.impl() == a.impl());
+    EXPECT_EQ(FlyString(a), fly);
+}
+
 TEST_CASE(construct_contents)
 {
     String test_string = "ABCDEF";
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/HashTable.h>
+#include <AK/String.h>
+#include <AK/StringHash.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+static constexpr StringView long_string = "The quick brown fox jumps over the lazy dog, then runs back to https://example.com/a/rather/long/url?with=some&query=parameters#and-a-fragment"sv;
+
+template<unsigned... Lengths>
+static void expect_compile_time_hashes_match_run_time_hashes(IndexSequence<Lengths...>)
+{
+    constexpr u32 compile_time_hashes[] = { string_hash(long_string.characters_without_null_termination(), Lengths)... };
+    for (size_t length = 0; length < sizeof...(Lengths); ++length) {
+        // Hash a copy, so that the run time hash doesn't get constant folded.
+        auto copy = String(long_string.substring_view(0, length));
+        EXPECT_EQ(string_hash(copy.characters(), length), compile_time_hashes[length]);
+    }
+}
+
+TEST_CASE(compile_time_hashes_match_run_time_hashes)
+{
+    static_assert(long_string.length() > 128);
+    expect_compile_time_hashes_match_run_time_hashes(MakeIndexSequence<128>());
+}
+
+TEST_CASE(unaligned_input)
+{
+    char buffer[128 + 8];
+    for (size_t offset = 0; offset < 8; ++offset) {
+        __builtin_memcpy(buffer + offset, long_string.characters_without_null_termination(), 128);
+        for (size_t length = 0; length <= 128; ++length)
+            EXPECT_EQ(string_hash(buffer + offset, length), string_hash(long_string.characters_without_null_termination(), length));
+    }
+}
+
+TEST_CASE(prefixes_do_not_collide)
+{
+    // Padding a key with zero bytes must change its hash too.
+    char zeroes[128] {};
+    HashTable<u32> hashes;
+    for (size_t length = 0; length <= 128; ++length) {
+        EXPECT_EQ(hashes.set(string_hash(long_string.characters_without_null_termination(), length)), AK::HashSetResult::InsertedNewEntry);
+        if (length > 0)
+            EXPECT_EQ(hashes.set(string_hash(zeroes, length)), AK::HashSetResult::InsertedNewEntry);
+    }
+}
+
+TEST_CASE(single_bit_flips_do_not_collide)
+{
+    for (size_t length : { 1, 3, 4, 7, 8, 15, 16, 17, 31, 48, 49, 64, 100 }) {
+        auto bytes = String(long_string.substring_view(0, length)).to_byte_buffer();
+        HashTable<u32> hashes;
+        hashes.set(string_hash((char const*)bytes.data(), length));
+        for (size_t bit = 0; bit < length * 8; ++bit) {
+            bytes[bit / 8] ^= 1 << (bit % 8);
+            EXPECT_EQ(hashes.set(string_hash((char const*)bytes.data(), length)), AK::HashSetResult::InsertedNewEntry);
+            bytes[bit / 8] ^= 1 << (bit % 8);
+        }
+    }
+}
+
+TEST_CASE(avalanche)
+{
+    // On average, flipping one input bit should flip about half of the output bits.
+    for (size_t length : { 2, 5, 8, 12, 16, 24, 40, 64, 120 }) {
+        auto bytes = String(long_string.substring_view(0, length)).to_byte_buffer();
+        auto original_hash = string_hash((char const*)bytes.data(), length);
+        size_t flipped_output_bits = 0;
+        for (size_t bit = 0; bit < length * 8; ++bit) {
+            bytes[bit / 8] ^= 1 << (bit % 8);
+            flipped_output_bits += __builtin_popcount(original_hash ^ string_hash((char const*)bytes.data(), length));
+            bytes[bit / 8] ^= 1 << (bit % 8);
+        }
+        auto average = static_cast<double>(flipped_output_bits) / (length * 8);
+        EXPECT(average > 14.0 && average < 18.0);
+    }
+}
+
+TEST_CASE(similar_keys_are_spread_evenly)
+{
+    // HashTable picks buckets with the high bits of a hash and stores the low bits alongside them,
+    // so both ends need to be well distributed, even for keys that only differ in a few characters.
+    static constexpr size_t key_count = 1 << 16;
+    static constexpr size_t bucket_count = 256;
+    size_t low_buckets[bucket_count] {};
+    size_t high_buckets[bucket_count] {};
+    HashTable<u32> hashes;
+    for (size_t i = 0; i < key_count; ++i) {
+        auto key = String::formatted("/home/anon/Documents/{}.txt", i);
+        auto hash = key.hash();
+        ++low_buckets[hash % bucket_count];
+        ++high_buckets[hash >> 24];
+        hashes.set(hash);
+    }
+
+    // 2^16 random 32-bit values are expected to have about 0.5 collisions.
+    EXPECT(hashes.size() >= key_count - 4);
+
+    for (auto* buckets : { low_buckets, high_buckets }) {
+        double chi_squared = 0;
+        double expected = static_cast<double>(key_count) / bucket_count;
+        for (size_t i = 0; i < bucket_count; ++i)
+            chi_squared += (buckets[i] - expected) * (buckets[i] - expected) / expected;
+        // The 99.9th percentile of the chi-squared distribution with 255 degrees of freedom is about 330.
+        EXPECT(chi_squared < 330.0);
+    }
+}
+
+static void hash_keys_of_length(size_t length)
+{
+    auto key = String::repeated('x', length);
+    u64 hash_sum = 0;
+    size_t iterations = 64 * MiB / max(length, static_cast<size_t>(8));
+    for (size_t i = 0; i < iterations; ++i) {
+        // Keep the compiler from hoisting the hash out of the loop.
+        asm volatile("" ::"r"(key.characters())
+                     : "memory");
+        hash_sum += string_hash(key.characters(), length);
+    }
+    EXPECT_EQ(hash_sum, iterations * static_cast<u64>(string_hash(key.characters(), length)));
+}
+
+BENCHMARK_CASE(hash_8_byte_keys)
+{
+    hash_keys_of_length(8);
+}
+
+BENCHMARK_CASE(hash_24_byte_keys)
+{
+    hash_keys_of_length(24);
+}
+
+BENCHMARK_CASE(hash_64_byte_keys)
+{
+    hash_keys_of_length(64);
+}
+
+BENCHMARK_CASE(hash_256_byte_keys)
+{
+    hash_keys_of_length(256);
+}
+
+BENCHMARK_CASE(hash_4096_byte_keys)
+{
+    hash_keys_of_length(4096);
+}
@@ -8,9 +8,11 @@
 
 #include <AK/Array.h>
 #include <AK/String.h>
+#include <AK/StringBuilder.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 #include <AK/Utf16View.h>
+#include <AK/Utf8View.h>
 
 TEST_CASE(decode_ascii)
 {
@@ -280,3 +282,76 @@ TEST_CASE(substring_view)
         EXPECT_EQ(view.to_utf8(Utf16View::AllowInvalidCodeUnits::No), "\ufffd"sv);
     }
 }
+
+TEST_CASE(transcode_long_mixed_text)
+{
+    // Long enough for the ASCII runs to be converted in bulk, with invalid and multi-byte sequences in between.
+    StringBuilder builder;
+    for (size_t i = 0; i < 200; ++i) {
+        builder.append("abcdefghijklmnopqrstu"sv.substring_view(0, i % 21));
+        builder.append(Array { "é"sv, "世"sv, "😀"sv, "\xff"sv, "\xe4\xb8"sv, "\xed\xa0\xbd"sv }[i % 6]);
+    }
+    auto utf8_string = builder.to_string();
+    Utf8View utf8_view { utf8_string };
+
+    Vector<u16> expected;
+    for (auto code_point : utf8_view)
+        AK::code_point_to_utf16(expected, code_point);
+
+    auto utf16_data = AK::utf8_to_utf16(utf8_view);
+    EXPECT_EQ(utf16_data, expected);
+
+    Utf16View utf16_view { utf16_data };
+    StringBuilder expected_utf8;
+    for (auto code_point : utf16_view)
+        expected_utf8.append_code_point(code_point);
+    EXPECT_EQ(utf16_view.to_utf8(Utf16View::AllowInvalidCodeUnits::No), expected_utf8.to_string());
+    auto round_trip = AK::utf8_to_utf16(utf16_view.to_utf8(Utf16View::AllowInvalidCodeUnits::Yes));
+    EXPECT_EQ(round_trip, utf16_data);
+}
+
+static String make_ascii_heavy_text()
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 20000; ++i)
+        builder.append("The quick brown fox jumps over the lazy dog. Voilà!\n");
+    return builder.to_string();
+}
+
+static String make_cjk_heavy_text()
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 20000; ++i)
+        builder.append("敏捷的棕色狐狸跳过了懒狗。こんにちは世界、 速い茶色の狐!\n");
+    return builder.to_string();
+}
+
+BENCHMARK_CASE(utf8_to_utf16_ascii_heavy_text)
+{
+    auto text = make_ascii_heavy_text();
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(AK::utf8_to_utf16(text).size(), text.length() - 20000);
+}
+
+BENCHMARK_CASE(utf8_to_utf16_cjk_heavy_text)
+{
+    auto text = make_cjk_heavy_text();
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(AK::utf8_to_utf16(text).size(), 30u * 20000);
+}
+
+BENCHMARK_CASE(utf16_to_utf8_ascii_heavy_text)
+{
+    auto text = make_ascii_heavy_text();
+    auto utf16_data = AK::utf8_to_utf16(text);
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(Utf16View(utf16_data).to_utf8(Utf16View::AllowInvalidCodeUnits::Yes).length(), text.length());
+}
+
+BENCHMARK_CASE(utf16_to_utf8_cjk_heavy_text)
+{
+    auto text = make_cjk_heavy_text();
+    auto utf16_data = AK::utf8_to_utf16(text);
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(Utf16View(utf16_data).to_utf8(Utf16View::AllowInvalidCodeUnits::Yes).length(), text.length());
+}
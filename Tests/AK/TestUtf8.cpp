@@ -7,6 +7,7 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/ByteBuffer.h>
+#include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
 
 TEST_CASE(decode_ascii)
@@ -217,3 +218,56 @@ TEST_CASE(trim)
         EXPECT_EQ(view.trim(whitespace, TrimMode::Right).as_string(), "\u180E");
     }
 }
+
+TEST_CASE(validate_long_ascii_runs)
+{
+    // Long enough for the ASCII runs to be checked in bulk, with the invalid byte at every possible position.
+    for (size_t invalid_offset = 0; invalid_offset < 70; ++invalid_offset) {
+        StringBuilder builder;
+        for (size_t i = 0; i < 70; ++i) {
+            if (i == invalid_offset)
+                builder.append((char)0xff);
+            else if (i % 23 == 22)
+                builder.append("é");
+            else
+                builder.append('a');
+        }
+        auto string = builder.to_string();
+
+        size_t valid_bytes;
+        EXPECT(!Utf8View(string).validate(valid_bytes));
+        EXPECT_EQ(valid_bytes, string.find((char)0xff).value());
+        EXPECT(Utf8View(string.substring_view(0, valid_bytes)).validate());
+        EXPECT_EQ(Utf8View(string).length(), 70u);
+    }
+}
+
+static String make_ascii_heavy_text()
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 20000; ++i)
+        builder.append("The quick brown fox jumps over the lazy dog. Voilà!\n");
+    return builder.to_string();
+}
+
+static String make_cjk_heavy_text()
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 20000; ++i)
+        builder.append("敏捷的棕色狐狸跳过了懒狗。こんにちは世界、 速い茶色の狐!\n");
+    return builder.to_string();
+}
+
+BENCHMARK_CASE(validate_ascii_heavy_text)
+{
+    auto text = make_ascii_heavy_text();
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT(Utf8View(text).validate());
+}
+
+BENCHMARK_CASE(validate_cjk_heavy_text)
+{
+    auto text = make_cjk_heavy_text();
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT(Utf8View(text).validate());
+}
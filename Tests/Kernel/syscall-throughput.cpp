@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/Function.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <serenity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Runs the same syscall in a loop on a growing number of threads, and reports how the total throughput scales.
+// Every thread works on its own file descriptors, so the only thing they can contend on is process-wide state.
+
+struct Benchmark {
+    StringView name;
+    // Called once per thread, and returns false if the thread couldn't be set up.
+    Function<bool(int thread_index)> set_up;
+    // Runs one iteration, and returns false on error.
+    Function<bool(int thread_index)> run;
+};
+
+static constexpr int max_threads = 64;
+static int s_zero_fds[max_threads];
+static int s_null_fds[max_threads];
+static int s_socket_fds[max_threads][2];
+static u32 s_futex_words[max_threads];
+
+static Atomic<bool> s_start;
+static Atomic<bool> s_stop;
+static Atomic<u32> s_ready_count;
+
+struct ThreadContext {
+    Benchmark* benchmark { nullptr };
+    int thread_index { 0 };
+    u64 iterations { 0 };
+    bool failed { false };
+};
+
+static void* benchmark_thread(void* argument)
+{
+    auto& context = *static_cast<ThreadContext*>(argument);
+    auto& benchmark = *context.benchmark;
+    context.failed = !benchmark.set_up(context.thread_index);
+    s_ready_count++;
+    while (!s_start)
+        sched_yield();
+
+    while (!context.failed && !s_stop) {
+        if (!benchmark.run(context.thread_index)) {
+            perror(benchmark.name.to_string().characters());
+            context.failed = true;
+        }
+        ++context.iterations;
+    }
+    return nullptr;
+}
+
+// Returns the number of iterations per second, or -1 if any thread failed.
+static double run_benchmark(Benchmark& benchmark, int thread_count, int duration_ms)
+{
+    s_start = false;
+    s_stop = false;
+    s_ready_count = 0;
+
+    Vector<ThreadContext> contexts;
+    contexts.resize(thread_count);
+    Vector<pthread_t> threads;
+    threads.resize(thread_count);
+    for (int i = 0; i < thread_count; ++i) {
+        contexts[i].benchmark = &benchmark;
+        contexts[i].thread_index = i;
+        if (int rc = pthread_create(&threads[i], nullptr, benchmark_thread, &contexts[i]); rc != 0) {
+            fprintf(stderr, "pthread_create: %s\n", strerror(rc));
+            exit(1);
+        }
+    }
+    while (s_ready_count != static_cast<u32>(thread_count))
+        sched_yield();
+
+    auto timer = Core::ElapsedTimer::start_new();
+    s_start = true;
+    usleep(duration_ms * 1000);
+    s_stop = true;
+    for (auto thread : threads)
+        pthread_join(thread, nullptr);
+    auto elapsed_ms = timer.elapsed();
+
+    u64 total_iterations = 0;
+    for (auto& context : contexts) {
+        if (context.failed)
+            return -1;
+        total_iterations += context.iterations;
+    }
+    return total_iterations * 1000.0 / elapsed_ms;
+}
+
+static bool open_once(int* fds, int thread_index, char const* path, int flags)
+{
+    if (fds[thread_index] > 0)
+        return true;
+    fds[thread_index] = open(path, flags);
+    return fds[thread_index] >= 0;
+}
+
+int main(int argc, char** argv)
+{
+    int thread_limit = 4;
+    int duration_ms = 1000;
+    char const* only_syscall = nullptr;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Measure how the throughput of common syscalls scales with the number of threads.");
+    args_parser.add_option(thread_limit, "Highest number of threads to try (doubling from 1)", "threads", 't', "count");
+    args_parser.add_option(duration_ms, "How long to run each measurement for", "duration", 'd', "milliseconds");
+    args_parser.add_option(only_syscall, "Only measure this syscall", "syscall", 's', "name");
+    args_parser.parse(argc, argv);
+
+    if (thread_limit < 1 || thread_limit > max_threads) {
+        warnln("Thread count must be between 1 and {}", max_threads);
+        return 1;
+    }
+
+    Vector<Benchmark> benchmarks;
+    benchmarks.append({ "read", [](int i) { return open_once(s_zero_fds, i, "/dev/zero", O_RDONLY); },
+        [](int i) {
+            char buffer[64];
+            return read(s_zero_fds[i], buffer, sizeof(buffer)) == static_cast<ssize_t>(sizeof(buffer));
+        } });
+    benchmarks.append({ "write", [](int i) { return open_once(s_null_fds, i, "/dev/null", O_WRONLY); },
+        [](int i) {
+            char buffer[64] {};
+            return write(s_null_fds[i], buffer, sizeof(buffer)) == static_cast<ssize_t>(sizeof(buffer));
+        } });
+    benchmarks.append({ "lseek", [](int i) { return open_once(s_zero_fds, i, "/dev/zero", O_RDONLY); },
+        [](int i) { return lseek(s_zero_fds[i], 0, SEEK_SET) == 0; } });
+    benchmarks.append({ "fstat", [](int i) { return open_once(s_zero_fds, i, "/dev/zero", O_RDONLY); },
+        [](int i) {
+            struct stat st;
+            return fstat(s_zero_fds[i], &st) == 0;
+        } });
+    benchmarks.append({ "futex", [](int) { return true; },
+        [](int i) { return futex_wake(&s_futex_words[i], 1) >= 0; } });
+    benchmarks.append({ "mmap", [](int) { return true; },
+        [](int) {
+            auto* memory = mmap(nullptr, PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+            if (memory == MAP_FAILED)
+                return false;
+            return munmap(memory, PAGE_SIZE) == 0;
+        } });
+    benchmarks.append({ "sendmsg+recvmsg", [](int i) {
+                           if (s_socket_fds[i][0] > 0)
+                               return true;
+                           return socketpair(AF_LOCAL, SOCK_STREAM, 0, s_socket_fds[i]) == 0;
+                       },
+        [](int i) {
+            char buffer[64] {};
+            iovec iov { buffer, sizeof(buffer) };
+            msghdr message {};
+            message.msg_iov = &iov;
+            message.msg_iovlen = 1;
+            if (sendmsg(s_socket_fds[i][0], &message, 0) != static_cast<ssize_t>(sizeof(buffer)))
+                return false;
+            return recvmsg(s_socket_fds[i][1], &message, 0) == static_cast<ssize_t>(sizeof(buffer));
+        } });
+
+    outln("{:>16} {:>8} {:>14} {:>8}", "syscall", "threads", "calls/s", "speedup");
+    for (auto& benchmark : benchmarks) {
+        if (only_syscall && benchmark.name != only_syscall)
+            continue;
+
+        double single_thread_rate = 0;
+        for (int thread_count = 1; thread_count <= thread_limit; thread_count *= 2) {
+            auto rate = run_benchmark(benchmark, thread_count, duration_ms);
+            if (rate < 0)
+                return 1;
+            if (thread_count == 1)
+                single_thread_rate = rate;
+            outln("{:>16} {:>8} {:>14.0} {:>7.2}x", benchmark.name, thread_count, rate, rate / single_thread_rate);
+        }
+    }
+    return 0;
+}
@@ -10,9 +10,11 @@
 #include <LibCore/File.h>
 #include <LibTest/TestCase.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/mman.h>
+#include <sys/sendfile.h>
 #include <sys/stat.h>
 #include <sys/uio.h>
 #include <unistd.h>
@@ -371,6 +373,165 @@ TEST_CASE(writev)
     close(pipefds[1]);
 }
 
+TEST_CASE(pread_pwrite)
+{
+    char path[] = "/tmp/pread_pwrite.XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    unlink(path);
+
+    EXPECT_EQ(write(fd, "HelloFriends", 12), 12);
+    EXPECT_EQ(pwrite(fd, "World", 5, 3), 5);
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), 12);
+
+    char buffer[32] {};
+    EXPECT_EQ(pread(fd, buffer, 8, 2), 8);
+    EXPECT_EQ(StringView(buffer, 8), "lWorlden"sv);
+    EXPECT_EQ(pread(fd, buffer, sizeof(buffer), 12), 0);
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), 12);
+
+    EXPECT_EQ(pread(fd, buffer, sizeof(buffer), -1), -1);
+    EXPECT_EQ(errno, EINVAL);
+    close(fd);
+}
+
+TEST_CASE(preadv_pwritev)
+{
+    char path[] = "/tmp/preadv_pwritev.XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    unlink(path);
+
+    iovec iov[2];
+    iov[0].iov_base = const_cast<void*>((const void*)"Hello");
+    iov[0].iov_len = 5;
+    iov[1].iov_base = const_cast<void*>((const void*)"Friends");
+    iov[1].iov_len = 7;
+    EXPECT_EQ(pwritev(fd, iov, 2, 4), 12);
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), 0);
+
+    char first[3] {};
+    char second[32] {};
+    iov[0] = { first, sizeof(first) };
+    iov[1] = { second, sizeof(second) };
+    EXPECT_EQ(preadv(fd, iov, 2, 5), 11);
+    EXPECT_EQ(StringView(first, 3), "ell"sv);
+    EXPECT_EQ(StringView(second, 8), "oFriends"sv);
+    close(fd);
+}
+
+TEST_CASE(pread_from_pipe)
+{
+    int pipefds[2];
+    EXPECT_EQ(pipe(pipefds), 0);
+    char buffer[4];
+    EXPECT_EQ(pread(pipefds[0], buffer, sizeof(buffer), 0), -1);
+    EXPECT_EQ(errno, ESPIPE);
+    close(pipefds[0]);
+    close(pipefds[1]);
+}
+
+TEST_CASE(copy_file_range)
+{
+    char source_path[] = "/tmp/copy_file_range_source.XXXXXX";
+    char destination_path[] = "/tmp/copy_file_range_destination.XXXXXX";
+    int source_fd = mkstemp(source_path);
+    int destination_fd = mkstemp(destination_path);
+    EXPECT(source_fd >= 0);
+    EXPECT(destination_fd >= 0);
+    unlink(source_path);
+    unlink(destination_path);
+
+    EXPECT_EQ(write(source_fd, "HelloFriends", 12), 12);
+    EXPECT_EQ(lseek(source_fd, 5, SEEK_SET), 5);
+    EXPECT_EQ(copy_file_range(source_fd, nullptr, destination_fd, nullptr, 100, 0), 7);
+    EXPECT_EQ(lseek(source_fd, 0, SEEK_CUR), 12);
+    EXPECT_EQ(lseek(destination_fd, 0, SEEK_CUR), 7);
+
+    off_t source_offset = 0;
+    off_t destination_offset = 7;
+    EXPECT_EQ(copy_file_range(source_fd, &source_offset, destination_fd, &destination_offset, 5, 0), 5);
+    EXPECT_EQ(source_offset, 5);
+    EXPECT_EQ(destination_offset, 12);
+    EXPECT_EQ(lseek(destination_fd, 0, SEEK_CUR), 7);
+
+    char buffer[32] {};
+    EXPECT_EQ(pread(destination_fd, buffer, sizeof(buffer), 0), 12);
+    EXPECT_EQ(StringView(buffer, 12), "FriendsHello"sv);
+
+    close(source_fd);
+    close(destination_fd);
+}
+
+TEST_CASE(sendfile_to_pipe)
+{
+    char path[] = "/tmp/sendfile.XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    unlink(path);
+    EXPECT_EQ(write(fd, "HelloFriends", 12), 12);
+
+    int pipefds[2];
+    EXPECT_EQ(pipe(pipefds), 0);
+    off_t offset = 5;
+    EXPECT_EQ(sendfile(pipefds[1], fd, &offset, 100), 7);
+    EXPECT_EQ(offset, 12);
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), 12);
+
+    char buffer[32] {};
+    EXPECT_EQ(read(pipefds[0], buffer, sizeof(buffer)), 7);
+    EXPECT_EQ(StringView(buffer, 7), "Friends"sv);
+
+    // Only files can be sent from.
+    EXPECT_EQ(sendfile(pipefds[1], pipefds[0], nullptr, 1), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    close(pipefds[0]);
+    close(pipefds[1]);
+    close(fd);
+}
+
+static void scan_mapped_file(bool advise_sequential)
+{
+    char path[] = "/tmp/mmap_sequential_scan.XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    unlink(path);
+
+    // Make the file end in the middle of a page, so reading ahead has to stop at the end of the file.
+    constexpr size_t file_size = 40 * PAGE_SIZE + 123;
+    static u8 contents[file_size];
+    for (size_t i = 0; i < file_size; ++i)
+        contents[i] = i % 251;
+    EXPECT_EQ(write(fd, contents, file_size), static_cast<ssize_t>(file_size));
+
+    auto* data = (u8*)mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    EXPECT_NE(data, MAP_FAILED);
+    if (advise_sequential)
+        EXPECT_EQ(madvise(data, file_size, MADV_SEQUENTIAL | MADV_WILLNEED), 0);
+
+    bool matches = true;
+    for (size_t i = 0; i < file_size; ++i)
+        matches &= data[i] == i % 251;
+    EXPECT(matches);
+    for (size_t i = file_size; i < 41 * PAGE_SIZE; ++i)
+        matches &= data[i] == 0;
+    EXPECT(matches);
+
+    munmap(data, file_size);
+    close(fd);
+}
+
+TEST_CASE(mmap_sequential_scan)
+{
+    scan_mapped_file(false);
+}
+
+TEST_CASE(mmap_sequential_scan_with_madvise)
+{
+    scan_mapped_file(true);
+}
+
 TEST_CASE(rmdir_root)
 {
     int rc = rmdir("/");
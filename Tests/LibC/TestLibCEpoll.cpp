@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+static int add_watch(int epoll_fd, int fd, u32 events)
+{
+    epoll_event event {};
+    event.events = events;
+    event.data.fd = fd;
+    return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+}
+
+TEST_CASE(epoll_level_triggered)
+{
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    EXPECT_NE(epoll_fd, -1);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+    EXPECT_EQ(add_watch(epoll_fd, pipe_fds[0], EPOLLIN), 0);
+
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT_EQ(events[0].data.fd, pipe_fds[0]);
+    EXPECT(events[0].events & EPOLLIN);
+
+    // Still readable, so it is reported again.
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+
+    char byte;
+    EXPECT_EQ(read(pipe_fds[0], &byte, 1), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(epoll_edge_triggered)
+{
+    int epoll_fd = epoll_create1(0);
+    EXPECT_NE(epoll_fd, -1);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+    EXPECT_EQ(add_watch(epoll_fd, pipe_fds[0], EPOLLIN | EPOLLET), 0);
+
+    epoll_event events[4];
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    EXPECT_EQ(write(pipe_fds[1], "y", 1), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT_EQ(events[0].data.fd, pipe_fds[0]);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(epoll_oneshot)
+{
+    int epoll_fd = epoll_create1(0);
+    EXPECT_NE(epoll_fd, -1);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+    EXPECT_EQ(add_watch(epoll_fd, pipe_fds[1], EPOLLOUT | EPOLLONESHOT), 0);
+
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT(events[0].events & EPOLLOUT);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    epoll_event event {};
+    event.events = EPOLLOUT | EPOLLONESHOT;
+    event.data.fd = pipe_fds[1];
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_MOD, pipe_fds[1], &event), 0);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(epoll_wait_times_out)
+{
+    int epoll_fd = epoll_create1(0);
+    EXPECT_NE(epoll_fd, -1);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+    EXPECT_EQ(add_watch(epoll_fd, pipe_fds[0], EPOLLIN), 0);
+
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 50), 0);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(epoll_wait_deadline_survives_wakeups)
+{
+    int epoll_fd = epoll_create1(0);
+    EXPECT_NE(epoll_fd, -1);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+    // Pipes never have priority data, so every change to the pipe wakes the waiter without producing an event.
+    EXPECT_EQ(add_watch(epoll_fd, pipe_fds[0], EPOLLPRI), 0);
+
+    pid_t child = fork();
+    EXPECT_NE(child, -1);
+    if (child == 0) {
+        for (int i = 0; i < 300; ++i) {
+            char byte = 'x';
+            (void)write(pipe_fds[1], &byte, 1);
+            (void)read(pipe_fds[0], &byte, 1);
+            usleep(10000);
+        }
+        _exit(0);
+    }
+
+    timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 200), 0);
+    timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    // The child keeps waking us up for about three seconds. Each wakeup must not push the deadline back.
+    auto elapsed_ms = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000;
+    EXPECT(elapsed_ms >= 190);
+    EXPECT(elapsed_ms < 1000);
+
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(epoll_ctl_errors)
+{
+    int epoll_fd = epoll_create1(0);
+    EXPECT_NE(epoll_fd, -1);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    epoll_event event {};
+    event.events = EPOLLIN;
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_MOD, pipe_fds[0], &event), -1);
+    EXPECT_EQ(errno, ENOENT);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_DEL, pipe_fds[0], &event), -1);
+    EXPECT_EQ(errno, ENOENT);
+
+    EXPECT_EQ(add_watch(epoll_fd, pipe_fds[0], EPOLLIN), 0);
+    EXPECT_EQ(add_watch(epoll_fd, pipe_fds[0], EPOLLIN), -1);
+    EXPECT_EQ(errno, EEXIST);
+
+    EXPECT_EQ(add_watch(epoll_fd, epoll_fd, EPOLLIN), -1);
+    EXPECT_EQ(errno, EINVAL);
+    EXPECT_EQ(add_watch(pipe_fds[0], pipe_fds[1], EPOLLOUT), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_DEL, pipe_fds[0], &event), 0);
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(epoll_forgets_closed_descriptions)
+{
+    int epoll_fd = epoll_create1(0);
+    EXPECT_NE(epoll_fd, -1);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+    EXPECT_EQ(add_watch(epoll_fd, pipe_fds[0], EPOLLIN), 0);
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+
+    close(pipe_fds[0]);
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(epoll_watches_descriptions_not_fds)
+{
+    int epoll_fd = epoll_create1(0);
+    EXPECT_NE(epoll_fd, -1);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+    int duplicate_fd = dup(pipe_fds[0]);
+    EXPECT_NE(duplicate_fd, -1);
+    EXPECT_EQ(add_watch(epoll_fd, pipe_fds[0], EPOLLIN), 0);
+
+    // The description is still open through the duplicate, so it is still watched.
+    close(pipe_fds[0]);
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT_EQ(events[0].data.fd, pipe_fds[0]);
+
+    close(duplicate_fd);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    // The fd number can be watched again once it refers to another description.
+    int other_pipe_fds[2];
+    EXPECT_EQ(pipe(other_pipe_fds), 0);
+    EXPECT_EQ(dup2(other_pipe_fds[0], pipe_fds[0]), pipe_fds[0]);
+    EXPECT_EQ(add_watch(epoll_fd, pipe_fds[0], EPOLLIN), 0);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(other_pipe_fds[0]);
+    close(other_pipe_fds[1]);
+    close(epoll_fd);
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/Timer.h>
+#include <LibTest/TestCase.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+TEST_CASE(notifier_on_regular_file_is_always_ready)
+{
+    char path[] = "/tmp/notifier_on_regular_file.XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    unlink(path);
+
+    Core::EventLoop event_loop;
+    auto reaper = Core::Timer::create_single_shot(250, [] {
+        warnln("I waited for the notifier on a regular file to fire, but it never did!");
+        VERIFY_NOT_REACHED();
+    });
+    reaper->start();
+
+    auto notifier = Core::Notifier::construct(fd, Core::Notifier::Read);
+    notifier->on_ready_to_read = [&] {
+        notifier->set_enabled(false);
+        event_loop.quit(0);
+    };
+
+    event_loop.exec();
+    close(fd);
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/Runtime/GlobalObject.h>
+
+using DispatchMode = JS::Bytecode::Interpreter::DispatchMode;
+
+static constexpr StringView arithmetic_loop = R"~~~(
+    var sum = 0;
+    for (var i = 0; i < 250000; ++i)
+        sum = (sum + i * 3 - (i >> 1)) % 1000003;
+    sum;
+)~~~";
+
+static constexpr StringView function_calls = R"~~~(
+    function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }
+    fib(20);
+)~~~";
+
+static constexpr StringView property_access = R"~~~(
+    var point = { x: 1, y: 2 };
+    for (var i = 0; i < 100000; ++i) {
+        point.x = point.y + 1;
+        point.y = point.x - 1;
+    }
+    point.x + point.y;
+)~~~";
+
+static constexpr StringView array_access = R"~~~(
+    var array = [];
+    for (var i = 0; i < 1000; ++i)
+        array[i] = i;
+    var total = 0;
+    for (var j = 0; j < 50; ++j) {
+        for (var i = 0; i < array.length; ++i)
+            total = total + array[i];
+    }
+    total;
+)~~~";
+
+static JS::Value run_program(StringView source, DispatchMode dispatch_mode)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+
+    auto parser = JS::Parser(JS::Lexer(source));
+    auto program = parser.parse_program();
+    VERIFY(!parser.has_errors());
+
+    auto executable = JS::Bytecode::Generator::generate(*program);
+    JS::Bytecode::Interpreter::optimization_pipeline().perform(executable);
+
+    JS::Bytecode::Interpreter bytecode_interpreter(interpreter->global_object(), interpreter->realm());
+    bytecode_interpreter.set_dispatch_mode(dispatch_mode);
+    bytecode_interpreter.run(executable);
+    VERIFY(!vm->exception());
+
+    return vm->last_value();
+}
+
+TEST_CASE(dispatch_modes_agree)
+{
+    for (auto source : { arithmetic_loop, function_calls, property_access, array_access }) {
+        auto switch_result = run_program(source, DispatchMode::Switch);
+        auto threaded_result = run_program(source, DispatchMode::Threaded);
+        EXPECT(switch_result.is_number());
+        EXPECT_EQ(switch_result.as_double(), threaded_result.as_double());
+    }
+}
+
+BENCHMARK_CASE(arithmetic_loop_switch)
+{
+    run_program(arithmetic_loop, DispatchMode::Switch);
+}
+
+BENCHMARK_CASE(arithmetic_loop_threaded)
+{
+    run_program(arithmetic_loop, DispatchMode::Threaded);
+}
+
+BENCHMARK_CASE(function_calls_switch)
+{
+    run_program(function_calls, DispatchMode::Switch);
+}
+
+BENCHMARK_CASE(function_calls_threaded)
+{
+    run_program(function_calls, DispatchMode::Threaded);
+}
+
+BENCHMARK_CASE(property_access_switch)
+{
+    run_program(property_access, DispatchMode::Switch);
+}
+
+BENCHMARK_CASE(property_access_threaded)
+{
+    run_program(property_access, DispatchMode::Threaded);
+}
+
+BENCHMARK_CASE(array_access_switch)
+{
+    run_program(array_access, DispatchMode::Switch);
+}
+
+BENCHMARK_CASE(array_access_threaded)
+{
+    run_program(array_access, DispatchMode::Threaded);
+}
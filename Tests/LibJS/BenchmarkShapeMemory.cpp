@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/String.h>
+#include <LibJS/Heap/DeferGC.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/Shape.h>
+
+static constexpr size_t chain_length = 100;
+
+enum class LookupOrder {
+    OldestShapeFirst,
+    NewestShapeFirst,
+};
+
+// Builds a chain of put transitions (as `o.p0 = ...; o.p1 = ...;` does), then looks up a property
+// in every shape along it. Returns the number of bytes their property tables take up.
+static size_t build_chain_and_look_up_properties(LookupOrder order)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+    JS::DeferGC defer_gc(vm->heap());
+
+    Vector<JS::StringOrSymbol> property_names;
+    for (size_t i = 0; i < chain_length; ++i)
+        property_names.append(String::formatted("p{}", i));
+
+    Vector<JS::Shape*> shapes;
+    auto* shape = interpreter->global_object().new_object_shape();
+    for (auto& property_name : property_names) {
+        shape = shape->create_put_transition(property_name, JS::default_attributes);
+        shapes.append(shape);
+    }
+    if (order == LookupOrder::NewestShapeFirst)
+        shapes.reverse();
+
+    for (auto* shape : shapes)
+        VERIFY(shape->lookup(property_names.first()).has_value());
+
+    size_t property_table_bytes = 0;
+    for (auto* shape : shapes)
+        property_table_bytes += shape->property_table_memory_usage();
+    return property_table_bytes;
+}
+
+TEST_CASE(property_table_bytes_per_shape)
+{
+    for (auto order : { LookupOrder::OldestShapeFirst, LookupOrder::NewestShapeFirst }) {
+        auto bytes_per_shape = build_chain_and_look_up_properties(order) / chain_length;
+        outln("{} property table bytes per shape", bytes_per_shape);
+
+        // All the shapes along the chain should share one table, rather than each having a copy of its own.
+        EXPECT(bytes_per_shape < 128);
+    }
+}
+
+BENCHMARK_CASE(look_up_properties_along_transition_chain)
+{
+    for (size_t i = 0; i < 100; ++i)
+        build_chain_and_look_up_properties(LookupOrder::OldestShapeFirst);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Vector.h>
+#include <LibJS/Heap/DeferGC.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Value.h>
+
+static constexpr size_t value_count = 1024 * 1024;
+
+static constexpr StringView number_array_loop = R"~~~(
+    var values = [];
+    for (var i = 0; i < 100000; ++i)
+        values.push(i % 2 ? i * 0.5 : i);
+    var total = 0;
+    for (var j = 0; j < 5; ++j) {
+        for (var i = 0; i < values.length; ++i)
+            total += values[i];
+    }
+    total;
+)~~~";
+
+// Fills a vector with a mix of int32s, doubles and objects, roughly in the proportions an array-heavy script would have.
+static Vector<JS::Value> make_values(JS::Object& object)
+{
+    Vector<JS::Value> values;
+    values.ensure_capacity(value_count);
+    for (size_t i = 0; i < value_count; ++i) {
+        switch (i % 4) {
+        case 0:
+        case 1:
+            values.unchecked_append(JS::Value(static_cast<i32>(i)));
+            break;
+        case 2:
+            values.unchecked_append(JS::Value(static_cast<double>(i) + 0.5));
+            break;
+        default:
+            values.unchecked_append(JS::Value(&object));
+            break;
+        }
+    }
+    return values;
+}
+
+static double sum_numbers(Vector<JS::Value> const& values, JS::Object const& object)
+{
+    double total = 0;
+    for (auto& value : values) {
+        if (value.is_number())
+            total += value.as_double();
+        else if (value.is_object() && &value.as_object() == &object)
+            total += 1;
+    }
+    return total;
+}
+
+TEST_CASE(value_is_one_word)
+{
+    EXPECT_EQ(sizeof(JS::Value), sizeof(u64));
+}
+
+BENCHMARK_CASE(copy_and_scan_values)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+    JS::DeferGC defer_gc(vm->heap());
+    auto* object = JS::Object::create(interpreter->global_object(), nullptr);
+
+    auto values = make_values(*object);
+    for (size_t i = 0; i < 20; ++i) {
+        auto copy = values;
+        VERIFY(sum_numbers(copy, *object) != 0);
+    }
+}
+
+BENCHMARK_CASE(number_array_loop)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+
+    auto parser = JS::Parser(JS::Lexer(number_array_loop));
+    auto program = parser.parse_program();
+    VERIFY(!parser.has_errors());
+
+    interpreter->run(interpreter->global_object(), *program);
+    VERIFY(!vm->exception());
+    VERIFY(vm->last_value().is_number());
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/String.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/Runtime/GlobalObject.h>
+
+// Every statement needs a few temporaries, but none of them outlive it.
+static constexpr StringView independent_temporaries = R"~~~(
+    var a = (1 + 2) * (3 + 4);
+    var b = (5 - 6) * (7 - 8);
+    var c = (a + b) * (a - b);
+    var d = [a, b, c].length + (c % 7);
+    var e = (d * 2 + a * 3) - (b * 4 + c * 5);
+    a + ":" + b + ":" + c + ":" + d + ":" + e;
+)~~~";
+
+static constexpr StringView loops_and_calls = R"~~~(
+    function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }
+    var total = 0;
+    for (var i = 0; i < 20; ++i) {
+        var x = i * 2;
+        var y = x + fib(i % 10);
+        total = (total + x * y) % 10007;
+    }
+    total;
+)~~~";
+
+static constexpr StringView exceptions = R"~~~(
+    var log = [];
+    for (var i = 0; i < 4; ++i) {
+        var before = i * 10;
+        try {
+            if (i % 2)
+                throw i + 100;
+            log.push(before + 1);
+        } catch (e) {
+            log.push(before + 5);
+        } finally {
+            log.push(before + 2);
+        }
+    }
+    log.join(",");
+)~~~";
+
+struct RunResult {
+    String value;
+    size_t number_of_registers { 0 };
+};
+
+static RunResult run_program(StringView source, bool allocate_registers)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+
+    auto parser = JS::Parser(JS::Lexer(source));
+    auto program = parser.parse_program();
+    VERIFY(!parser.has_errors());
+
+    auto executable = JS::Bytecode::Generator::generate(*program);
+
+    // The default pipeline, optionally without its last pass.
+    JS::Bytecode::PassManager passes;
+    passes.add<JS::Bytecode::Passes::GenerateCFG>();
+    passes.add<JS::Bytecode::Passes::UnifySameBlocks>();
+    passes.add<JS::Bytecode::Passes::GenerateCFG>();
+    passes.add<JS::Bytecode::Passes::MergeBlocks>();
+    passes.add<JS::Bytecode::Passes::GenerateCFG>();
+    passes.add<JS::Bytecode::Passes::PlaceBlocks>();
+    if (allocate_registers) {
+        passes.add<JS::Bytecode::Passes::GenerateCFG>();
+        passes.add<JS::Bytecode::Passes::AllocateRegisters>();
+    }
+    passes.perform(executable);
+
+    JS::Bytecode::Interpreter bytecode_interpreter(interpreter->global_object(), interpreter->realm());
+    bytecode_interpreter.run(executable);
+    VERIFY(!vm->exception());
+
+    return { vm->last_value().to_string_without_side_effects(), executable.number_of_registers };
+}
+
+TEST_CASE(results_do_not_change)
+{
+    for (auto source : { independent_temporaries, loops_and_calls, exceptions }) {
+        auto without_allocation = run_program(source, false);
+        auto with_allocation = run_program(source, true);
+        EXPECT_EQ(with_allocation.value, without_allocation.value);
+        EXPECT(with_allocation.number_of_registers <= without_allocation.number_of_registers);
+    }
+
+    EXPECT_EQ(run_program(independent_temporaries, true).value, "21:1:440:9:-2123");
+    EXPECT_EQ(run_program(exceptions, true).value, "1,2,15,12,21,22,35,32");
+}
+
+TEST_CASE(non_overlapping_temporaries_share_registers)
+{
+    auto without_allocation = run_program(independent_temporaries, false);
+    auto with_allocation = run_program(independent_temporaries, true);
+
+    // Each statement's temporaries die before the next statement starts, so the registers needed
+    // shouldn't grow with the number of statements.
+    EXPECT(with_allocation.number_of_registers < without_allocation.number_of_registers);
+    EXPECT(with_allocation.number_of_registers * 3 < without_allocation.number_of_registers);
+}
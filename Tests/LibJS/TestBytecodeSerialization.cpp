@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Bytecode/Serialization.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/Runtime/GlobalObject.h>
+
+static constexpr StringView program_source = R"~~~(
+    var values = [];
+    for (var i = 0; i < 10; ++i) {
+        if (i % 2 == 0)
+            values[values.length] = i * 1.5;
+        else
+            values[values.length] = "odd";
+    }
+    var object = { name: "serialized", count: values.length };
+    object.big = 12345678901234567890n;
+    let scoped = object.count + 1;
+    while (scoped > 0)
+        scoped = scoped - 4;
+    `${object.name}:${object.count}:${object.big + 1n}:${values[2]}:${values[3]}:${scoped}:${/a+/.test("aa")}:${typeof undefined}`;
+)~~~";
+
+static constexpr StringView functions_source = R"~~~(
+    function make_counter(step) {
+        var count = 0;
+        return () => {
+            count += step;
+            return count;
+        };
+    }
+    function* numbers() {
+        yield 1;
+        yield 2;
+    }
+    var counter = make_counter(3);
+    counter();
+    var generator = numbers();
+    var sum = generator.next().value + generator.next().value;
+    `${counter()}:${sum}:${(function (x) { return x * 2; })(21)}`;
+)~~~";
+
+struct Generated {
+    NonnullRefPtr<JS::Program> program;
+    JS::Bytecode::Executable executable;
+};
+
+static Generated generate(StringView source, bool optimize)
+{
+    auto parser = JS::Parser(JS::Lexer(source));
+    auto program = parser.parse_program();
+    VERIFY(!parser.has_errors());
+
+    auto executable = JS::Bytecode::Generator::generate(*program);
+    if (optimize)
+        JS::Bytecode::Interpreter::optimization_pipeline().perform(executable);
+    return { move(program), move(executable) };
+}
+
+static String run(JS::Bytecode::Executable const& executable)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+    JS::Bytecode::Interpreter bytecode_interpreter(interpreter->global_object(), interpreter->realm());
+    bytecode_interpreter.run(executable);
+    VERIFY(!vm->exception());
+    return vm->last_value().to_string_without_side_effects();
+}
+
+TEST_CASE(round_trip)
+{
+    for (auto optimize : { false, true }) {
+        auto generated = generate(program_source, optimize);
+        auto& executable = generated.executable;
+        auto serialized = JS::Bytecode::serialize_executable(executable, generated.program);
+        EXPECT(serialized.has_value());
+
+        auto deserialized = JS::Bytecode::deserialize_executable(*serialized, generated.program);
+        EXPECT(deserialized.has_value());
+        EXPECT_EQ(deserialized->basic_blocks.size(), executable.basic_blocks.size());
+        EXPECT_EQ(deserialized->number_of_registers, executable.number_of_registers);
+
+        auto expected = run(executable);
+        EXPECT_EQ(expected, "serialized:10:12345678901234567891:3:odd:-1:true:undefined");
+        EXPECT_EQ(run(*deserialized), expected);
+
+        // Serializing the deserialized executable again should produce the exact same bytes.
+        EXPECT(JS::Bytecode::serialize_executable(*deserialized, generated.program) == serialized);
+    }
+}
+
+TEST_CASE(functions_round_trip)
+{
+    auto generated = generate(functions_source, true);
+    auto serialized = JS::Bytecode::serialize_executable(generated.executable, generated.program);
+    EXPECT(serialized.has_value());
+
+    auto deserialized = JS::Bytecode::deserialize_executable(*serialized, generated.program);
+    EXPECT(deserialized.has_value());
+    // make_counter, numbers and the function expression; the arrow function is created by make_counter's body.
+    EXPECT_EQ(deserialized->function_executables.size(), 3u);
+
+    auto expected = run(generated.executable);
+    EXPECT_EQ(expected, "6:3:42");
+    EXPECT_EQ(run(*deserialized), expected);
+
+    EXPECT(JS::Bytecode::serialize_executable(*deserialized, generated.program) == serialized);
+
+    // Functions are referred to by their index in the program, so the data only fits the program it was made for.
+    auto other_program = generate("function f() {}"sv, true);
+    EXPECT(!JS::Bytecode::deserialize_executable(*serialized, other_program.program).has_value());
+}
+
+TEST_CASE(classes_are_not_serializable)
+{
+    auto generated = generate("class C {}"sv, false);
+    EXPECT(!JS::Bytecode::serialize_executable(generated.executable, generated.program).has_value());
+}
+
+TEST_CASE(malformed_data_is_rejected)
+{
+    auto generated = generate(program_source, false);
+    auto serialized = JS::Bytecode::serialize_executable(generated.executable, generated.program).release_value();
+
+    EXPECT(!JS::Bytecode::deserialize_executable({}, generated.program).has_value());
+
+    for (size_t length = 0; length < serialized.size(); length += 7)
+        EXPECT(!JS::Bytecode::deserialize_executable(serialized.bytes().trim(length), generated.program).has_value());
+
+    auto wrong_version = serialized;
+    wrong_version[4] ^= 0xff;
+    EXPECT(!JS::Bytecode::deserialize_executable(wrong_version, generated.program).has_value());
+
+    auto trailing_garbage = serialized;
+    trailing_garbage.append("?", 1);
+    EXPECT(!JS::Bytecode::deserialize_executable(trailing_garbage, generated.program).has_value());
+}
+
+TEST_CASE(out_of_range_operands_are_rejected)
+{
+    auto expect_rejected = [](auto&& change_executable) {
+        auto generated = generate(program_source, false);
+        change_executable(generated.executable);
+        auto serialized = JS::Bytecode::serialize_executable(generated.executable, generated.program);
+        EXPECT(serialized.has_value());
+        EXPECT(!JS::Bytecode::deserialize_executable(*serialized, generated.program).has_value());
+    };
+
+    // Registers that the instructions use, but that wouldn't be allocated.
+    expect_rejected([](auto& executable) { executable.number_of_registers = JS::Bytecode::Register::global_object_index + 1; });
+    // Strings that the instructions refer to, but that aren't in the string table.
+    expect_rejected([](auto& executable) { executable.string_table = make<JS::Bytecode::StringTable>(); });
+    // Register counts that could never be reasonable.
+    expect_rejected([](auto& executable) { executable.number_of_registers = 0; });
+    expect_rejected([](auto& executable) { executable.number_of_registers = NumericLimits<u32>::max(); });
+}
+
+// Returns the offset of the first occurrence of the given fields, laid out the way the encoder writes them.
+template<typename... Fields>
+static Optional<size_t> find_encoded(ByteBuffer const& data, Fields... fields)
+{
+    ByteBuffer pattern;
+    (pattern.append(&fields, sizeof(fields)), ...);
+    for (size_t offset = 0; offset + pattern.size() <= data.size(); ++offset) {
+        if (data.bytes().slice(offset, pattern.size()) == pattern.bytes())
+            return offset;
+    }
+    return {};
+}
+
+TEST_CASE(oversized_register_lists_are_rejected)
+{
+    auto generated = generate("[1.5, 2.5];"sv, false);
+    auto serialized = JS::Bytecode::serialize_executable(generated.executable, generated.program).release_value();
+    EXPECT(JS::Bytecode::deserialize_executable(serialized, generated.program).has_value());
+
+    auto offset = find_encoded(serialized, static_cast<u32>(JS::Bytecode::Instruction::Type::NewArray), static_cast<u64>(2));
+    EXPECT(offset.has_value());
+
+    // Multiplied by the size of a register, this count wraps around to a single register.
+    auto wrapping_count = serialized;
+    u64 count = (1ull << 62) + 1;
+    wrapping_count.overwrite(*offset + sizeof(u32), &count, sizeof(count));
+    EXPECT(!JS::Bytecode::deserialize_executable(wrapping_count, generated.program).has_value());
+}
+
+TEST_CASE(values_of_unknown_types_are_rejected)
+{
+    auto generated = generate("1.5;"sv, false);
+    auto serialized = JS::Bytecode::serialize_executable(generated.executable, generated.program).release_value();
+    EXPECT(JS::Bytecode::deserialize_executable(serialized, generated.program).has_value());
+
+    auto offset = find_encoded(serialized, static_cast<u32>(JS::Value::Type::Double), bit_cast<u64>(1.5));
+    EXPECT(offset.has_value());
+
+    for (auto type : { JS::Value::Type::String, JS::Value::Type::Object, JS::Value::Type::BigInt, static_cast<JS::Value::Type>(1000) }) {
+        auto changed = serialized;
+        auto encoded_type = static_cast<u32>(type);
+        changed.overwrite(*offset, &encoded_type, sizeof(encoded_type));
+        EXPECT(!JS::Bytecode::deserialize_executable(changed, generated.program).has_value());
+    }
+}
@@ -910,3 +910,210 @@ TEST_CASE(optimizer_atomic_groups)
         EXPECT_EQ(result.success, test.get<2>());
     }
 }
+
+TEST_CASE(lazy_dfa_agrees_with_vm)
+{
+    struct Test {
+        StringView pattern;
+        StringView subject;
+        bool search;
+        bool matches;
+    };
+    Array tests {
+        Test { "a|ab"sv, "ab"sv, false, false }, // The VM only takes the first alternative that succeeds.
+        Test { "ab|a"sv, "ab"sv, false, true },
+        Test { "^abc$"sv, "abc"sv, true, true },
+        Test { "^abc$"sv, "xabc"sv, true, false },
+        Test { "b$"sv, "abc"sv, true, false },
+        Test { "$"sv, "abc"sv, true, false }, // An empty match is never attempted at the end of a non-empty input.
+        Test { "x*"sv, ""sv, false, true },
+        Test { "foo(bar)?baz"sv, "--foobaz--"sv, true, true },
+        Test { "fo{2,3}x"sv, "fooooox"sv, true, false },
+        Test { "fo{2,3}x"sv, "foooox"sv, false, false },
+        Test { "fo{2,3}x"sv, "fooox"sv, false, true },
+        Test { "[^a-c]+\\d"sv, "abc1"sv, true, false },
+        Test { "[^a-c]+\\d"sv, "xy12"sv, true, true },
+        Test { "a+b"sv, "x b a"sv, true, false }, // A loop that can't backtrack still has to match at least once.
+        Test { "x+\\d"sv, "x c1"sv, true, false },
+        Test { "(?:hello|world)!"sv, "say hello world!"sv, true, true },
+        Test { "\xe2\x82\xac[0-9]"sv, "cost: \xe2\x82\xac" "5"sv, true, true },
+    };
+
+    for (auto& test : tests) {
+        // Note: ECMAScript's Global flag makes the regex stateful, which the DFA doesn't handle; Multiline searches each line instead.
+        auto flags = test.search ? ECMAScriptFlags::Multiline : ECMAScriptFlags {};
+        Regex<ECMA262> re(test.pattern, flags);
+        EXPECT(regex::LazyDFA::try_create(re.parser_result.bytecode, {}));
+        EXPECT_EQ(re.match(test.subject).success, test.matches);
+        EXPECT_EQ(re.has_match(test.subject), test.matches);
+
+        Regex<ECMA262> insensitive_re(test.pattern, flags | ECMAScriptFlags::Insensitive);
+        auto uppercase_subject = test.subject.to_string().to_uppercase();
+        EXPECT_EQ(insensitive_re.has_match(uppercase_subject), insensitive_re.match(uppercase_subject).success);
+    }
+}
+
+TEST_CASE(lazy_dfa_is_not_used_for_patterns_that_look_around)
+{
+    Array patterns {
+        "(a)\\1"sv,
+        "a(?=b)"sv,
+        "(?<!a)b"sv,
+        "\\bword\\b"sv,
+    };
+    for (auto& pattern : patterns) {
+        Regex<ECMA262> re(pattern);
+        EXPECT_EQ(re.parser_result.error, Error::NoError);
+        EXPECT(!regex::LazyDFA::try_create(re.parser_result.bytecode, {}));
+    }
+}
+
+TEST_CASE(lazy_dfa_ignores_result_shaping_flags)
+{
+    // has_match() probes without SkipSubExprResults before match() runs with it, which must not make us rebuild the DFA.
+    regex::AllOptions probe_options = regex::AllFlags::Insensitive;
+    regex::AllOptions match_options = probe_options | regex::AllFlags::SkipSubExprResults | regex::AllFlags::StringCopyMatches;
+    EXPECT_EQ(regex::LazyDFA::matching_options(probe_options).value(), regex::LazyDFA::matching_options(match_options).value());
+    EXPECT_NE(regex::LazyDFA::matching_options(probe_options).value(), regex::LazyDFA::matching_options(regex::AllFlags::Multiline).value());
+}
+
+TEST_CASE(lazy_dfa_avoids_exponential_backtracking)
+{
+    // Without the DFA, the VM tries every way of splitting the input between the two alternatives.
+    auto subject = String::repeated('a', 100);
+    Regex<ECMA262> re("(?:a|aa)+b");
+    EXPECT(!re.match(subject).success);
+    EXPECT(!re.has_match(subject, ECMAScriptFlags::Multiline));
+    // When searching, a match found by the DFA is the answer, and the VM never gets to backtrack through the prefix.
+    EXPECT(re.has_match(String::formatted("{}cab", subject), ECMAScriptFlags::Multiline));
+
+    Regex<PosixExtended> posix_re("(a|aa)*c", PosixFlags::Global);
+    EXPECT(!posix_re.match(subject).success);
+    EXPECT(posix_re.match(String::formatted("{}c", subject)).success);
+}
+
+static auto g_lots_of_lines = [] {
+    StringBuilder builder;
+    for (size_t i = 0; i < 100'000; ++i)
+        builder.appendff("line {}: some text with foo{}ba and nothing else\n", i, i);
+    return builder.build();
+}();
+
+BENCHMARK_CASE(lazy_dfa_search_without_matches)
+{
+    Regex<PosixExtended> re("foo[0-9]+bar", PosixFlags::Multiline);
+    EXPECT(!re.has_match(g_lots_of_lines));
+    EXPECT(!re.match(g_lots_of_lines).success);
+}
+
+TEST_CASE(optimizer_literal_extraction)
+{
+    struct Test {
+        StringView pattern;
+        StringView literal_prefix;
+        StringView required_literal;
+    };
+    Array tests {
+        Test { "hello world"sv, "hello world"sv, "hello world"sv },
+        Test { "^(abc)d"sv, "abcd"sv, "abcd"sv },
+        Test { "a.c"sv, "a"sv, "a"sv },
+        Test { "foo[0-9]+barbaz"sv, "foo"sv, "barbaz"sv },
+        Test { "(?:abc)?def"sv, {}, "def"sv },
+        Test { "x(?:ab|cd)yz"sv, "x"sv, "yz"sv },
+        Test { "a|b"sv, {}, {} },
+        Test { "abc(?=d)"sv, {}, {} },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.pattern);
+        EXPECT_EQ(re.parser_result.error, Error::NoError);
+        EXPECT_EQ(re.parser_result.optimization_data.literal_prefix, test.literal_prefix);
+        EXPECT_EQ(re.parser_result.optimization_data.required_literal, test.required_literal);
+    }
+}
+
+TEST_CASE(literal_prefilter_finds_all_matches)
+{
+    Regex<PosixExtended> re("foo[0-9]+bar", PosixFlags::Global);
+    auto result = re.match("foo1ba foo12bar xfoofoo3bar foo");
+    EXPECT_EQ(result.count, 2u);
+    EXPECT_EQ(result.matches.at(0).view, "foo12bar");
+    EXPECT_EQ(result.matches.at(0).column, 7u);
+    EXPECT_EQ(result.matches.at(1).view, "foo3bar");
+    EXPECT_EQ(result.matches.at(1).column, 20u);
+
+    Regex<ECMA262> ecma_re("(?:abc)?def", ECMAScriptFlags::Multiline);
+    auto ecma_result = ecma_re.match("de\nzzabcdef\nxdef");
+    EXPECT_EQ(ecma_result.count, 2u);
+    EXPECT_EQ(ecma_result.matches.at(0).view, "abcdef");
+    EXPECT_EQ(ecma_result.matches.at(0).line, 1u);
+    EXPECT_EQ(ecma_result.matches.at(1).view, "def");
+    EXPECT_EQ(ecma_result.matches.at(1).line, 2u);
+
+    // The literals have to match case-insensitively, so they can't be searched for directly.
+    Regex<ECMA262> insensitive_re("foo[0-9]", ECMAScriptFlags::Multiline | ECMAScriptFlags::Insensitive);
+    EXPECT(insensitive_re.has_match("xFOO1"));
+}
+
+BENCHMARK_CASE(literal_prefilter_search_with_few_matches)
+{
+    // The input as a whole does match, so every position in it has to be tried.
+    Regex<PosixExtended> re("foo9999[0-9]ba", PosixFlags::Global);
+    auto result = re.match(g_lots_of_lines);
+    EXPECT_EQ(result.count, 10u);
+}
+
+TEST_CASE(regex_set_matches)
+{
+    RegexSet<PosixExtended> set({ "error: [a-z]+", "warn(ing)?:", "^[0-9]+ ", "x|y", "disk (full|failure)" });
+    EXPECT(!set.first_pattern_with_error().has_value());
+    EXPECT_EQ(set.size(), 5u);
+
+    // Without the Global flag, POSIX patterns have to match the whole input.
+    EXPECT_EQ(set.matches("y"), Vector<size_t>({ 3 }));
+    EXPECT_EQ(set.matches("xy"), Vector<size_t> {});
+
+    EXPECT_EQ(set.matches("12 error: disk full", PosixFlags::Global), Vector<size_t>({ 0, 2, 4 }));
+    EXPECT_EQ(set.matches("warning: nothing", PosixFlags::Global), Vector<size_t>({ 1 }));
+    EXPECT_EQ(set.matches("Error: 42", PosixFlags::Global), Vector<size_t> {});
+    EXPECT(set.has_match("disk failure", PosixFlags::Global));
+    EXPECT(!set.has_match("all good", PosixFlags::Global));
+
+    // Literals can't be used to rule out patterns when matching case-insensitively.
+    EXPECT_EQ(set.matches("12 ERROR: DISK FULL", PosixFlags::Global | PosixFlags::Insensitive), Vector<size_t>({ 0, 2, 4 }));
+
+    RegexSet<ECMA262> invalid_set({ "abc", "(def" });
+    EXPECT_EQ(invalid_set.first_pattern_with_error(), 1u);
+}
+
+TEST_CASE(aho_corasick_overlapping_literals)
+{
+    regex::Detail::AhoCorasick automaton;
+    Array literals { "he"sv, "she"sv, "his"sv, "hers"sv, "e"sv };
+    for (auto& literal : literals)
+        automaton.add_literal(literal);
+    automaton.build();
+
+    Vector<size_t> found;
+    automaton.find_all("ushers", [&](size_t literal) {
+        found.append(literal);
+        return IterationDecision::Continue;
+    });
+    // "she", "he" and "e" all end at the same position; longer literals are reported first.
+    EXPECT_EQ(found, Vector<size_t>({ 1, 0, 4, 3 }));
+}
+
+BENCHMARK_CASE(regex_set_with_many_rules)
+{
+    Vector<String> rules;
+    for (size_t i = 0; i < 200; ++i)
+        rules.append(String::formatted("rule{}: [a-z]+ foo[0-9]+ba", i));
+    RegexSet<PosixExtended> set(move(rules));
+
+    size_t match_count = 0;
+    for (auto& line : g_lots_of_lines.split_view('\n')) {
+        if (set.has_match(line, PosixFlags::Global))
+            ++match_count;
+    }
+    EXPECT_EQ(match_count, 0u);
+}
@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <LibTest/TestCase.h>
 #include <LibThreading/Thread.h>
+#include <sched.h>
 #include <unistd.h>
 
 TEST_CASE(threads_can_detach)
@@ -32,3 +34,37 @@ TEST_CASE(joining_detached_thread_errors)
 
     EXPECT(thread->join().is_error());
 }
+
+TEST_CASE(joining_thread_that_already_exited)
+{
+    int should_be_42 = 0;
+
+    auto thread = Threading::Thread::construct([&should_be_42]() {
+        should_be_42 = 42;
+        return 0;
+    },
+        "exits-early"sv);
+    thread->start();
+    while (!thread->has_exited())
+        sched_yield();
+
+    EXPECT(!thread->join().is_error());
+    EXPECT(should_be_42 == 42);
+}
+
+TEST_CASE(thread_reports_when_it_has_exited)
+{
+    Atomic<bool> may_exit { false };
+
+    auto thread = Threading::Thread::construct([&may_exit]() {
+        while (!may_exit)
+            sched_yield();
+        return 0;
+    });
+    thread->start();
+    EXPECT(!thread->has_exited());
+
+    may_exit = true;
+    EXPECT(!thread->join().is_error());
+    EXPECT(thread->has_exited());
+}
@@ -155,6 +155,10 @@ private:
     int virt$setgid(gid_t);
     u32 virt$read(int, FlatPtr, ssize_t);
     u32 virt$write(int, FlatPtr, ssize_t);
+    u32 virt$pread(FlatPtr);
+    u32 virt$pwrite(FlatPtr);
+    u32 virt$sendfile(FlatPtr);
+    u32 virt$copy_file_range(FlatPtr);
     u32 virt$mprotect(FlatPtr, size_t, int);
     u32 virt$madvise(FlatPtr, size_t, int);
     u32 virt$open(u32);
@@ -192,6 +196,9 @@ private:
     int virt$getsockname(FlatPtr);
     int virt$getpeername(FlatPtr);
     int virt$select(FlatPtr);
+    int virt$epoll_create(int);
+    int virt$epoll_ctl(FlatPtr);
+    int virt$epoll_wait(FlatPtr);
     int virt$get_stack_bounds(FlatPtr, FlatPtr);
     int virt$accept4(FlatPtr);
     int virt$bind(int sockfd, FlatPtr address, socklen_t address_length);
@@ -14,6 +14,7 @@
 #include <sched.h>
 #include <serenity.h>
 #include <strings.h>
+#include <sys/epoll.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/select.h>
@@ -129,6 +130,14 @@ u32 Emulator::virt_syscall(u32 function, u32 arg1, u32 arg2, u32 arg3)
         return virt$write(arg1, arg2, arg3);
     case SC_read:
         return virt$read(arg1, arg2, arg3);
+    case SC_pwrite:
+        return virt$pwrite(arg1);
+    case SC_pread:
+        return virt$pread(arg1);
+    case SC_sendfile:
+        return virt$sendfile(arg1);
+    case SC_copy_file_range:
+        return virt$copy_file_range(arg1);
     case SC_mprotect:
         return virt$mprotect(arg1, arg2, arg3);
     case SC_madvise:
@@ -187,6 +196,12 @@ u32 Emulator::virt_syscall(u32 function, u32 arg1, u32 arg2, u32 arg3)
         return virt$listen(arg1, arg2);
     case SC_select:
         return virt$select(arg1);
+    case SC_epoll_create:
+        return virt$epoll_create(arg1);
+    case SC_epoll_ctl:
+        return virt$epoll_ctl(arg1);
+    case SC_epoll_wait:
+        return virt$epoll_wait(arg1);
     case SC_recvmsg:
         return virt$recvmsg(arg1, arg2, arg3);
     case SC_sendmsg:
@@ -696,6 +711,51 @@ int Emulator::virt$select(FlatPtr params_addr)
     return rc;
 }
 
+int Emulator::virt$epoll_create(int flags)
+{
+    return syscall(SC_epoll_create, flags);
+}
+
+int Emulator::virt$epoll_ctl(FlatPtr params_addr)
+{
+    Syscall::SC_epoll_ctl_params params;
+    mmu().copy_from_vm(&params, params_addr, sizeof(params));
+
+    epoll_event event {};
+    if (params.event)
+        mmu().copy_from_vm(&event, (FlatPtr)params.event, sizeof(event));
+    params.event = params.event ? &event : nullptr;
+
+    return syscall(SC_epoll_ctl, &params);
+}
+
+int Emulator::virt$epoll_wait(FlatPtr params_addr)
+{
+    Syscall::SC_epoll_wait_params params;
+    mmu().copy_from_vm(&params, params_addr, sizeof(params));
+
+    if (params.maxevents <= 0)
+        return -EINVAL;
+
+    struct timespec timeout;
+    u32 sigmask;
+    if (params.timeout)
+        mmu().copy_from_vm(&timeout, (FlatPtr)params.timeout, sizeof(timeout));
+    if (params.sigmask)
+        mmu().copy_from_vm(&sigmask, (FlatPtr)params.sigmask, sizeof(sigmask));
+
+    Vector<epoll_event> events;
+    events.resize(params.maxevents);
+
+    Syscall::SC_epoll_wait_params host_params { params.epfd, events.data(), params.maxevents, params.timeout ? &timeout : nullptr, params.sigmask ? &sigmask : nullptr };
+    int rc = syscall(SC_epoll_wait, &host_params);
+    if (rc < 0)
+        return rc;
+
+    mmu().copy_to_vm((FlatPtr)params.events, events.data(), rc * sizeof(epoll_event));
+    return rc;
+}
+
 int Emulator::virt$getsockopt(FlatPtr params_addr)
 {
     Syscall::SC_getsockopt_params params;
@@ -1054,6 +1114,72 @@ u32 Emulator::virt$read(int fd, FlatPtr buffer, ssize_t size)
     return nread;
 }
 
+u32 Emulator::virt$pwrite(FlatPtr params_addr)
+{
+    Syscall::SC_pwrite_params params;
+    mmu().copy_from_vm(&params, params_addr, sizeof(params));
+    if (static_cast<ssize_t>(params.size) < 0)
+        return -EINVAL;
+    auto buffer = mmu().copy_buffer_from_vm((FlatPtr)params.data, params.size);
+    Syscall::SC_pwrite_params host_params { params.fd, buffer.data(), buffer.size(), params.offset };
+    return syscall(SC_pwrite, &host_params);
+}
+
+u32 Emulator::virt$pread(FlatPtr params_addr)
+{
+    Syscall::SC_pread_params params;
+    mmu().copy_from_vm(&params, params_addr, sizeof(params));
+    if (static_cast<ssize_t>(params.size) < 0)
+        return -EINVAL;
+    auto buffer_result = ByteBuffer::create_uninitialized(params.size);
+    if (!buffer_result.has_value())
+        return -ENOMEM;
+    auto& local_buffer = buffer_result.value();
+    Syscall::SC_pread_params host_params { params.fd, local_buffer.data(), local_buffer.size(), params.offset };
+    int nread = syscall(SC_pread, &host_params);
+    if (nread < 0)
+        return nread;
+    mmu().copy_to_vm((FlatPtr)params.buffer, local_buffer.data(), nread);
+    return nread;
+}
+
+u32 Emulator::virt$sendfile(FlatPtr params_addr)
+{
+    Syscall::SC_sendfile_params params;
+    mmu().copy_from_vm(&params, params_addr, sizeof(params));
+    i64 offset;
+    if (params.offset)
+        mmu().copy_from_vm(&offset, (FlatPtr)params.offset, sizeof(offset));
+    Syscall::SC_sendfile_params host_params { params.out_fd, params.in_fd, params.offset ? &offset : nullptr, params.count };
+    int rc = syscall(SC_sendfile, &host_params);
+    if (rc < 0)
+        return rc;
+    if (params.offset)
+        mmu().copy_to_vm((FlatPtr)params.offset, &offset, sizeof(offset));
+    return rc;
+}
+
+u32 Emulator::virt$copy_file_range(FlatPtr params_addr)
+{
+    Syscall::SC_copy_file_range_params params;
+    mmu().copy_from_vm(&params, params_addr, sizeof(params));
+    i64 offset_in;
+    i64 offset_out;
+    if (params.offset_in)
+        mmu().copy_from_vm(&offset_in, (FlatPtr)params.offset_in, sizeof(offset_in));
+    if (params.offset_out)
+        mmu().copy_from_vm(&offset_out, (FlatPtr)params.offset_out, sizeof(offset_out));
+    Syscall::SC_copy_file_range_params host_params { params.fd_in, params.offset_in ? &offset_in : nullptr, params.fd_out, params.offset_out ? &offset_out : nullptr, params.length, params.flags };
+    int rc = syscall(SC_copy_file_range, &host_params);
+    if (rc < 0)
+        return rc;
+    if (params.offset_in)
+        mmu().copy_to_vm((FlatPtr)params.offset_in, &offset_in, sizeof(offset_in));
+    if (params.offset_out)
+        mmu().copy_to_vm((FlatPtr)params.offset_out, &offset_out, sizeof(offset_out));
+    return rc;
+}
+
 void Emulator::virt$sync()
 {
     syscall(SC_sync);
@@ -296,12 +296,9 @@ ssize_t read(int fd, void* buf, size_t count)
 
 ssize_t pread(int fd, void* buf, size_t count, off_t offset)
 {
-    // FIXME: This is not thread safe and should be implemented in the kernel instead.
-    off_t old_offset = lseek(fd, 0, SEEK_CUR);
-    lseek(fd, offset, SEEK_SET);
-    ssize_t nread = read(fd, buf, count);
-    lseek(fd, old_offset, SEEK_SET);
-    return nread;
+    Syscall::SC_pread_params params { fd, buf, count, offset };
+    int rc = syscall(SC_pread, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
 ssize_t write(int fd, const void* buf, size_t count)
@@ -312,12 +309,16 @@ ssize_t write(int fd, const void* buf, size_t count)
 
 ssize_t pwrite(int fd, const void* buf, size_t count, off_t offset)
 {
-    // FIXME: This is not thread safe and should be implemented in the kernel instead.
-    off_t old_offset = lseek(fd, 0, SEEK_CUR);
-    lseek(fd, offset, SEEK_SET);
-    ssize_t nwritten = write(fd, buf, count);
-    lseek(fd, old_offset, SEEK_SET);
-    return nwritten;
+    Syscall::SC_pwrite_params params { fd, buf, count, offset };
+    int rc = syscall(SC_pwrite, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+ssize_t copy_file_range(int fd_in, off_t* offset_in, int fd_out, off_t* offset_out, size_t length, unsigned flags)
+{
+    Syscall::SC_copy_file_range_params params { fd_in, offset_in, fd_out, offset_out, length, flags };
+    int rc = syscall(SC_copy_file_range, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
 int ttyname_r(int fd, char* buffer, size_t size)
@@ -11,6 +11,7 @@
 #include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <AK/NeverDestroyed.h>
+#include <AK/NumericLimits.h>
 #include <AK/Singleton.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Time.h>
@@ -26,12 +27,18 @@
 #include <signal.h>
 #include <stdio.h>
 #include <string.h>
-#include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <time.h>
 #include <unistd.h>
 
+#if defined(__serenity__) || defined(__linux__)
+#    define EVENTLOOP_USES_EPOLL
+#    include <sys/epoll.h>
+#else
+#    include <sys/select.h>
+#endif
+
 namespace Core {
 
 class InspectorServerConnection;
@@ -60,6 +67,81 @@ static NeverDestroyed<IDAllocator> s_id_allocator;
 static HashMap<int, NonnullOwnPtr<EventLoopTimer>>* s_timers;
 static HashTable<Notifier*>* s_notifiers;
 int EventLoop::s_wake_pipe_fds[2];
+
+#ifdef EVENTLOOP_USES_EPOLL
+// Instead of handing every fd to the kernel each time we wait, we keep an epoll interest set up to date as notifiers
+// come and go. Several notifiers may watch the same fd, so the kernel gets the union of what they are waiting for.
+struct NotifierInterest {
+    Vector<Notifier*, 1> notifiers;
+    u32 events { 0 };
+    // epoll refuses fds that can't block, like regular files. select() reports those as always ready, and so do we.
+    bool always_ready { false };
+};
+static int s_epoll_fd = -1;
+static HashMap<int, NotifierInterest>* s_notifier_interests;
+static size_t s_always_ready_fd_count;
+
+static u32 epoll_events_for(NotifierInterest const& interest)
+{
+    u32 events = 0;
+    for (auto* notifier : interest.notifiers) {
+        if (notifier->event_mask() & Notifier::Read)
+            events |= EPOLLIN;
+        if (notifier->event_mask() & Notifier::Write)
+            events |= EPOLLOUT;
+        if (notifier->event_mask() & Notifier::Exceptional)
+            VERIFY_NOT_REACHED();
+    }
+    return events;
+}
+
+// Returns false if the fd can't be waited on with epoll at all.
+static bool update_epoll_interest(int fd, u32 events)
+{
+    if (s_epoll_fd < 0)
+        return true;
+
+    if (!events) {
+        // The fd may have been closed already, which took it out of the interest set.
+        (void)epoll_ctl(s_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        return true;
+    }
+
+    epoll_event event {};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(s_epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0)
+        return true;
+    if (errno == EEXIST && epoll_ctl(s_epoll_fd, EPOLL_CTL_MOD, fd, &event) == 0)
+        return true;
+    if (errno == EPERM)
+        return false;
+    dbgln("Core::EventLoop: Failed to watch fd {}: {}", fd, strerror(errno));
+    return true;
+}
+
+static void set_always_ready(NotifierInterest& interest, bool always_ready)
+{
+    if (interest.always_ready == always_ready)
+        return;
+    interest.always_ready = always_ready;
+    if (always_ready)
+        ++s_always_ready_fd_count;
+    else
+        --s_always_ready_fd_count;
+}
+
+static void add_notifier_interest(Notifier& notifier)
+{
+    auto& interest = s_notifier_interests->ensure(notifier.fd());
+    if (!interest.notifiers.contains_slow(&notifier))
+        interest.notifiers.append(&notifier);
+    // Tell the kernel even if the events didn't change, since the fd may have been closed and reused since.
+    interest.events = epoll_events_for(interest);
+    set_always_ready(interest, !update_epoll_interest(notifier.fd(), interest.events));
+}
+#endif
+
 static RefPtr<InspectorServerConnection> s_inspector_server_connection;
 
 bool EventLoop::has_been_instantiated()
@@ -262,6 +344,9 @@ EventLoop::EventLoop([[maybe_unused]] MakeInspectable make_inspectable)
         s_event_loop_stack = new Vector<EventLoop&>;
         s_timers = new HashMap<int, NonnullOwnPtr<EventLoopTimer>>;
         s_notifiers = new HashTable<Notifier*>;
+#ifdef EVENTLOOP_USES_EPOLL
+        s_notifier_interests = new HashMap<int, NotifierInterest>;
+#endif
     }
 
     if (!s_main_event_loop) {
@@ -276,6 +361,13 @@ EventLoop::EventLoop([[maybe_unused]] MakeInspectable make_inspectable)
 
 #endif
         VERIFY(rc == 0);
+#ifdef EVENTLOOP_USES_EPOLL
+        s_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        VERIFY(s_epoll_fd >= 0);
+        update_epoll_interest(s_wake_pipe_fds[0], EPOLLIN);
+        for (auto& it : *s_notifier_interests)
+            set_always_ready(it.value, !update_epoll_interest(it.key, it.value.events));
+#endif
         s_event_loop_stack->append(*this);
 
 #ifdef __serenity__
@@ -557,6 +649,13 @@ void EventLoop::notify_forked(ForkEvent event)
         s_event_loop_stack->clear();
         s_timers->clear();
         s_notifiers->clear();
+#ifdef EVENTLOOP_USES_EPOLL
+        s_notifier_interests->clear();
+        s_always_ready_fd_count = 0;
+        // The interest set is shared with the parent, so leave it alone. The next main event loop makes a new one.
+        close(s_epoll_fd);
+        s_epoll_fd = -1;
+#endif
         if (auto* info = signals_info<false>()) {
             info->signal_handlers.clear();
             info->next_signal_id = 0;
@@ -573,6 +672,10 @@ void EventLoop::notify_forked(ForkEvent event)
 
 void EventLoop::wait_for_event(WaitMode mode)
 {
+#ifdef EVENTLOOP_USES_EPOLL
+    epoll_event ready_events[32];
+retry:
+#else
     fd_set rfds;
     fd_set wfds;
 retry:
@@ -597,6 +700,7 @@ retry:
         if (notifier->event_mask() & Notifier::Exceptional)
             VERIFY_NOT_REACHED();
     }
+#endif
 
     bool queued_events_is_empty;
     {
@@ -605,13 +709,20 @@ retry:
     }
 
     Time now;
+    Time computed_timeout;
     struct timeval timeout = { 0, 0 };
     bool should_wait_forever = false;
-    if (mode == WaitMode::WaitForEvents && queued_events_is_empty) {
+#ifdef EVENTLOOP_USES_EPOLL
+    // We never block while some fd is always ready, just like select() wouldn't.
+    bool has_always_ready_fds = s_always_ready_fd_count > 0;
+#else
+    bool has_always_ready_fds = false;
+#endif
+    if (mode == WaitMode::WaitForEvents && queued_events_is_empty && !has_always_ready_fds) {
         auto next_timer_expiration = get_next_timer_expiration();
         if (next_timer_expiration.has_value()) {
             now = Time::now_monotonic_coarse();
-            auto computed_timeout = next_timer_expiration.value() - now;
+            computed_timeout = next_timer_expiration.value() - now;
             if (computed_timeout.is_negative())
                 computed_timeout = Time::zero();
             timeout = computed_timeout.to_timeval();
@@ -621,7 +732,13 @@ retry:
     }
 
 try_select_again:
+#ifdef EVENTLOOP_USES_EPOLL
+    // Round up, so that we don't spin until a timer that is due in less than a millisecond expires.
+    int timeout_ms = should_wait_forever ? -1 : static_cast<int>(min<i64>(computed_timeout.to_milliseconds(), NumericLimits<int>::max()));
+    int marked_fd_count = epoll_wait(s_epoll_fd, ready_events, array_size(ready_events), timeout_ms);
+#else
     int marked_fd_count = select(max_fd + 1, &rfds, &wfds, nullptr, should_wait_forever ? nullptr : &timeout);
+#endif
     if (marked_fd_count < 0) {
         int saved_errno = errno;
         if (saved_errno == EINTR) {
@@ -632,7 +749,17 @@ try_select_again:
         dbgln_if(EVENTLOOP_DEBUG, "Core::EventLoop::wait_for_event: {} ({}: {})", marked_fd_count, saved_errno, strerror(saved_errno));
         VERIFY_NOT_REACHED();
     }
-    if (FD_ISSET(s_wake_pipe_fds[0], &rfds)) {
+
+#ifdef EVENTLOOP_USES_EPOLL
+    bool wake_pipe_is_readable = false;
+    for (int i = 0; i < marked_fd_count; ++i) {
+        if (ready_events[i].data.fd == s_wake_pipe_fds[0])
+            wake_pipe_is_readable = true;
+    }
+#else
+    bool wake_pipe_is_readable = FD_ISSET(s_wake_pipe_fds[0], &rfds);
+#endif
+    if (wake_pipe_is_readable) {
         int wake_events[8];
         auto nread = read(s_wake_pipe_fds[0], wake_events, sizeof(wake_events));
         if (nread < 0) {
@@ -679,9 +806,41 @@ try_select_again:
         }
     }
 
+#ifdef EVENTLOOP_USES_EPOLL
+    if (has_always_ready_fds) {
+        for (auto& it : *s_notifier_interests) {
+            if (!it.value.always_ready)
+                continue;
+            for (auto* notifier : it.value.notifiers) {
+                if (notifier->event_mask() & Notifier::Event::Read)
+                    post_event(*notifier, make<NotifierReadEvent>(notifier->fd()));
+                if (notifier->event_mask() & Notifier::Event::Write)
+                    post_event(*notifier, make<NotifierWriteEvent>(notifier->fd()));
+            }
+        }
+    }
+#endif
+
     if (!marked_fd_count)
         return;
 
+#ifdef EVENTLOOP_USES_EPOLL
+    for (int i = 0; i < marked_fd_count; ++i) {
+        auto& ready_event = ready_events[i];
+        auto it = s_notifier_interests->find(ready_event.data.fd);
+        if (it == s_notifier_interests->end())
+            continue;
+        // Errors and hangups are reported regardless of what we asked for; let the notifiers find out by reading or writing.
+        bool is_readable = ready_event.events & (EPOLLIN | EPOLLERR | EPOLLHUP);
+        bool is_writable = ready_event.events & (EPOLLOUT | EPOLLERR | EPOLLHUP);
+        for (auto* notifier : it->value.notifiers) {
+            if (is_readable && (notifier->event_mask() & Notifier::Event::Read))
+                post_event(*notifier, make<NotifierReadEvent>(notifier->fd()));
+            if (is_writable && (notifier->event_mask() & Notifier::Event::Write))
+                post_event(*notifier, make<NotifierWriteEvent>(notifier->fd()));
+        }
+    }
+#else
     for (auto& notifier : *s_notifiers) {
         if (FD_ISSET(notifier->fd(), &rfds)) {
             if (notifier->event_mask() & Notifier::Event::Read)
@@ -692,6 +851,7 @@ try_select_again:
                 post_event(*notifier, make<NotifierWriteEvent>(notifier->fd()));
         }
     }
+#endif
 }
 
 bool EventLoopTimer::has_expired(const Time& now) const
@@ -748,11 +908,38 @@ bool EventLoop::unregister_timer(int timer_id)
 void EventLoop::register_notifier(Badge<Notifier>, Notifier& notifier)
 {
     s_notifiers->set(&notifier);
+#ifdef EVENTLOOP_USES_EPOLL
+    add_notifier_interest(notifier);
+#endif
 }
 
 void EventLoop::unregister_notifier(Badge<Notifier>, Notifier& notifier)
 {
     s_notifiers->remove(&notifier);
+#ifdef EVENTLOOP_USES_EPOLL
+    auto it = s_notifier_interests->find(notifier.fd());
+    if (it == s_notifier_interests->end())
+        return;
+    auto& interest = it->value;
+    interest.notifiers.remove_first_matching([&](auto* other) { return other == &notifier; });
+    auto events = interest.notifiers.is_empty() ? 0 : epoll_events_for(interest);
+    if (events != interest.events)
+        update_epoll_interest(notifier.fd(), events);
+    if (interest.notifiers.is_empty()) {
+        set_always_ready(interest, false);
+        s_notifier_interests->remove(it);
+    } else {
+        interest.events = events;
+    }
+#endif
+}
+
+void EventLoop::did_change_notifier_event_mask(Badge<Notifier>, [[maybe_unused]] Notifier& notifier)
+{
+#ifdef EVENTLOOP_USES_EPOLL
+    if (s_notifiers->contains(&notifier))
+        add_notifier_interest(notifier);
+#endif
 }
 
 void EventLoop::wake()
@@ -56,6 +56,7 @@ public:
 
     static void register_notifier(Badge<Notifier>, Notifier&);
     static void unregister_notifier(Badge<Notifier>, Notifier&);
+    static void did_change_notifier_event_mask(Badge<Notifier>, Notifier&);
 
     void quit(int);
     void unquit();
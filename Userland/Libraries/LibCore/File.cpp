@@ -397,24 +397,46 @@ Result<void, File::CopyError> File::copy_file(String const& dst_path, struct sta
             return CopyError { OSError(errno), false };
     }
 
+    bool should_copy_through_userspace = true;
+#if defined(__serenity__) || defined(__linux__)
+    // Let the kernel move the data between the files directly. It refuses some kinds of files (pipes, devices, ...)
+    // before copying anything, in which case we fall back to bouncing the data through a buffer below.
+    bool did_copy_anything = false;
     for (;;) {
-        char buffer[32768];
-        ssize_t nread = ::read(source.fd(), buffer, sizeof(buffer));
-        if (nread < 0) {
-            return CopyError { OSError(errno), false };
+        ssize_t ncopied = copy_file_range(source.fd(), nullptr, dst_fd, nullptr, 1 * MiB, 0);
+        if (ncopied < 0) {
+            if (did_copy_anything || (errno != EINVAL && errno != EXDEV && errno != ENOSYS && errno != EOPNOTSUPP))
+                return CopyError { OSError(errno), false };
+            break;
         }
-        if (nread == 0)
+        if (ncopied == 0) {
+            should_copy_through_userspace = false;
             break;
-        ssize_t remaining_to_write = nread;
-        char* bufptr = buffer;
-        while (remaining_to_write) {
-            ssize_t nwritten = ::write(dst_fd, bufptr, remaining_to_write);
-            if (nwritten < 0)
-                return CopyError { OSError(errno), false };
+        }
+        did_copy_anything = true;
+    }
+#endif
 
-            VERIFY(nwritten > 0);
-            remaining_to_write -= nwritten;
-            bufptr += nwritten;
+    if (should_copy_through_userspace) {
+        for (;;) {
+            char buffer[32768];
+            ssize_t nread = ::read(source.fd(), buffer, sizeof(buffer));
+            if (nread < 0) {
+                return CopyError { OSError(errno), false };
+            }
+            if (nread == 0)
+                break;
+            ssize_t remaining_to_write = nread;
+            char* bufptr = buffer;
+            while (remaining_to_write) {
+                ssize_t nwritten = ::write(dst_fd, bufptr, remaining_to_write);
+                if (nwritten < 0)
+                    return CopyError { OSError(errno), false };
+
+                VERIFY(nwritten > 0);
+                remaining_to_write -= nwritten;
+                bufptr += nwritten;
+            }
         }
     }
 
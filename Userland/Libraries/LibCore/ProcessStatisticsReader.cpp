@@ -5,15 +5,183 @@
  */
 
 #include <AK/ByteBuffer.h>
-#include <AK/JsonArray.h>
-#include <AK/JsonObject.h>
-#include <AK/JsonValue.h>
+#include <AK/JsonParser.h>
 #include <LibCore/File.h>
 #include <LibCore/ProcessStatisticsReader.h>
 #include <pwd.h>
 
 namespace Core {
 
+// /proc/all is read every second by system monitors, so it's read straight into the statistics
+// without building a tree of JsonValues first.
+class ProcessStatisticsVisitor final : public JsonVisitor {
+public:
+    AllProcessesStatistics take_statistics() { return move(m_statistics); }
+
+    virtual void visit_object_start(StringView) override
+    {
+        if (m_scopes.is_empty()) {
+            m_scopes.append(Scope::Document);
+        } else if (m_scopes.last() == Scope::Processes) {
+            m_statistics.processes.append({});
+            m_scopes.append(Scope::Process);
+        } else if (m_scopes.last() == Scope::Threads) {
+            m_statistics.processes.last().threads.append({});
+            m_scopes.append(Scope::Thread);
+        } else {
+            m_scopes.append(Scope::Other);
+        }
+    }
+
+    virtual void visit_array_start(StringView key) override
+    {
+        auto parent = m_scopes.is_empty() ? Scope::Other : m_scopes.last();
+        if (parent == Scope::Document && key == "processes"sv)
+            m_scopes.append(Scope::Processes);
+        else if (parent == Scope::Process && key == "threads"sv)
+            m_scopes.append(Scope::Threads);
+        else
+            m_scopes.append(Scope::Other);
+    }
+
+    virtual void visit_object_end() override { m_scopes.take_last(); }
+    virtual void visit_array_end() override { m_scopes.take_last(); }
+
+    virtual void visit_string(StringView key, StringView value) override
+    {
+        if (m_scopes.is_empty())
+            return;
+
+        if (m_scopes.last() == Scope::Process) {
+            auto& process = m_statistics.processes.last();
+            if (key == "name"sv)
+                process.name = value;
+            else if (key == "executable"sv)
+                process.executable = value;
+            else if (key == "tty"sv)
+                process.tty = value;
+            else if (key == "pledge"sv)
+                process.pledge = value;
+            else if (key == "veil"sv)
+                process.veil = value;
+        } else if (m_scopes.last() == Scope::Thread) {
+            auto& thread = m_statistics.processes.last().threads.last();
+            if (key == "name"sv)
+                thread.name = value;
+            else if (key == "state"sv)
+                thread.state = value;
+        }
+    }
+
+    virtual void visit_value(StringView key, JsonValue const& value) override
+    {
+        if (m_scopes.is_empty())
+            return;
+
+        switch (m_scopes.last()) {
+        case Scope::Document:
+            if (key == "total_time"sv)
+                m_statistics.total_time_scheduled = value.to_u64();
+            else if (key == "total_time_kernel"sv)
+                m_statistics.total_time_scheduled_kernel = value.to_u64();
+            break;
+        case Scope::Process:
+            visit_process_value(m_statistics.processes.last(), key, value);
+            break;
+        case Scope::Thread:
+            visit_thread_value(m_statistics.processes.last().threads.last(), key, value);
+            break;
+        default:
+            break;
+        }
+    }
+
+private:
+    enum class Scope {
+        Document,
+        Processes,
+        Process,
+        Threads,
+        Thread,
+        Other,
+    };
+
+    static void visit_process_value(ProcessStatistics& process, StringView key, JsonValue const& value)
+    {
+        if (key == "pid"sv)
+            process.pid = value.to_u32();
+        else if (key == "pgid"sv)
+            process.pgid = value.to_u32();
+        else if (key == "pgp"sv)
+            process.pgp = value.to_u32();
+        else if (key == "sid"sv)
+            process.sid = value.to_u32();
+        else if (key == "uid"sv)
+            process.uid = value.to_u32();
+        else if (key == "gid"sv)
+            process.gid = value.to_u32();
+        else if (key == "ppid"sv)
+            process.ppid = value.to_u32();
+        else if (key == "nfds"sv)
+            process.nfds = value.to_u32();
+        else if (key == "kernel"sv)
+            process.kernel = value.to_bool();
+        else if (key == "amount_virtual"sv)
+            process.amount_virtual = value.to_u32();
+        else if (key == "amount_resident"sv)
+            process.amount_resident = value.to_u32();
+        else if (key == "amount_shared"sv)
+            process.amount_shared = value.to_u32();
+        else if (key == "amount_dirty_private"sv)
+            process.amount_dirty_private = value.to_u32();
+        else if (key == "amount_clean_inode"sv)
+            process.amount_clean_inode = value.to_u32();
+        else if (key == "amount_purgeable_volatile"sv)
+            process.amount_purgeable_volatile = value.to_u32();
+        else if (key == "amount_purgeable_nonvolatile"sv)
+            process.amount_purgeable_nonvolatile = value.to_u32();
+    }
+
+    static void visit_thread_value(ThreadStatistics& thread, StringView key, JsonValue const& value)
+    {
+        if (key == "tid"sv)
+            thread.tid = value.to_u32();
+        else if (key == "times_scheduled"sv)
+            thread.times_scheduled = value.to_u32();
+        else if (key == "time_user"sv)
+            thread.time_user = value.to_u64();
+        else if (key == "time_kernel"sv)
+            thread.time_kernel = value.to_u64();
+        else if (key == "cpu"sv)
+            thread.cpu = value.to_u32();
+        else if (key == "priority"sv)
+            thread.priority = value.to_u32();
+        else if (key == "syscall_count"sv)
+            thread.syscall_count = value.to_u32();
+        else if (key == "inode_faults"sv)
+            thread.inode_faults = value.to_u32();
+        else if (key == "zero_faults"sv)
+            thread.zero_faults = value.to_u32();
+        else if (key == "cow_faults"sv)
+            thread.cow_faults = value.to_u32();
+        else if (key == "unix_socket_read_bytes"sv)
+            thread.unix_socket_read_bytes = value.to_u32();
+        else if (key == "unix_socket_write_bytes"sv)
+            thread.unix_socket_write_bytes = value.to_u32();
+        else if (key == "ipv4_socket_read_bytes"sv)
+            thread.ipv4_socket_read_bytes = value.to_u32();
+        else if (key == "ipv4_socket_write_bytes"sv)
+            thread.ipv4_socket_write_bytes = value.to_u32();
+        else if (key == "file_read_bytes"sv)
+            thread.file_read_bytes = value.to_u32();
+        else if (key == "file_write_bytes"sv)
+            thread.file_write_bytes = value.to_u32();
+    }
+
+    AllProcessesStatistics m_statistics {};
+    Vector<Scope, 8> m_scopes;
+};
+
 HashMap<uid_t, String> ProcessStatisticsReader::s_usernames;
 
 Optional<AllProcessesStatistics> ProcessStatisticsReader::get_all(RefPtr<Core::File>& proc_all_file)
@@ -31,74 +199,15 @@ Optional<AllProcessesStatistics> ProcessStatisticsReader::get_all(RefPtr<Core::F
         }
     }
 
-    AllProcessesStatistics all_processes_statistics;
-
     auto file_contents = proc_all_file->read_all();
-    auto json = JsonValue::from_string(file_contents);
-    if (!json.has_value())
+    ProcessStatisticsVisitor visitor;
+    if (!JsonParser(file_contents).parse(visitor))
         return {};
 
-    auto& json_obj = json.value().as_object();
-    json_obj.get("processes").as_array().for_each([&](auto& value) {
-        const JsonObject& process_object = value.as_object();
-        Core::ProcessStatistics process;
-
-        // kernel data first
-        process.pid = process_object.get("pid").to_u32();
-        process.pgid = process_object.get("pgid").to_u32();
-        process.pgp = process_object.get("pgp").to_u32();
-        process.sid = process_object.get("sid").to_u32();
-        process.uid = process_object.get("uid").to_u32();
-        process.gid = process_object.get("gid").to_u32();
-        process.ppid = process_object.get("ppid").to_u32();
-        process.nfds = process_object.get("nfds").to_u32();
-        process.kernel = process_object.get("kernel").to_bool();
-        process.name = process_object.get("name").to_string();
-        process.executable = process_object.get("executable").to_string();
-        process.tty = process_object.get("tty").to_string();
-        process.pledge = process_object.get("pledge").to_string();
-        process.veil = process_object.get("veil").to_string();
-        process.amount_virtual = process_object.get("amount_virtual").to_u32();
-        process.amount_resident = process_object.get("amount_resident").to_u32();
-        process.amount_shared = process_object.get("amount_shared").to_u32();
-        process.amount_dirty_private = process_object.get("amount_dirty_private").to_u32();
-        process.amount_clean_inode = process_object.get("amount_clean_inode").to_u32();
-        process.amount_purgeable_volatile = process_object.get("amount_purgeable_volatile").to_u32();
-        process.amount_purgeable_nonvolatile = process_object.get("amount_purgeable_nonvolatile").to_u32();
-
-        auto& thread_array = process_object.get_ptr("threads")->as_array();
-        process.threads.ensure_capacity(thread_array.size());
-        thread_array.for_each([&](auto& value) {
-            auto& thread_object = value.as_object();
-            Core::ThreadStatistics thread;
-            thread.tid = thread_object.get("tid").to_u32();
-            thread.times_scheduled = thread_object.get("times_scheduled").to_u32();
-            thread.name = thread_object.get("name").to_string();
-            thread.state = thread_object.get("state").to_string();
-            thread.time_user = thread_object.get("time_user").to_u64();
-            thread.time_kernel = thread_object.get("time_kernel").to_u64();
-            thread.cpu = thread_object.get("cpu").to_u32();
-            thread.priority = thread_object.get("priority").to_u32();
-            thread.syscall_count = thread_object.get("syscall_count").to_u32();
-            thread.inode_faults = thread_object.get("inode_faults").to_u32();
-            thread.zero_faults = thread_object.get("zero_faults").to_u32();
-            thread.cow_faults = thread_object.get("cow_faults").to_u32();
-            thread.unix_socket_read_bytes = thread_object.get("unix_socket_read_bytes").to_u32();
-            thread.unix_socket_write_bytes = thread_object.get("unix_socket_write_bytes").to_u32();
-            thread.ipv4_socket_read_bytes = thread_object.get("ipv4_socket_read_bytes").to_u32();
-            thread.ipv4_socket_write_bytes = thread_object.get("ipv4_socket_write_bytes").to_u32();
-            thread.file_read_bytes = thread_object.get("file_read_bytes").to_u32();
-            thread.file_write_bytes = thread_object.get("file_write_bytes").to_u32();
-            process.threads.append(move(thread));
-        });
-
-        // and synthetic data last
+    auto all_processes_statistics = visitor.take_statistics();
+    // Synthetic data last.
+    for (auto& process : all_processes_statistics.processes)
         process.username = username_from_uid(process.uid);
-        all_processes_statistics.processes.append(move(process));
-    });
-
-    all_processes_statistics.total_time_scheduled = json_obj.get("total_time").to_u64();
-    all_processes_statistics.total_time_scheduled_kernel = json_obj.get("total_time_kernel").to_u64();
     return all_processes_statistics;
 }
 
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonValue.h>
+#include <LibCore/File.h>
+#include <LibCore/ProcessorCount.h>
+#include <unistd.h>
+
+namespace Core {
+
+size_t processor_count()
+{
+#ifdef __serenity__
+    auto file = File::construct("/proc/cpuinfo");
+    if (!file->open(OpenMode::ReadOnly))
+        return 1;
+    auto buffer = file->read_all();
+    auto json = JsonValue::from_string({ buffer });
+    if (!json.has_value() || !json->is_array())
+        return 1;
+    return max(json->as_array().size(), (size_t)1);
+#else
+    auto count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? static_cast<size_t>(count) : 1;
+#endif
+}
+
+}
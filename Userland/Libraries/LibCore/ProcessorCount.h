@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace Core {
+
+// Returns the number of processors in the system, or 1 if that can't be determined.
+size_t processor_count();
+
+}
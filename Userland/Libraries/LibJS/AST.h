@@ -269,6 +269,11 @@ public:
     NonnullRefPtrVector<ImportStatement> const& imports() const { return m_imports; }
     NonnullRefPtrVector<ExportStatement> const& exports() const { return m_exports; }
 
+    // Every function in the program, in the order they were parsed. Serialized bytecode can't point
+    // into the AST, so it refers to functions by their index in here instead.
+    Vector<FunctionNode const*> const& parsed_functions() const { return m_parsed_functions; }
+    void set_parsed_functions(Vector<FunctionNode const*> functions) { m_parsed_functions = move(functions); }
+
 private:
     virtual bool is_program() const override { return true; }
 
@@ -277,6 +282,7 @@ private:
 
     NonnullRefPtrVector<ImportStatement> m_imports;
     NonnullRefPtrVector<ExportStatement> m_exports;
+    Vector<FunctionNode const*> m_parsed_functions;
 };
 
 class BlockStatement final : public ScopeNode {
@@ -64,6 +64,23 @@ void BasicBlock::grow(size_t additional_size)
     VERIFY(m_buffer_size <= m_buffer_capacity);
 }
 
+void BasicBlock::remove_instructions_at(Vector<size_t> const& offsets)
+{
+    if (offsets.is_empty())
+        return;
+
+    size_t write_offset = offsets.first();
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        auto& instruction = *reinterpret_cast<Instruction const*>(m_buffer + offsets[i]);
+        auto start_of_kept_range = offsets[i] + instruction.length();
+        auto end_of_kept_range = i + 1 < offsets.size() ? offsets[i + 1] : m_buffer_size;
+        VERIFY(start_of_kept_range <= end_of_kept_range);
+        __builtin_memmove(m_buffer + write_offset, m_buffer + start_of_kept_range, end_of_kept_range - start_of_kept_range);
+        write_offset += end_of_kept_range - start_of_kept_range;
+    }
+    m_buffer_size = write_offset;
+}
+
 void InstructionStreamIterator::operator++()
 {
     VERIFY(!at_end());
@@ -60,6 +60,9 @@ public:
     bool can_grow(size_t additional_size) const { return m_buffer_size + additional_size <= m_buffer_capacity; }
     void grow(size_t additional_size);
 
+    // Removes the instructions starting at the given (ascending) offsets. They must not have destructors.
+    void remove_instructions_at(Vector<size_t> const& offsets);
+
     void terminate(Badge<Generator>) { m_is_terminated = true; }
     bool is_terminated() const { return m_is_terminated; }
 
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Hex.h>
+#include <AK/MappedFile.h>
+#include <LibCore/File.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <LibJS/Bytecode/Serialization.h>
+#include <stdio.h>
+#include <unistd.h>
+
+namespace JS::Bytecode {
+
+ExecutableCache::ExecutableCache(String directory, String salt)
+    : m_directory(move(directory))
+    , m_salt(move(salt))
+{
+}
+
+String ExecutableCache::path_for_source(StringView source) const
+{
+    Crypto::Hash::SHA256 hash;
+    hash.update(m_salt);
+    hash.update(ReadonlyBytes { "\0", 1 });
+    hash.update(source);
+    auto digest = hash.digest();
+    return String::formatted("{}/{}.jsbc", m_directory, encode_hex({ digest.immutable_data(), digest.data_length() }));
+}
+
+Optional<Executable> ExecutableCache::load(StringView source, Program const& program) const
+{
+    auto path = path_for_source(source);
+    auto file_or_error = MappedFile::map(path);
+    if (file_or_error.is_error())
+        return {};
+
+    auto executable = deserialize_executable(file_or_error.value()->bytes(), program);
+    if (!executable.has_value())
+        dbgln("ExecutableCache: Ignoring stale or malformed entry {}", path);
+    return executable;
+}
+
+void ExecutableCache::store(StringView source, Program const& program, Executable const& executable) const
+{
+    auto data = serialize_executable(executable, program);
+    if (!data.has_value())
+        return;
+
+    // Write to a temporary file first, so that a concurrent load never sees a partially written entry.
+    auto path = path_for_source(source);
+    auto temporary_path = String::formatted("{}.{}.tmp", path, getpid());
+    if (!Core::File::ensure_parent_directories(path))
+        return;
+
+    auto file_or_error = Core::File::open(temporary_path, Core::OpenMode::WriteOnly | Core::OpenMode::Truncate);
+    if (file_or_error.is_error())
+        return;
+
+    auto& file = *file_or_error.value();
+    if (!file.write(data->data(), data->size()) || !file.close()) {
+        unlink(temporary_path.characters());
+        return;
+    }
+
+    if (rename(temporary_path.characters(), path.characters()) < 0)
+        unlink(temporary_path.characters());
+}
+
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibJS/Bytecode/Generator.h>
+
+namespace JS::Bytecode {
+
+// An on-disk cache of serialized executables, keyed by a hash of the source they were generated from.
+// This lets a script that has been run before skip code generation and optimization, both for its top-level
+// code and for the bodies of its functions. It does not skip parsing: the script still needs to be parsed on
+// every run, as functions refer to their AST. Scripts that create classes can't be serialized, so they are
+// never cached. For now, only the js utility's bytecode mode uses this.
+class ExecutableCache {
+public:
+    // The salt is hashed along with the source, so that executables generated in different ways
+    // (e.g. with and without optimization passes) don't replace each other.
+    explicit ExecutableCache(String directory, String salt = {});
+
+    Optional<Executable> load(StringView source, Program const&) const;
+
+    // Executables that can't be serialized are silently skipped.
+    void store(StringView source, Program const&, Executable const&) const;
+
+private:
+    String path_for_source(StringView source) const;
+
+    String m_directory;
+    String m_salt;
+};
+
+}
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/NonnullOwnPtrVector.h>
+#include <AK/NonnullRefPtrVector.h>
 #include <AK/OwnPtr.h>
 #include <AK/SinglyLinkedList.h>
 #include <LibJS/Bytecode/BasicBlock.h>
@@ -22,10 +23,23 @@ struct Executable {
     NonnullOwnPtrVector<BasicBlock> basic_blocks;
     NonnullOwnPtr<StringTable> string_table;
     size_t number_of_registers { 0 };
+    // The bodies of the functions that this executable creates, if they were compiled ahead of time.
+    // Their NewFunction instructions point into here.
+    NonnullRefPtrVector<SharedExecutable> function_executables {};
 
     String const& get_string(StringTableIndex index) const { return string_table->get(index); }
 };
 
+// A function body's executable, shared by every function object created from that function.
+struct SharedExecutable : public RefCounted<SharedExecutable> {
+    explicit SharedExecutable(Executable executable)
+        : executable(move(executable))
+    {
+    }
+
+    Executable executable;
+};
+
 class Generator {
 public:
     static Executable generate(ASTNode const&, bool is_in_generator_function = false);
@@ -96,6 +96,21 @@ public:
     void replace_references(BasicBlock const&, BasicBlock const&);
     static void destroy(Instruction&);
 
+    enum class RegisterAccess {
+        Read,
+        Write,
+        ReadWrite,
+    };
+
+    // Invokes the callback with every register operand of this instruction (not including the
+    // implicit accumulator) and how the instruction accesses it. The callback may replace the register.
+    template<typename Callback>
+    void for_each_register_operand(Callback);
+
+    // Invokes the callback with every index into the executable's string table that this instruction holds.
+    template<typename Callback>
+    void for_each_string_table_index(Callback) const;
+
 protected:
     explicit Instruction(Type type)
         : m_type(type)
@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <AK/TemporaryChange.h>
+#include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Interpreter.h>
@@ -73,13 +74,14 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
         Bytecode::InstructionStreamIterator pc(block->instruction_stream());
         bool will_jump = false;
         bool will_return = false;
-        while (!pc.at_end()) {
-            auto& instruction = *pc;
-            instruction.execute(*this);
+
+        // Deals with an exception, jump or return caused by the instruction that just ran.
+        // Returns true if we should stop executing the current block.
+        auto handle_control_flow = [&] {
             if (vm().exception()) {
                 m_saved_exception = {};
                 if (m_unwind_contexts.is_empty())
-                    break;
+                    return true;
                 auto& unwind_context = m_unwind_contexts.last();
                 if (unwind_context.handler) {
                     block = unwind_context.handler;
@@ -98,15 +100,57 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
             if (m_pending_jump.has_value()) {
                 block = m_pending_jump.release_value();
                 will_jump = true;
-                break;
+                return true;
             }
             if (!m_return_value.is_empty()) {
                 will_return = true;
-                break;
+                return true;
             }
+            return false;
+        };
+
+#if JS_BYTECODE_HAS_COMPUTED_GOTO
+        if (m_dispatch_mode == DispatchMode::Threaded) {
+            // Each instruction handler jumps straight to the handler of the next instruction, instead of
+            // going back through a single switch. That gives the CPU one indirect branch per opcode to
+            // predict, which it does a lot better than the one shared branch.
+            static void* const s_dispatch_table[] = {
+#    define __BYTECODE_OP(op) &&handle_##op,
+                ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#    undef __BYTECODE_OP
+            };
+
+            if (pc.at_end())
+                goto block_finished;
+            goto* s_dispatch_table[to_underlying((*pc).type())];
+
+#    define __BYTECODE_OP(op)                                                                        \
+    handle_##op:                                                                                     \
+        static_cast<Op::op const&>(*pc).execute_impl(*this);                                         \
+        if (vm().exception() || m_pending_jump.has_value() || !m_return_value.is_empty()) [[unlikely]] { \
+            if (handle_control_flow())                                                               \
+                goto block_finished;                                                                 \
+        }                                                                                            \
+        ++pc;                                                                                        \
+        if (pc.at_end())                                                                             \
+            goto block_finished;                                                                     \
+        goto* s_dispatch_table[to_underlying((*pc).type())];
+
+            ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#    undef __BYTECODE_OP
+        }
+#endif
+
+        while (!pc.at_end()) {
+            (*pc).execute(*this);
+            if (handle_control_flow())
+                break;
             ++pc;
         }
 
+#if JS_BYTECODE_HAS_COMPUTED_GOTO
+    block_finished:
+#endif
         if (will_return)
             break;
 
@@ -193,6 +237,8 @@ Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::Optimizat
         pm->add<Passes::MergeBlocks>();
         pm->add<Passes::GenerateCFG>();
         pm->add<Passes::PlaceBlocks>();
+        pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::AllocateRegisters>();
     } else {
         VERIFY_NOT_REACHED();
     }
@@ -203,4 +249,13 @@ Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::Optimizat
     return passes;
 }
 
+Executable Interpreter::compile_function_body(Statement const& body, FunctionKind kind)
+{
+    auto executable = Generator::generate(body, kind == FunctionKind::Generator);
+    auto& passes = optimization_pipeline();
+    passes.perform(executable);
+    dbgln_if(JS_BYTECODE_DEBUG, "Optimisation passes took {}us", passes.elapsed());
+    return executable;
+}
+
 }
@@ -16,6 +16,13 @@
 #include <LibJS/Runtime/Exception.h>
 #include <LibJS/Runtime/Value.h>
 
+// Threaded dispatch relies on the "labels as values" extension.
+#ifdef __GNUC__
+#    define JS_BYTECODE_HAS_COMPUTED_GOTO 1
+#else
+#    define JS_BYTECODE_HAS_COMPUTED_GOTO 0
+#endif
+
 namespace JS::Bytecode {
 
 using RegisterWindow = Vector<Value>;
@@ -62,12 +69,25 @@ public:
 
     Executable const& current_executable() { return *m_current_executable; }
 
+    enum class DispatchMode {
+        // One switch over the instruction type per instruction.
+        Switch,
+        // Every instruction handler jumps directly to the next one. Falls back to Switch
+        // if the compiler doesn't support computed goto.
+        Threaded,
+    };
+    DispatchMode dispatch_mode() const { return m_dispatch_mode; }
+    void set_dispatch_mode(DispatchMode mode) { m_dispatch_mode = mode; }
+
     enum class OptimizationLevel {
         Default,
         __Count,
     };
     static Bytecode::PassManager& optimization_pipeline(OptimizationLevel = OptimizationLevel::Default);
 
+    // Generates and optimizes the bytecode for a function's body, the way it gets run.
+    static Executable compile_function_body(Statement const& body, FunctionKind);
+
 private:
     RegisterWindow& registers() { return m_register_windows.last(); }
 
@@ -83,6 +103,7 @@ private:
     Executable const* m_current_executable { nullptr };
     Vector<UnwindInfo> m_unwind_contexts;
     Handle<Exception> m_saved_exception;
+    DispatchMode m_dispatch_mode { DispatchMode::Threaded };
 };
 
 }
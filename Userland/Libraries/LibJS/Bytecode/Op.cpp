@@ -224,16 +224,66 @@ void SetVariable::execute_impl(Bytecode::Interpreter& interpreter) const
     interpreter.vm().set_variable(interpreter.current_executable().get_string(m_identifier), interpreter.accumulator(), interpreter.global_object());
 }
 
+// Returns the storage offset of an own data property that may be accessed directly through the given
+// object's shape, i.e. without going through the (possibly overridden) internal methods.
+static Optional<size_t> cacheable_own_property_offset(Object const& object, PropertyName const& property_name, bool for_write)
+{
+    if (object.is_proxy_object() || !property_name.is_string())
+        return {};
+    auto metadata = object.shape().lookup(property_name.to_string_or_symbol());
+    if (!metadata.has_value())
+        return {};
+    if (for_write && !metadata->attributes.is_writable())
+        return {};
+    if (object.get_direct(metadata->offset).is_accessor())
+        return {};
+    return metadata->offset;
+}
+
 void GetById::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    if (auto* object = interpreter.accumulator().to_object(interpreter.global_object()))
-        interpreter.accumulator() = object->get(interpreter.current_executable().get_string(m_property));
+    auto* object = interpreter.accumulator().to_object(interpreter.global_object());
+    if (!object)
+        return;
+
+    if (auto offset = m_cache.lookup(object->shape()); offset.has_value()) {
+        auto value = object->get_direct(*offset);
+        if (!value.is_accessor()) {
+            interpreter.accumulator() = value;
+            return;
+        }
+    }
+
+    PropertyName property_name { interpreter.current_executable().get_string(m_property) };
+    auto value = object->get(property_name);
+    if (interpreter.vm().exception())
+        return;
+    interpreter.accumulator() = value;
+
+    if (auto offset = cacheable_own_property_offset(*object, property_name, false); offset.has_value())
+        m_cache.update(object->shape(), *offset);
 }
 
 void PutById::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    if (auto* object = interpreter.reg(m_base).to_object(interpreter.global_object()))
-        object->set(interpreter.current_executable().get_string(m_property), interpreter.accumulator(), Object::ShouldThrowExceptions::Yes);
+    auto* object = interpreter.reg(m_base).to_object(interpreter.global_object());
+    if (!object)
+        return;
+
+    if (auto offset = m_cache.lookup(object->shape()); offset.has_value()) {
+        if (!object->get_direct(*offset).is_accessor()) {
+            object->put_direct(*offset, interpreter.accumulator());
+            return;
+        }
+    }
+
+    PropertyName property_name { interpreter.current_executable().get_string(m_property) };
+    object->set(property_name, interpreter.accumulator(), Object::ShouldThrowExceptions::Yes);
+    if (interpreter.vm().exception())
+        return;
+
+    if (auto offset = cacheable_own_property_offset(*object, property_name, true); offset.has_value())
+        m_cache.update(object->shape(), *offset);
 }
 
 void Jump::execute_impl(Bytecode::Interpreter& interpreter) const
@@ -313,7 +363,10 @@ void Call::execute_impl(Bytecode::Interpreter& interpreter) const
 void NewFunction::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
-    interpreter.accumulator() = OrdinaryFunctionObject::create(interpreter.global_object(), m_function_node.name(), m_function_node.body(), m_function_node.parameters(), m_function_node.function_length(), vm.lexical_environment(), m_function_node.kind(), m_function_node.is_strict_mode(), m_function_node.is_arrow_function());
+    auto* function = OrdinaryFunctionObject::create(interpreter.global_object(), m_function_node.name(), m_function_node.body(), m_function_node.parameters(), m_function_node.function_length(), vm.lexical_environment(), m_function_node.kind(), m_function_node.is_strict_mode(), m_function_node.is_arrow_function());
+    if (m_body_executable)
+        function->set_bytecode_executable(*m_body_executable);
+    interpreter.accumulator() = function;
 }
 
 void Return::execute_impl(Bytecode::Interpreter& interpreter) const
@@ -410,8 +463,25 @@ void Yield::replace_references_impl(BasicBlock const& from, BasicBlock const& to
         m_continuation_label = Label { to };
 }
 
+// Returns the array if `base[property]` accesses one of its elements by a non-negative int32 index.
+static Array* array_for_element_access(Value base, Value property)
+{
+    if (!base.is_object() || !property.is_int32() || property.as_i32() < 0 || !is<Array>(base.as_object()))
+        return nullptr;
+    return static_cast<Array*>(&base.as_object());
+}
+
 void GetByValue::execute_impl(Bytecode::Interpreter& interpreter) const
 {
+    // Fast path: Reading an element that is an own data property of an array.
+    if (auto* array = array_for_element_access(interpreter.reg(m_base), interpreter.accumulator())) {
+        auto element = array->indexed_properties().get(interpreter.accumulator().as_i32());
+        if (element.has_value() && !element->value.is_empty() && !element->value.is_accessor()) {
+            interpreter.accumulator() = element->value;
+            return;
+        }
+    }
+
     if (auto* object = interpreter.reg(m_base).to_object(interpreter.global_object())) {
         auto property_key = interpreter.accumulator().to_property_key(interpreter.global_object());
         if (interpreter.vm().exception())
@@ -422,6 +492,23 @@ void GetByValue::execute_impl(Bytecode::Interpreter& interpreter) const
 
 void PutByValue::execute_impl(Bytecode::Interpreter& interpreter) const
 {
+    // Fast path: Writing to an element of an array that either is a writable own data property,
+    // or that doesn't exist anywhere on the prototype chain and can be added.
+    if (auto* array = array_for_element_access(interpreter.reg(m_base), interpreter.reg(m_property))) {
+        u32 index = interpreter.reg(m_property).as_i32();
+        auto& indexed_properties = array->indexed_properties();
+        auto element = indexed_properties.get(index);
+        if (element.has_value() && !element->value.is_empty()) {
+            if (!element->value.is_accessor() && element->attributes.is_writable()) {
+                indexed_properties.put(index, interpreter.accumulator(), element->attributes);
+                return;
+            }
+        } else if (array->is_extensible() && (index < indexed_properties.array_like_size() || array->length_is_writable()) && array->has_plain_prototype_chain()) {
+            indexed_properties.put(index, interpreter.accumulator());
+            return;
+        }
+    }
+
     if (auto* object = interpreter.reg(m_base).to_object(interpreter.global_object())) {
         auto property_key = interpreter.reg(m_property).to_property_key(interpreter.global_object());
         if (interpreter.vm().exception())
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/WeakPtr.h>
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Label.h>
@@ -15,6 +17,7 @@
 #include <LibJS/Bytecode/StringTable.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Runtime/Environment.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/Value.h>
 
 namespace JS::Bytecode::Op {
@@ -30,6 +33,13 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_register_operand_impl(Callback callback)
+    {
+        callback(m_src, RegisterAccess::Read);
+    }
+
+    Register src() const { return m_src; }
 
 private:
     Register m_src;
@@ -47,6 +57,8 @@ public:
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
 
+    Value value() const { return m_value; }
+
 private:
     Value m_value;
 };
@@ -62,6 +74,13 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_register_operand_impl(Callback callback)
+    {
+        callback(m_dst, RegisterAccess::Write);
+    }
+
+    Register dst() const { return m_dst; }
 
 private:
     Register m_dst;
@@ -104,6 +123,12 @@ private:
         String to_string_impl(Bytecode::Executable const&) const;              \
         void replace_references_impl(BasicBlock const&, BasicBlock const&) { } \
                                                                                \
+        template<typename Callback>                                            \
+        void for_each_register_operand_impl(Callback callback)                 \
+        {                                                                      \
+            callback(m_lhs_reg, RegisterAccess::Read);                         \
+        }                                                                      \
+                                                                               \
     private:                                                                   \
         Register m_lhs_reg;                                                    \
     };
@@ -145,6 +170,11 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_string_table_index_impl(Callback callback) const
+    {
+        callback(m_string);
+    }
 
 private:
     StringTableIndex m_string;
@@ -174,6 +204,12 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_string_table_index_impl(Callback callback) const
+    {
+        callback(m_source_index);
+        callback(m_flags_index);
+    }
 
 private:
     StringTableIndex m_source_index;
@@ -195,9 +231,19 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_register_operand_impl(Callback callback)
+    {
+        callback(m_from_object, RegisterAccess::Read);
+        for (size_t i = 0; i < m_excluded_names_count; ++i)
+            callback(m_excluded_names[i], RegisterAccess::Read);
+    }
 
     size_t length_impl() const { return sizeof(*this) + sizeof(Register) * m_excluded_names_count; }
 
+    Register from_object() const { return m_from_object; }
+    Span<Register const> excluded_names() const { return { m_excluded_names, m_excluded_names_count }; }
+
 private:
     Register m_from_object;
     size_t m_excluded_names_count { 0 };
@@ -216,6 +262,8 @@ public:
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
 
+    Crypto::SignedBigInteger const& bigint() const { return m_bigint; }
+
 private:
     Crypto::SignedBigInteger m_bigint;
 };
@@ -240,12 +288,20 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_register_operand_impl(Callback callback)
+    {
+        for (size_t i = 0; i < m_element_count; ++i)
+            callback(m_elements[i], RegisterAccess::Read);
+    }
 
     size_t length_impl() const
     {
         return sizeof(*this) + sizeof(Register) * m_element_count;
     }
 
+    Span<Register const> elements() const { return { m_elements, m_element_count }; }
+
 private:
     size_t m_element_count { 0 };
     Register m_elements[];
@@ -274,6 +330,11 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_register_operand_impl(Callback callback)
+    {
+        callback(m_lhs, RegisterAccess::ReadWrite);
+    }
 
 private:
     Register m_lhs;
@@ -290,6 +351,11 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_string_table_index_impl(Callback callback) const
+    {
+        callback(m_identifier);
+    }
 
 private:
     StringTableIndex m_identifier;
@@ -306,11 +372,51 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_string_table_index_impl(Callback callback) const
+    {
+        callback(m_identifier);
+    }
 
 private:
     StringTableIndex m_identifier;
 };
 
+// A small polymorphic inline cache for named property accesses. Each entry remembers where an own
+// data property lives in objects of one particular shape, so that a hit can skip the property table.
+class PropertyLookupCache {
+public:
+    static constexpr size_t max_entries = 4;
+
+    Optional<size_t> lookup(Shape const& shape) const
+    {
+        for (auto& entry : m_entries) {
+            if (entry.shape.ptr() == &shape && entry.unique_shape_serial_number == shape.unique_shape_serial_number())
+                return entry.property_offset;
+        }
+        return {};
+    }
+
+    void update(Shape& shape, size_t property_offset)
+    {
+        auto& entry = m_entries[m_next_entry_to_replace];
+        entry.shape = shape.make_weak_ptr();
+        entry.unique_shape_serial_number = shape.unique_shape_serial_number();
+        entry.property_offset = property_offset;
+        m_next_entry_to_replace = (m_next_entry_to_replace + 1) % max_entries;
+    }
+
+private:
+    struct Entry {
+        WeakPtr<Shape> shape;
+        u32 unique_shape_serial_number { 0 };
+        size_t property_offset { 0 };
+    };
+
+    AK::Array<Entry, max_entries> m_entries;
+    size_t m_next_entry_to_replace { 0 };
+};
+
 class GetById final : public Instruction {
 public:
     explicit GetById(StringTableIndex property)
@@ -322,9 +428,17 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_string_table_index_impl(Callback callback) const
+    {
+        callback(m_property);
+    }
+
+    StringTableIndex property() const { return m_property; }
 
 private:
     StringTableIndex m_property;
+    mutable PropertyLookupCache m_cache;
 };
 
 class PutById final : public Instruction {
@@ -339,10 +453,25 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_string_table_index_impl(Callback callback) const
+    {
+        callback(m_property);
+    }
+
+    Register base() const { return m_base; }
+    StringTableIndex property() const { return m_property; }
+
+    template<typename Callback>
+    void for_each_register_operand_impl(Callback callback)
+    {
+        callback(m_base, RegisterAccess::Read);
+    }
 
 private:
     Register m_base;
     StringTableIndex m_property;
+    mutable PropertyLookupCache m_cache;
 };
 
 class GetByValue final : public Instruction {
@@ -356,6 +485,11 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_register_operand_impl(Callback callback)
+    {
+        callback(m_base, RegisterAccess::Read);
+    }
 
 private:
     Register m_base;
@@ -373,6 +507,12 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_register_operand_impl(Callback callback)
+    {
+        callback(m_base, RegisterAccess::Read);
+        callback(m_property, RegisterAccess::Read);
+    }
 
 private:
     Register m_base;
@@ -470,12 +610,25 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    template<typename Callback>
+    void for_each_register_operand_impl(Callback callback)
+    {
+        callback(m_callee, RegisterAccess::Read);
+        callback(m_this_value, RegisterAccess::Read);
+        for (size_t i = 0; i < m_argument_count; ++i)
+            callback(m_arguments[i], RegisterAccess::Read);
+    }
 
     size_t length_impl() const
     {
         return sizeof(*this) + sizeof(Register) * m_argument_count;
     }
 
+    CallType call_type() const { return m_type; }
+    Register callee() const { return m_callee; }
+    Register this_value() const { return m_this_value; }
+    Span<Register const> arguments() const { return { m_arguments, m_argument_count }; }
+
 private:
     Register m_callee;
     Register m_this_value;
@@ -502,9 +655,10 @@ private:
 
 class NewFunction final : public Instruction {
 public:
-    explicit NewFunction(FunctionNode const& function_node)
+    explicit NewFunction(FunctionNode const& function_node, SharedExecutable* body_executable = nullptr)
         : Instruction(Type::NewFunction)
         , m_function_node(function_node)
+        , m_body_executable(body_executable)
     {
     }
 
@@ -512,8 +666,13 @@ public:
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
 
+    FunctionNode const& function_node() const { return m_function_node; }
+    SharedExecutable* body_executable() const { return m_body_executable; }
+
 private:
     FunctionNode const& m_function_node;
+    // Owned by the executable this instruction is in. Without one, the body is compiled on the first call.
+    SharedExecutable* m_body_executable { nullptr };
 };
 
 class Return final : public Instruction {
@@ -663,6 +822,8 @@ public:
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
 
+    HashMap<u32, Variable> const& variables() const { return m_variables; }
+
 private:
     HashMap<u32, Variable> m_variables;
 };
@@ -749,6 +910,55 @@ ALWAYS_INLINE void Instruction::replace_references(BasicBlock const& from, Basic
 #undef __BYTECODE_OP
 }
 
+template<typename Callback>
+ALWAYS_INLINE void Instruction::for_each_register_operand(Callback callback)
+{
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return static_cast<Bytecode::Op::op&>(*this).for_each_register_operand_impl(callback);
+#define __BYTECODE_BINARY_OP(op, _) __BYTECODE_OP(op)
+
+    switch (type()) {
+        __BYTECODE_OP(Load)
+        __BYTECODE_OP(Store)
+        __BYTECODE_OP(CopyObjectExcludingProperties)
+        __BYTECODE_OP(NewArray)
+        __BYTECODE_OP(ConcatString)
+        __BYTECODE_OP(PutById)
+        __BYTECODE_OP(GetByValue)
+        __BYTECODE_OP(PutByValue)
+        __BYTECODE_OP(Call)
+        JS_ENUMERATE_COMMON_BINARY_OPS(__BYTECODE_BINARY_OP)
+    default:
+        // Everything else only operates on the accumulator.
+        return;
+    }
+
+#undef __BYTECODE_BINARY_OP
+#undef __BYTECODE_OP
+}
+
+template<typename Callback>
+ALWAYS_INLINE void Instruction::for_each_string_table_index(Callback callback) const
+{
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return static_cast<Bytecode::Op::op const&>(*this).for_each_string_table_index_impl(callback);
+
+    switch (type()) {
+        __BYTECODE_OP(NewString)
+        __BYTECODE_OP(NewRegExp)
+        __BYTECODE_OP(SetVariable)
+        __BYTECODE_OP(GetVariable)
+        __BYTECODE_OP(GetById)
+        __BYTECODE_OP(PutById)
+    default:
+        return;
+    }
+
+#undef __BYTECODE_OP
+}
+
 ALWAYS_INLINE size_t Instruction::length() const
 {
     if (type() == Type::Call)
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// The accumulator and the global object register have fixed meanings and are never reassigned.
+static constexpr u32 first_allocatable_register = 2;
+
+static bool is_allocatable(Register const& reg)
+{
+    return reg.index() >= first_allocatable_register;
+}
+
+struct BlockLiveness {
+    HashTable<u32> uses;
+    HashTable<u32> defs;
+    HashTable<u32> live_in;
+    HashTable<u32> live_out;
+};
+
+// Removes every `Load $x` that immediately follows a `Store $x`, as the accumulator already holds that value.
+static void remove_redundant_loads(BasicBlock& block)
+{
+    Vector<size_t> offsets_to_remove;
+    Optional<u32> register_in_accumulator;
+
+    InstructionStreamIterator it { block.instruction_stream() };
+    while (!it.at_end()) {
+        auto& instruction = *it;
+        if (instruction.type() == Instruction::Type::Load && register_in_accumulator == static_cast<Op::Load const&>(instruction).src().index()) {
+            offsets_to_remove.append(it.offset());
+        } else if (instruction.type() == Instruction::Type::Store) {
+            register_in_accumulator = static_cast<Op::Store const&>(instruction).dst().index();
+        } else {
+            register_in_accumulator = {};
+        }
+        ++it;
+    }
+
+    block.remove_instructions_at(offsets_to_remove);
+}
+
+template<typename Callback>
+static void for_each_instruction_in_reverse(BasicBlock const& block, Callback callback)
+{
+    Vector<size_t> offsets;
+    InstructionStreamIterator it { block.instruction_stream() };
+    while (!it.at_end()) {
+        offsets.append(it.offset());
+        ++it;
+    }
+    for (size_t i = offsets.size(); i > 0; --i) {
+        auto offset = offsets[i - 1];
+        callback(const_cast<Instruction&>(*reinterpret_cast<Instruction const*>(block.instruction_stream().offset_pointer(offset))), offset);
+    }
+}
+
+static void update_liveness(Instruction& instruction, HashTable<u32>& live)
+{
+    // Writes kill a register before the reads of the same instruction make it live again.
+    instruction.for_each_register_operand([&](Register& reg, auto access) {
+        if (is_allocatable(reg) && access == Instruction::RegisterAccess::Write)
+            live.remove(reg.index());
+    });
+    instruction.for_each_register_operand([&](Register& reg, auto access) {
+        if (is_allocatable(reg) && access != Instruction::RegisterAccess::Write)
+            live.set(reg.index());
+    });
+}
+
+void AllocateRegisters::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.cfg.has_value());
+    auto& cfg = *executable.cfg;
+    auto& blocks = executable.executable.basic_blocks;
+
+    for (auto& block : blocks)
+        remove_redundant_loads(block);
+
+    // Compute which registers are live on entry to and exit from each block.
+    HashMap<BasicBlock const*, BlockLiveness> liveness;
+    for (auto& block : blocks) {
+        auto& entry = liveness.ensure(&block);
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            const_cast<Instruction&>(*it).for_each_register_operand([&](Register& reg, auto access) {
+                if (!is_allocatable(reg))
+                    return;
+                if (access != Instruction::RegisterAccess::Write && !entry.defs.contains(reg.index()))
+                    entry.uses.set(reg.index());
+                if (access != Instruction::RegisterAccess::Read)
+                    entry.defs.set(reg.index());
+            });
+            ++it;
+        }
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = blocks.size(); i > 0; --i) {
+            auto* block = &blocks[i - 1];
+            auto& entry = liveness.find(block)->value;
+
+            for (auto* successor : cfg.get(block).value_or({})) {
+                for (auto reg : liveness.find(successor)->value.live_in)
+                    entry.live_out.set(reg);
+            }
+
+            auto live_in_size = entry.live_in.size();
+            for (auto reg : entry.uses)
+                entry.live_in.set(reg);
+            for (auto reg : entry.live_out) {
+                if (!entry.defs.contains(reg))
+                    entry.live_in.set(reg);
+            }
+            if (entry.live_in.size() != live_in_size)
+                changed = true;
+        }
+    }
+
+    // An exception can transfer control to a handler or finalizer from anywhere inside its unwind context,
+    // which the CFG doesn't model. Registers that are live there (or read before being written at all) are
+    // therefore pinned: they are treated as live everywhere and keep a slot of their own.
+    HashTable<u32> pinned_registers;
+    auto pin_live_in_registers = [&](BasicBlock const& block) {
+        for (auto reg : liveness.find(&block)->value.live_in)
+            pinned_registers.set(reg);
+    };
+    pin_live_in_registers(blocks.first());
+    for (auto& block : blocks) {
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            if ((*it).type() == Instruction::Type::EnterUnwindContext) {
+                auto& enter_unwind_context = static_cast<Op::EnterUnwindContext const&>(*it);
+                if (enter_unwind_context.handler_target().has_value())
+                    pin_live_in_registers(enter_unwind_context.handler_target()->block());
+                if (enter_unwind_context.finalizer_target().has_value())
+                    pin_live_in_registers(enter_unwind_context.finalizer_target()->block());
+            }
+            ++it;
+        }
+    }
+
+    // Walk each block backwards to remove stores to dead registers, and to find which registers are
+    // live at the same time (and so can't share a slot).
+    HashMap<u32, HashTable<u32>> interference;
+    for (auto& block : blocks) {
+        auto live = liveness.find(&block)->value.live_out;
+        for (auto reg : pinned_registers)
+            live.set(reg);
+
+        Vector<size_t> offsets_to_remove;
+        for_each_instruction_in_reverse(block, [&](Instruction& instruction, size_t offset) {
+            if (instruction.type() == Instruction::Type::Store) {
+                auto dst = static_cast<Op::Store const&>(instruction).dst();
+                if (is_allocatable(dst) && !live.contains(dst.index()) && !pinned_registers.contains(dst.index())) {
+                    offsets_to_remove.append(offset);
+                    return;
+                }
+            }
+
+            instruction.for_each_register_operand([&](Register& reg, auto access) {
+                if (!is_allocatable(reg) || access == Instruction::RegisterAccess::Read)
+                    return;
+                for (auto other : live) {
+                    if (other == reg.index())
+                        continue;
+                    interference.ensure(reg.index()).set(other);
+                    interference.ensure(other).set(reg.index());
+                }
+            });
+
+            update_liveness(instruction, live);
+        });
+
+        offsets_to_remove.reverse();
+        block.remove_instructions_at(offsets_to_remove);
+    }
+
+    // Greedily assign each register the lowest slot that none of its neighbors use.
+    HashMap<u32, u32> assigned_slots;
+    HashTable<u32> pinned_slots;
+    u32 next_free_slot = first_allocatable_register;
+    for (auto& block : blocks) {
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            const_cast<Instruction&>(*it).for_each_register_operand([&](Register& reg, auto) {
+                if (!is_allocatable(reg) || assigned_slots.contains(reg.index()))
+                    return;
+
+                if (pinned_registers.contains(reg.index())) {
+                    pinned_slots.set(next_free_slot);
+                    assigned_slots.set(reg.index(), next_free_slot++);
+                    return;
+                }
+
+                HashTable<u32> unavailable_slots;
+                if (auto neighbors = interference.find(reg.index()); neighbors != interference.end()) {
+                    for (auto neighbor : neighbors->value) {
+                        if (auto slot = assigned_slots.get(neighbor); slot.has_value())
+                            unavailable_slots.set(*slot);
+                    }
+                }
+
+                u32 slot = first_allocatable_register;
+                while (slot < next_free_slot && (pinned_slots.contains(slot) || unavailable_slots.contains(slot)))
+                    ++slot;
+                if (slot == next_free_slot)
+                    ++next_free_slot;
+                assigned_slots.set(reg.index(), slot);
+            });
+            ++it;
+        }
+    }
+
+    for (auto& block : blocks) {
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            const_cast<Instruction&>(*it).for_each_register_operand([&](Register& reg, auto) {
+                if (is_allocatable(reg))
+                    reg = Register { *assigned_slots.get(reg.index()) };
+            });
+            ++it;
+        }
+    }
+
+    executable.executable.number_of_registers = next_free_slot;
+
+    finished();
+}
+
+}
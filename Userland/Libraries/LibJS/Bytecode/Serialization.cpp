@@ -0,0 +1,704 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/MemoryStream.h>
+#include <AK/ScopeGuard.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Serialization.h>
+
+namespace JS::Bytecode {
+
+// The serialized form of an Executable looks like this:
+//
+//     header:       magic, format version, instruction layout fingerprint, number of functions in the program
+//     functions:    for every function body the executable (indirectly) creates, innermost first,
+//                   the index of the function in the program, then its executable
+//     no_function, then the executable itself
+//
+// and each executable looks like this:
+//
+//     number of registers
+//     string table: count, then each string (length + bytes)
+//     blocks:       count, then each block's name and size, then each block's instructions
+//
+// Most instructions are plain data and are stored as their raw bytes. That ties the data to the exact
+// layout of the instructions in this build of LibJS, so a fingerprint of that layout goes into the header.
+// Instructions that point to blocks, functions, or heap memory, or have caches are encoded field by field instead.
+
+static constexpr u32 serialization_magic = 0x43424a4c; // "LJBC"
+
+static constexpr u32 instruction_layout_fingerprint()
+{
+    u32 fingerprint = sizeof(Value) * 31 + sizeof(Register);
+#define __BYTECODE_OP(op) fingerprint = fingerprint * 31 + sizeof(Op::op);
+    ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    return fingerprint;
+}
+
+static constexpr bool has_custom_encoding(Instruction::Type type)
+{
+    switch (type) {
+    case Instruction::Type::LoadImmediate:
+    case Instruction::Type::NewBigInt:
+    case Instruction::Type::GetById:
+    case Instruction::Type::PutById:
+    case Instruction::Type::Jump:
+    case Instruction::Type::JumpConditional:
+    case Instruction::Type::JumpNullish:
+    case Instruction::Type::JumpUndefined:
+    case Instruction::Type::NewFunction:
+    case Instruction::Type::NewClass:
+    case Instruction::Type::EnterUnwindContext:
+    case Instruction::Type::ContinuePendingUnwind:
+    case Instruction::Type::Yield:
+    case Instruction::Type::PushDeclarativeEnvironment:
+    case Instruction::Type::NewArray:
+    case Instruction::Type::CopyObjectExcludingProperties:
+    case Instruction::Type::Call:
+        return true;
+    default:
+        return false;
+    }
+}
+
+#define __BYTECODE_OP(op) static_assert(has_custom_encoding(Instruction::Type::op) || IsTriviallyCopyable<Op::op>, "Op::" #op " needs to be encoded field by field");
+ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+
+static constexpr u64 no_label = NumericLimits<u64>::max();
+static constexpr u64 no_function = NumericLimits<u64>::max();
+
+// Blocks and registers are allocated up front, so their sizes are sanity-checked before trusting them.
+static constexpr u64 max_block_size = 64 * MiB;
+static constexpr u64 max_register_count = 1 * MiB;
+
+class Encoder {
+public:
+    explicit Encoder(Program const& program)
+    {
+        auto& functions = program.parsed_functions();
+        for (size_t i = 0; i < functions.size(); ++i)
+            m_function_indices.set(functions[i], i);
+    }
+
+    void encode(u32 value) { m_stream << value; }
+    void encode(u64 value) { m_stream << value; }
+    void encode(StringView string)
+    {
+        encode(static_cast<u64>(string.length()));
+        m_stream << string.bytes();
+    }
+    void encode(Register reg) { encode(reg.index()); }
+    void encode(Span<Register const> registers)
+    {
+        encode(static_cast<u64>(registers.size()));
+        for (auto reg : registers)
+            encode(reg);
+    }
+    void encode(StringTableIndex index) { encode(static_cast<u64>(index.value())); }
+    void encode(Label const& label) { encode(m_block_indices.get(&label.block()).value()); }
+    void encode(Optional<Label> const& label)
+    {
+        if (label.has_value())
+            encode(*label);
+        else
+            encode(no_label);
+    }
+
+    // Values are only ever stored as immediates, so they never refer to cells.
+    [[nodiscard]] bool encode(Value value)
+    {
+        if (value.is_cell())
+            return false;
+        encode(static_cast<u32>(value.type()));
+        if (value.is_int32())
+            encode(static_cast<u32>(value.as_i32()));
+        else if (value.is_number())
+            encode(bit_cast<u64>(value.as_double()));
+        else if (value.is_boolean())
+            encode(static_cast<u32>(value.as_bool()));
+        return true;
+    }
+
+    [[nodiscard]] bool encode(Executable const&);
+    [[nodiscard]] bool encode_bodies_of_functions_created_by(Executable const&);
+
+    ByteBuffer finish() { return m_stream.copy_into_contiguous_buffer(); }
+
+private:
+    [[nodiscard]] bool encode(Instruction const&);
+
+    DuplexMemoryStream m_stream;
+    HashMap<BasicBlock const*, u64> m_block_indices;
+    HashMap<FunctionNode const*, u64> m_function_indices;
+    HashTable<FunctionNode const*> m_encoded_function_bodies;
+};
+
+bool Encoder::encode(Instruction const& instruction)
+{
+    encode(static_cast<u32>(instruction.type()));
+
+    switch (instruction.type()) {
+    case Instruction::Type::LoadImmediate:
+        return encode(static_cast<Op::LoadImmediate const&>(instruction).value());
+    case Instruction::Type::NewBigInt:
+        encode(static_cast<Op::NewBigInt const&>(instruction).bigint().to_base(10));
+        return true;
+    case Instruction::Type::GetById:
+        encode(static_cast<Op::GetById const&>(instruction).property());
+        return true;
+    case Instruction::Type::PutById: {
+        auto& put_by_id = static_cast<Op::PutById const&>(instruction);
+        encode(put_by_id.base());
+        encode(put_by_id.property());
+        return true;
+    }
+    case Instruction::Type::Jump:
+    case Instruction::Type::JumpConditional:
+    case Instruction::Type::JumpNullish:
+    case Instruction::Type::JumpUndefined: {
+        auto& jump = static_cast<Op::Jump const&>(instruction);
+        encode(jump.true_target());
+        encode(jump.false_target());
+        return true;
+    }
+    case Instruction::Type::NewFunction: {
+        // The function's body was encoded before this executable, see encode_bodies_of_functions_created_by().
+        auto& function = static_cast<Op::NewFunction const&>(instruction).function_node();
+        encode(m_function_indices.get(&function).value());
+        return true;
+    }
+    case Instruction::Type::NewClass:
+        // Classes aren't supported by the bytecode interpreter yet.
+        return false;
+    case Instruction::Type::EnterUnwindContext: {
+        auto& enter_unwind_context = static_cast<Op::EnterUnwindContext const&>(instruction);
+        encode(enter_unwind_context.entry_point());
+        encode(enter_unwind_context.handler_target());
+        encode(enter_unwind_context.finalizer_target());
+        return true;
+    }
+    case Instruction::Type::ContinuePendingUnwind:
+        encode(static_cast<Op::ContinuePendingUnwind const&>(instruction).resume_target());
+        return true;
+    case Instruction::Type::Yield:
+        encode(static_cast<Op::Yield const&>(instruction).continuation());
+        return true;
+    case Instruction::Type::NewArray:
+        encode(static_cast<Op::NewArray const&>(instruction).elements());
+        return true;
+    case Instruction::Type::CopyObjectExcludingProperties: {
+        auto& copy_object = static_cast<Op::CopyObjectExcludingProperties const&>(instruction);
+        encode(copy_object.from_object());
+        encode(copy_object.excluded_names());
+        return true;
+    }
+    case Instruction::Type::Call: {
+        auto& call = static_cast<Op::Call const&>(instruction);
+        encode(static_cast<u32>(call.call_type()));
+        encode(call.callee());
+        encode(call.this_value());
+        encode(call.arguments());
+        return true;
+    }
+    case Instruction::Type::PushDeclarativeEnvironment: {
+        auto& variables = static_cast<Op::PushDeclarativeEnvironment const&>(instruction).variables();
+        encode(static_cast<u64>(variables.size()));
+        for (auto& it : variables) {
+            encode(it.key);
+            if (!encode(it.value.value))
+                return false;
+            encode(static_cast<u32>(it.value.declaration_kind));
+        }
+        return true;
+    }
+    default:
+        VERIFY(!has_custom_encoding(instruction.type()));
+        encode(static_cast<u64>(instruction.length()));
+        m_stream << ReadonlyBytes { &instruction, instruction.length() };
+        return true;
+    }
+}
+
+bool Encoder::encode(Executable const& executable)
+{
+    m_block_indices.clear();
+    for (size_t i = 0; i < executable.basic_blocks.size(); ++i)
+        m_block_indices.set(&executable.basic_blocks[i], i);
+
+    encode(static_cast<u64>(executable.number_of_registers));
+
+    encode(static_cast<u64>(executable.string_table->size()));
+    for (size_t i = 0; i < executable.string_table->size(); ++i)
+        encode(executable.get_string(i).view());
+
+    encode(static_cast<u64>(executable.basic_blocks.size()));
+    for (auto& block : executable.basic_blocks) {
+        encode(block.name().view());
+        encode(static_cast<u64>(block.size()));
+    }
+
+    for (auto& block : executable.basic_blocks) {
+        u64 instruction_count = 0;
+        for (InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it)
+            ++instruction_count;
+        encode(instruction_count);
+
+        for (InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it) {
+            if (!encode(*it))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Encodes the body of every function that the executable creates, after the bodies of the functions that those
+// create in turn. That way, a body has always been decoded by the time a NewFunction instruction refers to it.
+bool Encoder::encode_bodies_of_functions_created_by(Executable const& executable)
+{
+    for (auto& block : executable.basic_blocks) {
+        for (InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it) {
+            if ((*it).type() != Instruction::Type::NewFunction)
+                continue;
+            auto& new_function = static_cast<Op::NewFunction const&>(*it);
+            auto& function = new_function.function_node();
+            auto function_index = m_function_indices.get(&function);
+            if (!function_index.has_value())
+                return false;
+            if (m_encoded_function_bodies.set(&function) == AK::HashSetResult::KeptExistingEntry)
+                continue;
+
+            // Executables that were deserialized already have their functions' bodies compiled.
+            Optional<Executable> compiled_body;
+            auto* body = new_function.body_executable() ? &new_function.body_executable()->executable : nullptr;
+            if (!body) {
+                compiled_body = Interpreter::compile_function_body(function.body(), function.kind());
+                body = &*compiled_body;
+            }
+
+            if (!encode_bodies_of_functions_created_by(*body))
+                return false;
+            encode(*function_index);
+            if (!encode(*body))
+                return false;
+        }
+    }
+    return true;
+}
+
+Optional<ByteBuffer> serialize_executable(Executable const& executable, Program const& program)
+{
+    Encoder encoder { program };
+
+    encoder.encode(serialization_magic);
+    encoder.encode(serialization_format_version);
+    encoder.encode(instruction_layout_fingerprint());
+    encoder.encode(static_cast<u64>(program.parsed_functions().size()));
+
+    if (!encoder.encode_bodies_of_functions_created_by(executable))
+        return {};
+    encoder.encode(no_function);
+    if (!encoder.encode(executable))
+        return {};
+
+    return encoder.finish();
+}
+
+class Decoder {
+public:
+    Decoder(ReadonlyBytes bytes, Program const& program)
+        : m_stream(bytes)
+        , m_functions(program.parsed_functions())
+    {
+    }
+
+    bool has_failed()
+    {
+        if (m_stream.handle_any_error())
+            m_failed = true;
+        return m_failed;
+    }
+    bool is_at_end() const { return m_stream.eof(); }
+    void fail() { m_failed = true; }
+
+    u32 decode_u32()
+    {
+        u32 value = 0;
+        m_stream >> value;
+        return value;
+    }
+
+    u64 decode_u64()
+    {
+        u64 value = 0;
+        m_stream >> value;
+        return value;
+    }
+
+    // Used for counts and lengths; anything that couldn't possibly fit in the remaining data is rejected.
+    size_t decode_size()
+    {
+        auto size = decode_u64();
+        if (size > m_stream.remaining()) {
+            fail();
+            return 0;
+        }
+        return size;
+    }
+
+    String decode_string()
+    {
+        auto length = decode_size();
+        if (has_failed())
+            return {};
+        auto string = String(reinterpret_cast<char const*>(m_stream.bytes().offset_pointer(m_stream.offset())), length);
+        m_stream.discard_or_error(length);
+        return string;
+    }
+
+    Register decode_register() { return Register { decode_u32() }; }
+    StringTableIndex decode_string_table_index() { return decode_u64(); }
+
+    // The count is checked against the remaining data before anything is allocated for it.
+    Vector<Register> decode_register_list()
+    {
+        auto count = decode_u64();
+        if (count > m_stream.remaining() / sizeof(u32)) {
+            fail();
+            return {};
+        }
+        Vector<Register> registers;
+        registers.ensure_capacity(count);
+        for (size_t i = 0; i < count; ++i)
+            registers.unchecked_append(decode_register());
+        return registers;
+    }
+
+    // Values are rebuilt from their type and payload, so that nothing but the encodings Value itself produces
+    // (and certainly no cell pointers) can end up in the executable.
+    Value decode_value()
+    {
+        Value value;
+        switch (static_cast<Value::Type>(decode_u32())) {
+        case Value::Type::Empty:
+            break;
+        case Value::Type::Undefined:
+            value = js_undefined();
+            break;
+        case Value::Type::Null:
+            value = js_null();
+            break;
+        case Value::Type::Int32:
+            value = Value(static_cast<i32>(decode_u32()));
+            break;
+        case Value::Type::Double:
+            value = Value(bit_cast<double>(decode_u64()));
+            break;
+        case Value::Type::Boolean: {
+            auto boolean = decode_u32();
+            if (boolean > 1)
+                fail();
+            value = Value(boolean == 1);
+            break;
+        }
+        default:
+            fail();
+            break;
+        }
+        return has_failed() ? Value {} : value;
+    }
+
+    Optional<Label> decode_optional_label()
+    {
+        auto index = decode_u64();
+        if (index == no_label)
+            return {};
+        if (index >= m_blocks.size()) {
+            fail();
+            return {};
+        }
+        return Label { *m_blocks[index] };
+    }
+
+    Label decode_label()
+    {
+        auto label = decode_optional_label();
+        if (!label.has_value()) {
+            fail();
+            return Label { *m_blocks.first() };
+        }
+        return *label;
+    }
+
+    // Returns the index of the function, or an empty Optional once the function bodies are done.
+    Optional<size_t> decode_function_index()
+    {
+        auto index = decode_u64();
+        if (index == no_function)
+            return {};
+        if (index >= m_functions.size() || m_function_bodies.contains(index)) {
+            fail();
+            return {};
+        }
+        return index;
+    }
+
+    void did_decode_function_body(size_t function_index, Executable body)
+    {
+        m_function_bodies.set(function_index, adopt_ref(*new SharedExecutable(move(body))));
+    }
+
+    Optional<Executable> decode_executable();
+
+private:
+    void decode_instruction(BasicBlock&);
+
+    template<typename OpType, typename... Args>
+    void append(BasicBlock& block, Args&&... args)
+    {
+        append_with_extra_register_slots<OpType>(block, 0, forward<Args>(args)...);
+    }
+
+    template<typename OpType, typename... Args>
+    void append_with_extra_register_slots(BasicBlock& block, size_t extra_register_slots, Args&&... args)
+    {
+        auto length = sizeof(OpType) + extra_register_slots * sizeof(Register);
+        if (has_failed() || !block.can_grow(length)) {
+            fail();
+            return;
+        }
+        new (block.next_slot()) OpType(forward<Args>(args)...);
+        block.grow(length);
+    }
+
+    // Makes sure that every register and string an instruction refers to exists in the executable being decoded.
+    void validate_operands(Instruction&);
+
+    InputMemoryStream m_stream;
+    Vector<FunctionNode const*> const& m_functions;
+    HashMap<size_t, NonnullRefPtr<SharedExecutable>> m_function_bodies;
+
+    // These describe the executable that is currently being decoded.
+    Vector<BasicBlock const*> m_blocks;
+    size_t m_number_of_registers { 0 };
+    size_t m_string_count { 0 };
+    NonnullRefPtrVector<SharedExecutable> m_function_executables;
+
+    bool m_failed { false };
+};
+
+void Decoder::validate_operands(Instruction& instruction)
+{
+    instruction.for_each_register_operand([&](Register& reg, auto) {
+        if (reg.index() >= m_number_of_registers)
+            fail();
+    });
+    instruction.for_each_string_table_index([&](StringTableIndex index) {
+        if (index.value() >= m_string_count)
+            fail();
+    });
+}
+
+void Decoder::decode_instruction(BasicBlock& block)
+{
+    auto* instruction = reinterpret_cast<Instruction*>(block.next_slot());
+    ScopeGuard validate_operands_guard([&] {
+        if (block.next_slot() != reinterpret_cast<u8*>(instruction))
+            validate_operands(*instruction);
+    });
+
+    auto type = static_cast<Instruction::Type>(decode_u32());
+
+    switch (type) {
+    case Instruction::Type::LoadImmediate:
+        return append<Op::LoadImmediate>(block, decode_value());
+    case Instruction::Type::NewBigInt:
+        return append<Op::NewBigInt>(block, Crypto::SignedBigInteger::from_base(10, decode_string()));
+    case Instruction::Type::GetById:
+        return append<Op::GetById>(block, decode_string_table_index());
+    case Instruction::Type::PutById: {
+        auto base = decode_register();
+        return append<Op::PutById>(block, base, decode_string_table_index());
+    }
+    case Instruction::Type::Jump:
+    case Instruction::Type::JumpConditional:
+    case Instruction::Type::JumpNullish:
+    case Instruction::Type::JumpUndefined: {
+        auto true_target = decode_optional_label();
+        auto false_target = decode_optional_label();
+        if (type == Instruction::Type::Jump)
+            return append<Op::Jump>(block, move(true_target), move(false_target));
+        if (type == Instruction::Type::JumpConditional)
+            return append<Op::JumpConditional>(block, move(true_target), move(false_target));
+        if (type == Instruction::Type::JumpNullish)
+            return append<Op::JumpNullish>(block, move(true_target), move(false_target));
+        return append<Op::JumpUndefined>(block, move(true_target), move(false_target));
+    }
+    case Instruction::Type::NewFunction: {
+        auto function_index = decode_u64();
+        auto body = m_function_bodies.get(function_index);
+        if (!body.has_value())
+            return fail();
+        m_function_executables.append(*body.value());
+        return append<Op::NewFunction>(block, *m_functions[function_index], body.value());
+    }
+    case Instruction::Type::EnterUnwindContext: {
+        auto entry_point = decode_label();
+        auto handler_target = decode_optional_label();
+        auto finalizer_target = decode_optional_label();
+        return append<Op::EnterUnwindContext>(block, move(entry_point), move(handler_target), move(finalizer_target));
+    }
+    case Instruction::Type::ContinuePendingUnwind:
+        return append<Op::ContinuePendingUnwind>(block, decode_label());
+    case Instruction::Type::Yield: {
+        auto continuation = decode_optional_label();
+        if (continuation.has_value())
+            return append<Op::Yield>(block, *continuation);
+        return append<Op::Yield>(block, nullptr);
+    }
+    case Instruction::Type::NewArray: {
+        auto elements = decode_register_list();
+        return append_with_extra_register_slots<Op::NewArray>(block, elements.size(), elements);
+    }
+    case Instruction::Type::CopyObjectExcludingProperties: {
+        auto from_object = decode_register();
+        auto excluded_names = decode_register_list();
+        return append_with_extra_register_slots<Op::CopyObjectExcludingProperties>(block, excluded_names.size(), from_object, excluded_names);
+    }
+    case Instruction::Type::Call: {
+        auto call_type = decode_u32();
+        auto callee = decode_register();
+        auto this_value = decode_register();
+        auto arguments = decode_register_list();
+        if (call_type > static_cast<u32>(Op::Call::CallType::Construct))
+            return fail();
+        return append_with_extra_register_slots<Op::Call>(block, arguments.size(), static_cast<Op::Call::CallType>(call_type), callee, this_value, arguments);
+    }
+    case Instruction::Type::PushDeclarativeEnvironment: {
+        HashMap<u32, Variable> variables;
+        auto variable_count = decode_size();
+        for (size_t i = 0; i < variable_count && !has_failed(); ++i) {
+            auto key = decode_u32();
+            auto value = decode_value();
+            auto declaration_kind = decode_u32();
+            // The variables' names are looked up in the string table.
+            if (key >= m_string_count || declaration_kind > static_cast<u32>(DeclarationKind::Const))
+                return fail();
+            variables.set(key, { value, static_cast<DeclarationKind>(declaration_kind) });
+        }
+        return append<Op::PushDeclarativeEnvironment>(block, move(variables));
+    }
+    default:
+        break;
+    }
+
+#define __BYTECODE_OP(op) case Instruction::Type::op:
+    switch (type) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+        break;
+    default:
+        return fail();
+    }
+#undef __BYTECODE_OP
+
+    // Everything else was stored as raw bytes.
+    auto length = decode_size();
+    if (has_custom_encoding(type) || length < sizeof(Instruction) || !block.can_grow(length))
+        return fail();
+    m_stream >> Bytes { block.next_slot(), length };
+    if (has_failed())
+        return fail();
+    if (instruction->type() != type || instruction->length() != length)
+        return fail();
+    block.grow(length);
+}
+
+Optional<Executable> Decoder::decode_executable()
+{
+    m_blocks.clear();
+    m_function_executables.clear();
+
+    auto number_of_registers = decode_u64();
+    // The interpreter always stores the global object in a register.
+    if (number_of_registers <= Register::global_object_index || number_of_registers > max_register_count) {
+        fail();
+        return {};
+    }
+    m_number_of_registers = number_of_registers;
+
+    auto string_table = make<StringTable>();
+    auto string_count = decode_size();
+    for (size_t i = 0; i < string_count && !has_failed(); ++i) {
+        if (string_table->insert(decode_string()).value() != i)
+            fail();
+    }
+    m_string_count = string_count;
+
+    NonnullOwnPtrVector<BasicBlock> blocks;
+    auto block_count = decode_size();
+    for (size_t i = 0; i < block_count && !has_failed(); ++i) {
+        auto name = decode_string();
+        auto size = decode_u64();
+        if (size > max_block_size) {
+            fail();
+            break;
+        }
+        blocks.append(BasicBlock::create(move(name), size));
+    }
+    if (blocks.is_empty())
+        fail();
+    for (auto& block : blocks)
+        m_blocks.append(&block);
+
+    for (auto& block : blocks) {
+        auto instruction_count = decode_size();
+        for (size_t i = 0; i < instruction_count && !has_failed(); ++i)
+            decode_instruction(block);
+    }
+
+    if (has_failed())
+        return {};
+    return Executable { move(blocks), move(string_table), m_number_of_registers, move(m_function_executables) };
+}
+
+Optional<Executable> deserialize_executable(ReadonlyBytes bytes, Program const& program)
+{
+    Decoder decoder { bytes, program };
+
+    auto magic = decoder.decode_u32();
+    auto format_version = decoder.decode_u32();
+    auto layout_fingerprint = decoder.decode_u32();
+    auto function_count = decoder.decode_u64();
+    if (decoder.has_failed() || magic != serialization_magic || format_version != serialization_format_version || layout_fingerprint != instruction_layout_fingerprint())
+        return {};
+    // The functions are numbered by the parser, so this is a cheap check that the data was made for this program.
+    if (function_count != program.parsed_functions().size())
+        return {};
+
+    while (!decoder.has_failed()) {
+        auto function_index = decoder.decode_function_index();
+        if (!function_index.has_value())
+            break;
+        auto body = decoder.decode_executable();
+        if (!body.has_value())
+            return {};
+        decoder.did_decode_function_body(*function_index, body.release_value());
+    }
+
+    auto executable = decoder.decode_executable();
+    if (decoder.has_failed() || !decoder.is_at_end())
+        return {};
+    return executable;
+}
+
+}
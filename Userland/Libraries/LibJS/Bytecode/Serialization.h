@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
+#include <LibJS/Bytecode/Generator.h>
+
+namespace JS::Bytecode {
+
+// Bump this whenever the encoding of an Executable changes in a way that makes older data unreadable.
+static constexpr u32 serialization_format_version = 3;
+
+// The bodies of the functions that the executable creates are compiled ahead of time (unless they already are)
+// and serialized along with it. Functions are referred to by their index in the program's parsed_functions(),
+// so the program that the executable was generated from is needed to deserialize it again.
+// Returns an empty Optional if the executable can't be serialized, e.g. because it creates a class.
+Optional<ByteBuffer> serialize_executable(Executable const&, Program const&);
+
+// Returns an empty Optional if the data is malformed, doesn't fit the program, or was written by a different
+// version or build of LibJS.
+Optional<Executable> deserialize_executable(ReadonlyBytes, Program const&);
+
+}
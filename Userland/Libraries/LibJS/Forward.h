@@ -162,6 +162,7 @@ class MarkedValueList;
 class NativeFunction;
 class ObjectEnvironment;
 class PrimitiveString;
+class Program;
 class PromiseReaction;
 class PromiseReactionJob;
 class PromiseResolveThenableJob;
@@ -181,6 +182,7 @@ class VM;
 class Value;
 class WeakContainer;
 enum class DeclarationKind;
+enum class FunctionKind;
 struct AlreadyResolved;
 struct JobCallback;
 struct PromiseCapability;
@@ -239,6 +241,7 @@ class Generator;
 class Instruction;
 class Interpreter;
 class Register;
+struct SharedExecutable;
 }
 
 }
@@ -125,6 +125,19 @@ void Heap::gather_roots(HashTable<Cell*>& roots)
     }
 }
 
+static void add_possible_value(HashTable<FlatPtr>& possible_pointers, FlatPtr data)
+{
+    if constexpr (sizeof(FlatPtr) == sizeof(Value)) {
+        // Values store cell pointers with a tag in their top bits, so a NaN-boxed cell on the stack
+        // has to be turned back into a plain pointer before it can be recognized.
+        if (Value::is_cell_encoding(data)) {
+            possible_pointers.set(Value::pointer_from_cell_encoding(data));
+            return;
+        }
+    }
+    possible_pointers.set(data);
+}
+
 __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(HashTable<Cell*>& roots)
 {
     FlatPtr dummy;
@@ -139,14 +152,14 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
     auto* raw_jmp_buf = reinterpret_cast<FlatPtr const*>(buf);
 
     for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); i += sizeof(FlatPtr))
-        possible_pointers.set(raw_jmp_buf[i]);
+        add_possible_value(possible_pointers, raw_jmp_buf[i]);
 
     auto stack_reference = bit_cast<FlatPtr>(&dummy);
     auto& stack_info = m_vm.stack_info();
 
     for (FlatPtr stack_address = stack_reference; stack_address < stack_info.top(); stack_address += sizeof(FlatPtr)) {
         auto data = *reinterpret_cast<FlatPtr*>(stack_address);
-        possible_pointers.set(data);
+        add_possible_value(possible_pointers, data);
     }
 
     HashTable<HeapBlock*> all_live_heap_blocks;
@@ -190,8 +203,19 @@ public:
         }
 
         cell.set_marked(true);
-        cell.visit_edges(*this);
+        m_work_queue.append(&cell);
     }
+
+    void mark_all_live_cells()
+    {
+        // NOTE: Cells are traced from an explicit work queue instead of recursively, since the
+        //       object graph can be arbitrarily deep (long linked lists, string ropes, etc).
+        while (!m_work_queue.is_empty())
+            m_work_queue.take_last()->visit_edges(*this);
+    }
+
+private:
+    Vector<Cell*> m_work_queue;
 };
 
 void Heap::mark_live_cells(const HashTable<Cell*>& roots)
@@ -201,6 +225,7 @@ void Heap::mark_live_cells(const HashTable<Cell*>& roots)
     MarkingVisitor visitor;
     for (auto* root : roots)
         visitor.visit(root);
+    visitor.mark_all_live_cells();
 
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
@@ -336,6 +336,7 @@ NonnullRefPtr<Program> Parser::parse_program(bool starts_in_strict_mode)
         syntax_error("Unclosed lexical_environment");
     }
     program->source_range().end = position();
+    program->set_parsed_functions(move(m_parsed_functions));
     return program;
 }
 
@@ -559,9 +560,9 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
         }
     }
 
-    return create_ast_node<FunctionExpression>(
+    return did_parse_function(create_ast_node<FunctionExpression>(
         { m_state.current_token.filename(), rule_start.position(), position() }, "", move(body),
-        move(parameters), function_length, FunctionKind::Regular, is_strict, true);
+        move(parameters), function_length, FunctionKind::Regular, is_strict, true));
 }
 
 RefPtr<Statement> Parser::try_parse_labelled_statement(AllowLabelledFunction allow_function)
@@ -1903,10 +1904,10 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u8 parse_options)
 
     scope.add_to_scope_node(body);
 
-    return create_ast_node<FunctionNodeType>(
+    return did_parse_function(create_ast_node<FunctionNodeType>(
         { m_state.current_token.filename(), rule_start.position(), position() },
         name, move(body), move(parameters), function_length,
-        is_generator ? FunctionKind::Generator : FunctionKind::Regular, is_strict);
+        is_generator ? FunctionKind::Generator : FunctionKind::Regular, is_strict));
 }
 
 Vector<FunctionNode::Parameter> Parser::parse_formal_parameters(int& function_length, u8 parse_options)
@@ -3167,6 +3168,7 @@ void Parser::load_state()
 {
     VERIFY(!m_saved_state.is_empty());
     m_state = m_saved_state.take_last();
+    m_parsed_functions.shrink(m_state.parsed_function_count);
 }
 
 void Parser::discard_saved_state()
@@ -174,6 +174,14 @@ private:
     Token consume(TokenType type);
     Token consume_and_validate_numeric_literal();
     void consume_or_insert_semicolon();
+    template<typename FunctionNodeType>
+    NonnullRefPtr<FunctionNodeType> did_parse_function(NonnullRefPtr<FunctionNodeType> function)
+    {
+        m_parsed_functions.append(function.ptr());
+        m_state.parsed_function_count = m_parsed_functions.size();
+        return function;
+    }
+
     void save_state();
     void load_state();
     void discard_saved_state();
@@ -259,6 +267,9 @@ private:
         bool string_legacy_octal_escape_sequence_in_scope { false };
         bool in_class_field_initializer { false };
 
+        // How many entries of m_parsed_functions belong to the parse so far, see did_parse_function().
+        size_t parsed_function_count { 0 };
+
         ParserState(Lexer, Program::Type);
     };
 
@@ -279,6 +290,9 @@ private:
     ParserState m_state;
     FlyString m_filename;
     Vector<ParserState> m_saved_state;
+    // Kept out of ParserState, so that saving the state doesn't copy it. Loading a state drops the
+    // functions parsed since then, so that the numbering only depends on the final AST.
+    Vector<FunctionNode const*> m_parsed_functions;
     HashMap<Position, TokenMemoization, PositionKeyTraits> m_token_memoizations;
     Program::Type m_program_type;
 };
@@ -56,6 +56,17 @@ Array::~Array()
 {
 }
 
+bool Array::has_plain_prototype_chain() const
+{
+    auto& global_object = this->global_object();
+    auto* array_prototype = global_object.array_prototype();
+    auto* object_prototype = global_object.object_prototype();
+    return internal_get_prototype_of() == array_prototype
+        && array_prototype->indexed_properties().is_empty()
+        && array_prototype->internal_get_prototype_of() == object_prototype
+        && object_prototype->indexed_properties().is_empty();
+}
+
 // 10.4.2.4 ArraySetLength ( A, Desc ), https://tc39.es/ecma262/#sec-arraysetlength
 bool Array::set_length(PropertyDescriptor const& property_descriptor)
 {
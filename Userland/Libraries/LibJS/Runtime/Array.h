@@ -44,10 +44,20 @@ public:
 
     [[nodiscard]] bool length_is_writable() const { return m_length_writable; };
 
+    // Whether the prototype chain is the initial %Array.prototype% -> %Object.prototype%, and neither of
+    // those has any indexed properties. If so, an index that isn't an own property of the array is absent,
+    // and storing to it can't call a setter, which lets fast paths work on the element storage directly.
+    bool has_plain_prototype_chain() const;
+
+    virtual bool is_array_object() const final { return true; }
+
 private:
     bool set_length(PropertyDescriptor const&);
 
     bool m_length_writable { true };
 };
 
+template<>
+inline bool Object::fast_is<Array>() const { return is_array_object(); }
+
 }
@@ -7,8 +7,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -159,6 +161,18 @@ static Object* array_species_create(GlobalObject& global_object, Object& origina
     return &result.as_object();
 }
 
+// If the element at the given index is an own data property of an array, returns its value straight out of
+// the array's element storage. Everything else has to go through HasProperty() and Get().
+static Optional<Value> fast_array_element(Object& object, size_t index)
+{
+    if (!is<Array>(object) || index >= NumericLimits<u32>::max())
+        return {};
+    auto element = object.indexed_properties().get(index);
+    if (!element.has_value() || element->value.is_empty() || element->value.is_accessor())
+        return {};
+    return element->value;
+}
+
 // 23.1.3.7 Array.prototype.filter ( callbackfn [ , thisArg ] ), https://tc39.es/ecma262/#sec-array.prototype.filter
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::filter)
 {
@@ -311,20 +325,25 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_name = PropertyName { k };
 
+        // NOTE: The callback may change the array in any way, so this is checked for every element.
+        auto k_value = fast_array_element(*object, k);
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = object->has_property(property_name);
+        auto k_present = k_value.has_value() || object->has_property(property_name);
         if (vm.exception())
             return {};
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = object->get(property_name);
-            if (vm.exception())
-                return {};
+            if (!k_value.has_value()) {
+                k_value = object->get(property_name);
+                if (vm.exception())
+                    return {};
+            }
 
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
-            auto mapped_value = vm.call(callback_function.as_function(), this_arg, k_value, Value(k), object);
+            auto mapped_value = vm.call(callback_function.as_function(), this_arg, *k_value, Value(k), object);
             if (vm.exception())
                 return {};
 
@@ -347,6 +366,20 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
     auto* this_object = vm.this_value(global_object).to_object(global_object);
     if (!this_object)
         return {};
+
+    // Fast path: Nothing can observe new elements being appended to an extensible array with a writable length,
+    // as long as its prototype chain has no indexed properties.
+    if (is<Array>(*this_object)) {
+        auto& array = static_cast<Array&>(*this_object);
+        auto& indexed_properties = array.indexed_properties();
+        if (array.is_extensible() && array.length_is_writable() && array.has_plain_prototype_chain()
+            && indexed_properties.array_like_size() + vm.argument_count() < NumericLimits<u32>::max()) {
+            for (size_t i = 0; i < vm.argument_count(); ++i)
+                indexed_properties.append(vm.argument(i));
+            return Value(indexed_properties.array_like_size());
+        }
+    }
+
     auto length = TRY_OR_DISCARD(length_of_array_like(global_object, *this_object));
     auto argument_count = vm.argument_count();
     auto new_length = length + argument_count;
@@ -797,6 +830,32 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // Fast path: Elements missing from the array's own storage are absent, so strictly comparing what's
+    // in the storage is all that's needed. Unlike the loop below, this has no side effects.
+    if (is<Array>(*object) && static_cast<Array&>(*object).has_plain_prototype_chain()) {
+        auto& indexed_properties = object->indexed_properties();
+        if (auto* storage = indexed_properties.packed_int32_storage()) {
+            // NOTE: -0 is the only number that is strictly equal to an int32 without being stored as one.
+            if (!search_element.is_int32() && !search_element.is_negative_zero())
+                return Value(-1);
+            auto search_int32 = search_element.is_int32() ? search_element.as_i32() : 0;
+            auto const& elements = storage->elements();
+            for (auto end = min(length, elements.size()); k < end; ++k) {
+                if (elements[k] == search_int32)
+                    return Value(k);
+            }
+            return Value(-1);
+        }
+        if (auto* storage = indexed_properties.simple_storage()) {
+            auto const& elements = storage->elements();
+            for (auto end = min(length, elements.size()); k < end; ++k) {
+                if (!elements[k].is_empty() && strict_eq(search_element, elements[k]))
+                    return Value(k);
+            }
+            return Value(-1);
+        }
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_name = PropertyName { k };
@@ -1210,6 +1269,11 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 
     MarkedValueList items(vm.heap());
     for (size_t k = 0; k < length; ++k) {
+        if (auto k_value = fast_array_element(*object, k); k_value.has_value()) {
+            items.append(*k_value);
+            continue;
+        }
+
         auto k_present = object->has_property(k);
         if (vm.exception())
             return {};
@@ -1223,14 +1287,30 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
         }
     }
 
-    // Perform sorting by merge sort. This isn't as efficient compared to quick sort, but
-    // quicksort can't be used in all cases because the spec requires Array.prototype.sort()
-    // to be stable. FIXME: when initially scanning through the array, maintain a flag
-    // for if an unstable sort would be indistinguishable from a stable sort (such as just
-    // just strings or numbers), and in that case use quick sort instead for better performance.
-    array_merge_sort(vm, global_object, callback.is_undefined() ? nullptr : &callback.as_function(), items);
-    if (vm.exception())
-        return {};
+    if (callback.is_undefined() && all_of(items, [](auto const& item) { return item.is_int32(); })) {
+        // Fast path: Without a compare function, int32s are sorted by their string representations, which can be
+        // computed once up front. Two int32s only have the same string if they are equal, so stability doesn't matter.
+        struct Int32WithString {
+            i32 value;
+            String string;
+        };
+        Vector<Int32WithString> int32s;
+        int32s.ensure_capacity(items.size());
+        for (auto const& item : items)
+            int32s.unchecked_append({ item.as_i32(), String::number(item.as_i32()) });
+        quick_sort(int32s, [](auto const& a, auto const& b) { return a.string < b.string; });
+        for (size_t i = 0; i < items.size(); ++i)
+            items[i] = Value(int32s[i].value);
+    } else {
+        // Perform sorting by merge sort. This isn't as efficient compared to quick sort, but
+        // quicksort can't be used in all cases because the spec requires Array.prototype.sort()
+        // to be stable. FIXME: when initially scanning through the array, maintain a flag
+        // for if an unstable sort would be indistinguishable from a stable sort (such as just
+        // just strings or numbers), and in that case use quick sort instead for better performance.
+        array_merge_sort(vm, global_object, callback.is_undefined() ? nullptr : &callback.as_function(), items);
+        if (vm.exception())
+            return {};
+    }
 
     for (size_t j = 0; j < items.size(); ++j) {
         object->set(j, items[j], Object::ShouldThrowExceptions::Yes);
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/QuickSort.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/IndexedProperties.h>
@@ -13,12 +14,69 @@ namespace JS {
 constexpr const size_t SPARSE_ARRAY_HOLE_THRESHOLD = 200;
 constexpr const size_t LENGTH_SETTER_GENERIC_STORAGE_THRESHOLD = 4 * MiB;
 
+PackedInt32IndexedPropertyStorage::PackedInt32IndexedPropertyStorage(Vector<i32>&& initial_elements)
+    : m_elements(move(initial_elements))
+{
+}
+
+Optional<ValueAndAttributes> PackedInt32IndexedPropertyStorage::get(u32 index) const
+{
+    if (index >= m_elements.size())
+        return {};
+    return ValueAndAttributes { Value(m_elements[index]), default_attributes };
+}
+
+void PackedInt32IndexedPropertyStorage::put(u32 index, Value value, PropertyAttributes attributes)
+{
+    VERIFY(attributes == default_attributes);
+    VERIFY(can_store(value));
+    VERIFY(index <= m_elements.size());
+
+    if (index == m_elements.size())
+        m_elements.append(value.as_i32());
+    else
+        m_elements[index] = value.as_i32();
+}
+
+void PackedInt32IndexedPropertyStorage::remove(u32)
+{
+    // NOTE: Removing an element leaves a hole, which this storage can't represent.
+    //       IndexedProperties switches to simple storage before removing anything.
+    VERIFY_NOT_REACHED();
+}
+
+ValueAndAttributes PackedInt32IndexedPropertyStorage::take_first()
+{
+    return { Value(m_elements.take_first()), default_attributes };
+}
+
+ValueAndAttributes PackedInt32IndexedPropertyStorage::take_last()
+{
+    return { Value(m_elements.take_last()), default_attributes };
+}
+
+bool PackedInt32IndexedPropertyStorage::set_array_like_size(size_t new_size)
+{
+    // NOTE: Growing the array would leave holes, see remove().
+    VERIFY(new_size <= m_elements.size());
+    m_elements.shrink(new_size);
+    return true;
+}
+
 SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initial_values)
     : m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
 }
 
+SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(PackedInt32IndexedPropertyStorage&& storage)
+    : m_array_size(storage.m_elements.size())
+{
+    m_packed_elements.ensure_capacity(storage.m_elements.size());
+    for (auto element : storage.m_elements)
+        m_packed_elements.unchecked_append(Value(element));
+}
+
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
 {
     return index < m_array_size && !m_packed_elements[index].is_empty();
@@ -213,6 +271,20 @@ void IndexedPropertyIterator::skip_empty_indices()
     m_index = m_indexed_properties.array_like_size();
 }
 
+IndexedProperties::IndexedProperties(Vector<Value> values)
+{
+    if (!all_of(values, PackedInt32IndexedPropertyStorage::can_store)) {
+        m_storage = make<SimpleIndexedPropertyStorage>(move(values));
+        return;
+    }
+
+    Vector<i32> elements;
+    elements.ensure_capacity(values.size());
+    for (auto value : values)
+        elements.unchecked_append(value.as_i32());
+    m_storage = make<PackedInt32IndexedPropertyStorage>(move(elements));
+}
+
 Optional<ValueAndAttributes> IndexedProperties::get(u32 index) const
 {
     return m_storage->get(index);
@@ -220,6 +292,9 @@ Optional<ValueAndAttributes> IndexedProperties::get(u32 index) const
 
 void IndexedProperties::put(u32 index, Value value, PropertyAttributes attributes)
 {
+    if (m_storage->is_packed_int32_storage() && (attributes != default_attributes || !PackedInt32IndexedPropertyStorage::can_store(value) || index > array_like_size()))
+        switch_to_simple_storage();
+
     if (m_storage->is_simple_storage() && (attributes != default_attributes || index > (array_like_size() + SPARSE_ARRAY_HOLE_THRESHOLD))) {
         switch_to_generic_storage();
     }
@@ -230,6 +305,8 @@ void IndexedProperties::put(u32 index, Value value, PropertyAttributes attribute
 void IndexedProperties::remove(u32 index)
 {
     VERIFY(m_storage->has_index(index));
+    if (m_storage->is_packed_int32_storage())
+        switch_to_simple_storage();
     m_storage->remove(index);
 }
 
@@ -253,6 +330,9 @@ bool IndexedProperties::set_array_like_size(size_t new_size)
 {
     auto current_array_like_size = array_like_size();
 
+    if (m_storage->is_packed_int32_storage() && new_size > current_array_like_size)
+        switch_to_simple_storage();
+
     // We can't use simple storage for lengths that don't fit in an i32.
     // Also, to avoid gigantic unused storage allocations, let's put an (arbitrary) 4M cap on simple storage here.
     // This prevents something like "a = []; a.length = 0x80000000;" from allocating 2G entries.
@@ -267,6 +347,8 @@ bool IndexedProperties::set_array_like_size(size_t new_size)
 
 size_t IndexedProperties::real_size() const
 {
+    if (m_storage->is_packed_int32_storage())
+        return m_storage->size();
     if (m_storage->is_simple_storage()) {
         auto& packed_elements = static_cast<const SimpleIndexedPropertyStorage&>(*m_storage).elements();
         size_t size = 0;
@@ -281,6 +363,13 @@ size_t IndexedProperties::real_size() const
 
 Vector<u32> IndexedProperties::indices() const
 {
+    if (m_storage->is_packed_int32_storage()) {
+        Vector<u32> indices;
+        indices.ensure_capacity(m_storage->size());
+        for (size_t i = 0; i < m_storage->size(); ++i)
+            indices.unchecked_append(i);
+        return indices;
+    }
     if (m_storage->is_simple_storage()) {
         const auto& storage = static_cast<const SimpleIndexedPropertyStorage&>(*m_storage);
         const auto& elements = storage.elements();
@@ -298,6 +387,12 @@ Vector<u32> IndexedProperties::indices() const
     return indices;
 }
 
+void IndexedProperties::switch_to_simple_storage()
+{
+    auto& storage = static_cast<PackedInt32IndexedPropertyStorage&>(*m_storage);
+    m_storage = make<SimpleIndexedPropertyStorage>(move(storage));
+}
+
 void IndexedProperties::switch_to_generic_storage()
 {
     auto& storage = static_cast<SimpleIndexedPropertyStorage&>(*m_storage);
@@ -19,6 +19,7 @@ struct ValueAndAttributes {
 
 class IndexedProperties;
 class IndexedPropertyIterator;
+class SimpleIndexedPropertyStorage;
 class GenericIndexedPropertyStorage;
 
 class IndexedPropertyStorage {
@@ -37,13 +38,46 @@ public:
     virtual size_t array_like_size() const = 0;
     virtual bool set_array_like_size(size_t new_size) = 0;
 
+    virtual bool is_packed_int32_storage() const { return false; }
     virtual bool is_simple_storage() const { return false; }
 };
 
+// Stores elements that are all int32 numbers, without any holes, in half the space of a Vector<Value>.
+// IndexedProperties switches to simple storage before putting anything else in here.
+class PackedInt32IndexedPropertyStorage final : public IndexedPropertyStorage {
+public:
+    PackedInt32IndexedPropertyStorage() = default;
+    explicit PackedInt32IndexedPropertyStorage(Vector<i32>&& initial_elements);
+
+    static bool can_store(Value value) { return value.is_int32(); }
+
+    virtual bool has_index(u32 index) const override { return index < m_elements.size(); }
+    virtual Optional<ValueAndAttributes> get(u32 index) const override;
+    virtual void put(u32 index, Value value, PropertyAttributes attributes = default_attributes) override;
+    virtual void remove(u32 index) override;
+
+    virtual ValueAndAttributes take_first() override;
+    virtual ValueAndAttributes take_last() override;
+
+    virtual size_t size() const override { return m_elements.size(); }
+    virtual size_t array_like_size() const override { return m_elements.size(); }
+    virtual bool set_array_like_size(size_t new_size) override;
+
+    virtual bool is_packed_int32_storage() const override { return true; }
+    Vector<i32> const& elements() const { return m_elements; }
+    Vector<i32>& elements() { return m_elements; }
+
+private:
+    friend SimpleIndexedPropertyStorage;
+
+    Vector<i32> m_elements;
+};
+
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
     SimpleIndexedPropertyStorage() = default;
     explicit SimpleIndexedPropertyStorage(Vector<Value>&& initial_values);
+    explicit SimpleIndexedPropertyStorage(PackedInt32IndexedPropertyStorage&&);
 
     virtual bool has_index(u32 index) const override;
     virtual Optional<ValueAndAttributes> get(u32 index) const override;
@@ -59,6 +93,7 @@ public:
 
     virtual bool is_simple_storage() const override { return true; }
     const Vector<Value>& elements() const { return m_packed_elements; }
+    Vector<Value>& elements() { return m_packed_elements; }
 
 private:
     friend GenericIndexedPropertyStorage;
@@ -114,10 +149,7 @@ class IndexedProperties {
 public:
     IndexedProperties() = default;
 
-    explicit IndexedProperties(Vector<Value> values)
-        : m_storage(make<SimpleIndexedPropertyStorage>(move(values)))
-    {
-    }
+    explicit IndexedProperties(Vector<Value> values);
 
     bool has_index(u32 index) const { return m_storage->has_index(index); }
     Optional<ValueAndAttributes> get(u32 index) const;
@@ -140,10 +172,19 @@ public:
 
     Vector<u32> indices() const;
 
+    // Direct access to the elements for fast paths, if they are stored in the given kind of storage.
+    PackedInt32IndexedPropertyStorage* packed_int32_storage() { return m_storage->is_packed_int32_storage() ? static_cast<PackedInt32IndexedPropertyStorage*>(m_storage.ptr()) : nullptr; }
+    SimpleIndexedPropertyStorage* simple_storage() { return m_storage->is_simple_storage() ? static_cast<SimpleIndexedPropertyStorage*>(m_storage.ptr()) : nullptr; }
+
     template<typename Callback>
     void for_each_value(Callback callback)
     {
-        if (m_storage->is_simple_storage()) {
+        if (m_storage->is_packed_int32_storage()) {
+            for (auto element : static_cast<PackedInt32IndexedPropertyStorage&>(*m_storage).elements()) {
+                Value value(element);
+                callback(value);
+            }
+        } else if (m_storage->is_simple_storage()) {
             for (auto& value : static_cast<SimpleIndexedPropertyStorage&>(*m_storage).elements())
                 callback(value);
         } else {
@@ -153,9 +194,10 @@ public:
     }
 
 private:
+    void switch_to_simple_storage();
     void switch_to_generic_storage();
 
-    NonnullOwnPtr<IndexedPropertyStorage> m_storage { make<SimpleIndexedPropertyStorage>() };
+    NonnullOwnPtr<IndexedPropertyStorage> m_storage { make<PackedInt32IndexedPropertyStorage>() };
 };
 
 }
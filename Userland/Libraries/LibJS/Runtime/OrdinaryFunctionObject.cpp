@@ -181,18 +181,15 @@ Value OrdinaryFunctionObject::execute_function_body()
 
     if (bytecode_interpreter) {
         prepare_arguments();
-        if (!m_bytecode_executable.has_value()) {
-            m_bytecode_executable = Bytecode::Generator::generate(m_body, m_kind == FunctionKind::Generator);
-            auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
-            passes.perform(*m_bytecode_executable);
+        if (!m_bytecode_executable) {
+            m_bytecode_executable = adopt_ref(*new Bytecode::SharedExecutable(Bytecode::Interpreter::compile_function_body(m_body, m_kind)));
             if constexpr (JS_BYTECODE_DEBUG) {
-                dbgln("Optimisation passes took {}us", passes.elapsed());
                 dbgln("Compiled Bytecode::Block for function '{}':", m_name);
-                for (auto& block : m_bytecode_executable->basic_blocks)
-                    block.dump(*m_bytecode_executable);
+                for (auto& block : m_bytecode_executable->executable.basic_blocks)
+                    block.dump(m_bytecode_executable->executable);
             }
         }
-        auto result = bytecode_interpreter->run(*m_bytecode_executable);
+        auto result = bytecode_interpreter->run(m_bytecode_executable->executable);
         if (m_kind != FunctionKind::Generator)
             return result;
 
@@ -33,7 +33,8 @@ public:
 
     void set_is_class_constructor() { m_is_class_constructor = true; };
 
-    auto& bytecode_executable() const { return m_bytecode_executable; }
+    Bytecode::Executable const* bytecode_executable() const { return m_bytecode_executable ? &m_bytecode_executable->executable : nullptr; }
+    void set_bytecode_executable(Bytecode::SharedExecutable& executable) { m_bytecode_executable = executable; }
 
     virtual Environment* environment() override { return m_environment; }
     virtual Realm* realm() const override { return m_realm; }
@@ -51,7 +52,7 @@ private:
     FlyString m_name;
     NonnullRefPtr<Statement> m_body;
     const Vector<FunctionNode::Parameter> m_parameters;
-    Optional<Bytecode::Executable> m_bytecode_executable;
+    RefPtr<Bytecode::SharedExecutable> m_bytecode_executable;
     Environment* m_environment { nullptr };
     Realm* m_realm { nullptr };
     i32 m_function_length { 0 };
@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/CharacterTypes.h>
+#include <AK/StringBuilder.h>
 #include <AK/Utf16View.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/VM.h>
@@ -23,12 +25,40 @@ PrimitiveString::PrimitiveString(Utf16String string)
 {
 }
 
+PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
+    : m_is_rope(true)
+    , m_lhs(&lhs)
+    , m_rhs(&rhs)
+{
+}
+
 PrimitiveString::~PrimitiveString()
 {
 }
 
+void PrimitiveString::visit_edges(Cell::Visitor& visitor)
+{
+    Cell::visit_edges(visitor);
+    if (m_is_rope) {
+        visitor.visit(m_lhs);
+        visitor.visit(m_rhs);
+    }
+}
+
+bool PrimitiveString::is_empty() const
+{
+    if (m_is_rope) {
+        // NOTE: We never make a rope from an empty string, so ropes can't be empty.
+        return false;
+    }
+    if (m_has_utf16_string)
+        return m_utf16_string.is_empty();
+    return m_utf8_string.is_empty();
+}
+
 String const& PrimitiveString::string() const
 {
+    resolve_rope_if_needed();
     if (!m_has_utf8_string) {
         m_utf8_string = m_utf16_string.to_utf8();
         m_has_utf8_string = true;
@@ -38,6 +68,7 @@ String const& PrimitiveString::string() const
 
 Utf16String const& PrimitiveString::utf16_string() const
 {
+    resolve_rope_if_needed();
     if (!m_has_utf16_string) {
         m_utf16_string = Utf16String(m_utf8_string);
         m_has_utf16_string = true;
@@ -50,6 +81,60 @@ Utf16View PrimitiveString::utf16_string_view() const
     return utf16_string().view();
 }
 
+void PrimitiveString::resolve_rope_if_needed() const
+{
+    if (!m_is_rope)
+        return;
+
+    // Collect the leaves of the rope in order. Ropes built by appending in a loop are
+    // very deep and lean to the left, so this must not recurse.
+    Vector<PrimitiveString const*> pieces;
+    Vector<PrimitiveString const*> stack;
+    stack.append(m_rhs);
+    stack.append(m_lhs);
+    while (!stack.is_empty()) {
+        auto const* current = stack.take_last();
+        if (current->m_is_rope) {
+            stack.append(current->m_rhs);
+            stack.append(current->m_lhs);
+            continue;
+        }
+        pieces.append(current);
+    }
+
+    // Only build a UTF-8 string if every piece already has one. A UTF-16 piece may contain a lone
+    // surrogate that pairs up with one in a neighboring piece, which UTF-8 can't represent.
+    bool all_pieces_have_utf8 = all_of(pieces, [](auto const* piece) { return piece->has_utf8_string(); });
+    if (!all_pieces_have_utf8) {
+        size_t length_in_code_units = 0;
+        for (auto const* piece : pieces)
+            length_in_code_units += piece->utf16_string().length_in_code_units();
+
+        Vector<u16> code_units;
+        code_units.ensure_capacity(length_in_code_units);
+        for (auto const* piece : pieces)
+            code_units.extend(piece->utf16_string().string());
+
+        m_utf16_string = Utf16String(move(code_units));
+        m_has_utf16_string = true;
+    } else {
+        size_t length = 0;
+        for (auto const* piece : pieces)
+            length += piece->string().length();
+
+        StringBuilder builder(length);
+        for (auto const* piece : pieces)
+            builder.append(piece->string());
+
+        m_utf8_string = builder.to_string();
+        m_has_utf8_string = true;
+    }
+
+    m_is_rope = false;
+    m_lhs = nullptr;
+    m_rhs = nullptr;
+}
+
 PrimitiveString* js_string(Heap& heap, Utf16View const& view)
 {
     return js_string(heap, Utf16String(view));
@@ -98,4 +183,13 @@ PrimitiveString* js_string(VM& vm, String string)
     return js_string(vm.heap(), move(string));
 }
 
+PrimitiveString* js_rope_string(VM& vm, PrimitiveString& lhs, PrimitiveString& rhs)
+{
+    if (lhs.is_empty())
+        return &rhs;
+    if (rhs.is_empty())
+        return &lhs;
+    return vm.heap().allocate_without_global_object<PrimitiveString>(lhs, rhs);
+}
+
 }
@@ -16,11 +16,14 @@ class PrimitiveString final : public Cell {
 public:
     explicit PrimitiveString(String);
     explicit PrimitiveString(Utf16String);
+    PrimitiveString(PrimitiveString&, PrimitiveString&);
     virtual ~PrimitiveString();
 
     PrimitiveString(PrimitiveString const&) = delete;
     PrimitiveString& operator=(PrimitiveString const&) = delete;
 
+    bool is_empty() const;
+
     String const& string() const;
     bool has_utf8_string() const { return m_has_utf8_string; }
 
@@ -30,6 +33,15 @@ public:
 
 private:
     virtual const char* class_name() const override { return "PrimitiveString"; }
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    void resolve_rope_if_needed() const;
+
+    // A rope is the lazy concatenation of two strings. It is flattened into a regular string the
+    // first time its contents are needed, after which the references to its halves are dropped.
+    mutable bool m_is_rope { false };
+    mutable PrimitiveString* m_lhs { nullptr };
+    mutable PrimitiveString* m_rhs { nullptr };
 
     mutable String m_utf8_string;
     mutable bool m_has_utf8_string { false };
@@ -47,4 +59,6 @@ PrimitiveString* js_string(VM&, Utf16String);
 PrimitiveString* js_string(Heap&, String);
 PrimitiveString* js_string(VM&, String);
 
+PrimitiveString* js_rope_string(VM&, PrimitiveString&, PrimitiveString&);
+
 }
@@ -16,13 +16,23 @@ Shape* Shape::create_unique_clone() const
     auto* new_shape = heap().allocate_without_global_object<Shape>(*m_global_object);
     new_shape->m_unique = true;
     new_shape->m_prototype = m_prototype;
-    ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = copy_of_property_table();
+    new_shape->m_property_count = m_property_count;
     return new_shape;
 }
 
+NonnullRefPtr<PropertyTable> Shape::copy_of_property_table() const
+{
+    ensure_property_table();
+    auto table = adopt_ref(*new PropertyTable);
+    table->entries.ensure_capacity(m_property_count);
+    for (auto& it : m_property_table->entries) {
+        if (it.value.offset < m_property_count)
+            table->entries.set(it.key, it.value);
+    }
+    return table;
+}
+
 Shape* Shape::get_or_prune_cached_forward_transition(TransitionKey const& key)
 {
     auto it = m_forward_transitions.find(key);
@@ -101,8 +111,9 @@ void Shape::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_prototype);
     visitor.visit(m_previous);
     m_property_name.visit_edges(visitor);
+    // NOTE: This also visits the keys of descendant shapes sharing the table, which keeps them valid for as long as the table is.
     if (m_property_table) {
-        for (auto& it : *m_property_table)
+        for (auto& it : m_property_table->entries)
             it.key.visit_edges(visitor);
     }
 }
@@ -111,18 +122,13 @@ Optional<PropertyMetadata> Shape::lookup(const StringOrSymbol& property_name) co
 {
     if (m_property_count == 0)
         return {};
-    auto property = property_table().get(property_name);
-    if (!property.has_value())
+    ensure_property_table();
+    auto property = m_property_table->entries.get(property_name);
+    if (!property.has_value() || property->offset >= m_property_count)
         return {};
     return property;
 }
 
-FLATTEN HashMap<StringOrSymbol, PropertyMetadata> const& Shape::property_table() const
-{
-    ensure_property_table();
-    return *m_property_table;
-}
-
 size_t Shape::property_count() const
 {
     return m_property_count;
@@ -133,86 +139,124 @@ Vector<Shape::Property> Shape::property_table_ordered() const
     auto vec = Vector<Shape::Property>();
     vec.resize(property_count());
 
-    for (auto& it : property_table()) {
-        vec[it.value.offset] = { it.key, it.value };
+    ensure_property_table();
+    for (auto& it : m_property_table->entries) {
+        if (it.value.offset < m_property_count)
+            vec[it.value.offset] = { it.key, it.value };
     }
 
     return vec;
 }
 
+size_t Shape::property_table_memory_usage() const
+{
+    if (!m_property_table)
+        return 0;
+    auto table_size = sizeof(PropertyTable) + m_property_table->entries.capacity() * (sizeof(StringOrSymbol) + sizeof(PropertyMetadata));
+    return table_size / m_property_table->ref_count();
+}
+
 void Shape::ensure_property_table() const
 {
     if (m_property_table)
         return;
-    m_property_table = make<HashMap<StringOrSymbol, PropertyMetadata>>();
-
-    u32 next_offset = 0;
 
     Vector<const Shape*, 64> transition_chain;
-    for (auto* shape = m_previous; shape; shape = shape->m_previous) {
+    const Shape* shape_with_table = nullptr;
+    for (auto* shape = this; shape; shape = shape->m_previous) {
         if (shape->m_property_table) {
-            *m_property_table = *shape->m_property_table;
-            next_offset = shape->m_property_count;
+            shape_with_table = shape;
             break;
         }
         transition_chain.append(shape);
     }
-    transition_chain.append(this);
+
+    // We can keep appending to the table we found as long as nobody else has appended to it yet,
+    // and none of the transitions in between changes the attributes of an existing property.
+    bool can_share_table = !shape_with_table || shape_with_table->m_property_table->entries.size() == shape_with_table->m_property_count;
+    for (auto* shape : transition_chain) {
+        if (shape->m_transition_type == TransitionType::Configure)
+            can_share_table = false;
+    }
+
+    RefPtr<PropertyTable> table;
+    if (!shape_with_table)
+        table = adopt_ref(*new PropertyTable);
+    else if (can_share_table)
+        table = shape_with_table->m_property_table;
+    else
+        table = shape_with_table->copy_of_property_table();
+
+    u32 next_offset = shape_with_table ? shape_with_table->m_property_count : 0;
 
     for (ssize_t i = transition_chain.size() - 1; i >= 0; --i) {
         auto* shape = transition_chain[i];
-        if (!shape->m_property_name.is_valid()) {
-            // Ignore prototype transitions as they don't affect the key map.
-            continue;
-        }
-        if (shape->m_transition_type == TransitionType::Put) {
-            m_property_table->set(shape->m_property_name, { next_offset++, shape->m_attributes });
-        } else if (shape->m_transition_type == TransitionType::Configure) {
-            auto it = m_property_table->find(shape->m_property_name);
-            VERIFY(it != m_property_table->end());
-            it->value.attributes = shape->m_attributes;
+        if (shape->m_property_name.is_valid()) {
+            // Prototype transitions don't affect the key map.
+            if (shape->m_transition_type == TransitionType::Put) {
+                table->entries.set(shape->m_property_name, { next_offset++, shape->m_attributes });
+            } else if (shape->m_transition_type == TransitionType::Configure) {
+                auto it = table->entries.find(shape->m_property_name);
+                VERIFY(it != table->entries.end());
+                it->value.attributes = shape->m_attributes;
+            }
         }
+        if (can_share_table)
+            shape->m_property_table = table;
     }
+
+    m_property_table = move(table);
+}
+
+void Shape::ensure_property_table_is_not_shared_with_descendants()
+{
+    ensure_property_table();
+    if (m_property_table->entries.size() != m_property_count)
+        m_property_table = copy_of_property_table();
 }
 
 void Shape::add_property_to_unique_shape(const StringOrSymbol& property_name, PropertyAttributes attributes)
 {
     VERIFY(is_unique());
     VERIFY(m_property_table);
-    VERIFY(!m_property_table->contains(property_name));
-    m_property_table->set(property_name, { m_property_table->size(), attributes });
+    VERIFY(!m_property_table->entries.contains(property_name));
+    m_property_table->entries.set(property_name, { m_property_table->entries.size(), attributes });
     ++m_property_count;
+    ++m_unique_shape_serial_number;
 }
 
 void Shape::reconfigure_property_in_unique_shape(const StringOrSymbol& property_name, PropertyAttributes attributes)
 {
     VERIFY(is_unique());
     VERIFY(m_property_table);
-    auto it = m_property_table->find(property_name);
-    VERIFY(it != m_property_table->end());
+    auto it = m_property_table->entries.find(property_name);
+    VERIFY(it != m_property_table->entries.end());
     it->value.attributes = attributes;
-    m_property_table->set(property_name, it->value);
+    m_property_table->entries.set(property_name, it->value);
+    ++m_unique_shape_serial_number;
 }
 
 void Shape::remove_property_from_unique_shape(const StringOrSymbol& property_name, size_t offset)
 {
     VERIFY(is_unique());
     VERIFY(m_property_table);
-    if (m_property_table->remove(property_name))
+    if (m_property_table->entries.remove(property_name))
         --m_property_count;
-    for (auto& it : *m_property_table) {
+    for (auto& it : m_property_table->entries) {
         VERIFY(it.value.offset != offset);
         if (it.value.offset > offset)
             --it.value.offset;
     }
+    ++m_unique_shape_serial_number;
 }
 
 void Shape::add_property_without_transition(StringOrSymbol const& property_name, PropertyAttributes attributes)
 {
     VERIFY(property_name.is_valid());
-    ensure_property_table();
-    if (m_property_table->set(property_name, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry)
+    ensure_property_table_is_not_shared_with_descendants();
+    if (m_property_table->entries.set(property_name, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry)
         ++m_property_count;
+    ++m_unique_shape_serial_number;
 }
 
 FLATTEN void Shape::add_property_without_transition(PropertyName const& property_name, PropertyAttributes attributes)
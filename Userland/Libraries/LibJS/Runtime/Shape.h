@@ -8,6 +8,8 @@
 
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
 #include <AK/WeakPtr.h>
 #include <AK/Weakable.h>
 #include <LibJS/Forward.h>
@@ -23,6 +25,12 @@ struct PropertyMetadata {
     PropertyAttributes attributes { 0 };
 };
 
+// Put transitions only ever append properties, so all the shapes along a chain of them can share one table.
+// Each shape only sees the entries whose offset is below its own property count.
+struct PropertyTable : public RefCounted<PropertyTable> {
+    HashMap<StringOrSymbol, PropertyMetadata> entries;
+};
+
 struct TransitionKey {
     StringOrSymbol property_name;
     PropertyAttributes attributes { 0 };
@@ -60,16 +68,21 @@ public:
     void add_property_without_transition(const StringOrSymbol&, PropertyAttributes);
     void add_property_without_transition(PropertyName const&, PropertyAttributes);
 
+    // A unique shape belongs to a single object and is mutated in place instead of transitioning (a.k.a. dictionary mode).
+    // Objects switch to one once they have many properties, or when a property is deleted.
     bool is_unique() const { return m_unique; }
     Shape* create_unique_clone() const;
 
+    // Bumped whenever this shape's property table is mutated in place (instead of through a transition),
+    // so that caches keyed on the shape's identity can tell that their cached offsets are stale.
+    u32 unique_shape_serial_number() const { return m_unique_shape_serial_number; }
+
     GlobalObject* global_object() const;
 
     Object* prototype() { return m_prototype; }
     const Object* prototype() const { return m_prototype; }
 
     Optional<PropertyMetadata> lookup(const StringOrSymbol&) const;
-    const HashMap<StringOrSymbol, PropertyMetadata>& property_table() const;
     size_t property_count() const;
 
     struct Property {
@@ -79,6 +92,9 @@ public:
 
     Vector<Property> property_table_ordered() const;
 
+    // The bytes of property table this shape accounts for. A table shared by several shapes is split evenly among them.
+    size_t property_table_memory_usage() const;
+
     void set_prototype_without_transition(Object* new_prototype) { m_prototype = new_prototype; }
 
     void remove_property_from_unique_shape(const StringOrSymbol&, size_t offset);
@@ -92,14 +108,18 @@ private:
 
     Shape* get_or_prune_cached_forward_transition(TransitionKey const&);
     void ensure_property_table() const;
+    void ensure_property_table_is_not_shared_with_descendants();
+    NonnullRefPtr<PropertyTable> copy_of_property_table() const;
 
     PropertyAttributes m_attributes { 0 };
     TransitionType m_transition_type : 6 { TransitionType::Invalid };
     bool m_unique : 1 { false };
 
+    u32 m_unique_shape_serial_number { 0 };
+
     Object* m_global_object { nullptr };
 
-    mutable OwnPtr<HashMap<StringOrSymbol, PropertyMetadata>> m_property_table;
+    mutable RefPtr<PropertyTable> m_property_table;
 
     HashMap<TransitionKey, WeakPtr<Shape>> m_forward_transitions;
     Shape* m_previous { nullptr };
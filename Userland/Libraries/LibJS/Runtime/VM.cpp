@@ -298,7 +298,7 @@ void VM::assign(const NonnullRefPtr<BindingPattern>& target, Value value, Global
                 assignment_name = property.name.get<NonnullRefPtr<Identifier>>()->string();
 
                 auto* rest_object = Object::create(global_object, global_object.object_prototype());
-                for (auto& object_property : object->shape().property_table()) {
+                for (auto& object_property : object->shape().property_table_ordered()) {
                     if (!object_property.value.attributes.is_enumerable())
                         continue;
                     if (seen_names.contains(object_property.key.to_display_string()))
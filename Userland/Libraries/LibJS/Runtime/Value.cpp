@@ -214,7 +214,7 @@ bool Value::is_array(GlobalObject& global_object) const
 Array& Value::as_array()
 {
     VERIFY(is_object() && is<Array>(as_object()));
-    return static_cast<Array&>(*m_value.as_object);
+    return static_cast<Array&>(*extract_pointer<Object>());
 }
 
 // 7.2.3 IsCallable ( argument ), https://tc39.es/ecma262/#sec-iscallable
@@ -261,7 +261,7 @@ bool Value::is_regexp(GlobalObject& global_object) const
 // 13.5.3 The typeof Operator, https://tc39.es/ecma262/#sec-typeof-operator
 String Value::typeof() const
 {
-    switch (m_type) {
+    switch (type()) {
     case Value::Type::Undefined:
         return "undefined";
     case Value::Type::Null:
@@ -291,23 +291,23 @@ String Value::typeof() const
 
 String Value::to_string_without_side_effects() const
 {
-    switch (m_type) {
+    switch (type()) {
     case Type::Undefined:
         return "undefined";
     case Type::Null:
         return "null";
     case Type::Boolean:
-        return m_value.as_bool ? "true" : "false";
+        return as_bool() ? "true" : "false";
     case Type::Int32:
-        return String::number(m_value.as_i32);
+        return String::number(unboxed_i32());
     case Type::Double:
-        return double_to_string(m_value.as_double);
+        return double_to_string(unboxed_double());
     case Type::String:
-        return m_value.as_string->string();
+        return extract_pointer<PrimitiveString>()->string();
     case Type::Symbol:
-        return m_value.as_symbol->to_string();
+        return extract_pointer<Symbol>()->to_string();
     case Type::BigInt:
-        return m_value.as_bigint->to_string();
+        return extract_pointer<BigInt>()->to_string();
     case Type::Object:
         return String::formatted("[object {}]", as_object().class_name());
     case Type::Accessor:
@@ -330,24 +330,24 @@ PrimitiveString* Value::to_primitive_string(GlobalObject& global_object)
 // 7.1.17 ToString ( argument ), https://tc39.es/ecma262/#sec-tostring
 String Value::to_string(GlobalObject& global_object, bool legacy_null_to_empty_string) const
 {
-    switch (m_type) {
+    switch (type()) {
     case Type::Undefined:
         return "undefined";
     case Type::Null:
         return !legacy_null_to_empty_string ? "null" : String::empty();
     case Type::Boolean:
-        return m_value.as_bool ? "true" : "false";
+        return as_bool() ? "true" : "false";
     case Type::Int32:
-        return String::number(m_value.as_i32);
+        return String::number(unboxed_i32());
     case Type::Double:
-        return double_to_string(m_value.as_double);
+        return double_to_string(unboxed_double());
     case Type::String:
-        return m_value.as_string->string();
+        return extract_pointer<PrimitiveString>()->string();
     case Type::Symbol:
         global_object.vm().throw_exception<TypeError>(global_object, ErrorType::Convert, "symbol", "string");
         return {};
     case Type::BigInt:
-        return m_value.as_bigint->big_integer().to_base(10);
+        return extract_pointer<BigInt>()->big_integer().to_base(10);
     case Type::Object: {
         auto primitive_value = to_primitive(global_object, PreferredType::String);
         if (global_object.vm().exception())
@@ -361,8 +361,8 @@ String Value::to_string(GlobalObject& global_object, bool legacy_null_to_empty_s
 
 Utf16String Value::to_utf16_string(GlobalObject& global_object) const
 {
-    if (m_type == Type::String)
-        return m_value.as_string->utf16_string();
+    if (is_string())
+        return extract_pointer<PrimitiveString>()->utf16_string();
 
     auto utf8_string = to_string(global_object);
     if (global_object.vm().exception())
@@ -374,27 +374,27 @@ Utf16String Value::to_utf16_string(GlobalObject& global_object) const
 // 7.1.2 ToBoolean ( argument ), https://tc39.es/ecma262/#sec-toboolean
 bool Value::to_boolean() const
 {
-    switch (m_type) {
+    switch (type()) {
     case Type::Undefined:
     case Type::Null:
         return false;
     case Type::Boolean:
-        return m_value.as_bool;
+        return as_bool();
     case Type::Int32:
-        return m_value.as_i32 != 0;
+        return unboxed_i32() != 0;
     case Type::Double:
         if (is_nan())
             return false;
-        return m_value.as_double != 0;
+        return unboxed_double() != 0;
     case Type::String:
-        return !m_value.as_string->string().is_empty();
+        return !extract_pointer<PrimitiveString>()->string().is_empty();
     case Type::Symbol:
         return true;
     case Type::BigInt:
-        return m_value.as_bigint->big_integer() != BIGINT_ZERO;
+        return extract_pointer<BigInt>()->big_integer() != BIGINT_ZERO;
     case Type::Object:
         // B.3.7.1 Changes to ToBoolean, https://tc39.es/ecma262/#sec-IsHTMLDDA-internal-slot-to-boolean
-        if (m_value.as_object->is_htmldda())
+        if (extract_pointer<Object>()->is_htmldda())
             return false;
         return true;
     default:
@@ -442,22 +442,22 @@ Value Value::to_primitive(GlobalObject& global_object, PreferredType preferred_t
 // 7.1.18 ToObject ( argument ), https://tc39.es/ecma262/#sec-toobject
 Object* Value::to_object(GlobalObject& global_object) const
 {
-    switch (m_type) {
+    switch (type()) {
     case Type::Undefined:
     case Type::Null:
         global_object.vm().throw_exception<TypeError>(global_object, ErrorType::ToObjectNullOrUndefined);
         return nullptr;
     case Type::Boolean:
-        return BooleanObject::create(global_object, m_value.as_bool);
+        return BooleanObject::create(global_object, as_bool());
     case Type::Int32:
     case Type::Double:
         return NumberObject::create(global_object, as_double());
     case Type::String:
-        return StringObject::create(global_object, *m_value.as_string, *global_object.string_prototype());
+        return StringObject::create(global_object, *extract_pointer<PrimitiveString>(), *global_object.string_prototype());
     case Type::Symbol:
-        return SymbolObject::create(global_object, *m_value.as_symbol);
+        return SymbolObject::create(global_object, *extract_pointer<Symbol>());
     case Type::BigInt:
-        return BigIntObject::create(global_object, *m_value.as_bigint);
+        return BigIntObject::create(global_object, *extract_pointer<BigInt>());
     case Type::Object:
         return &const_cast<Object&>(as_object());
     default:
@@ -480,13 +480,13 @@ FLATTEN Value Value::to_numeric(GlobalObject& global_object) const
 // 7.1.4 ToNumber ( argument ), https://tc39.es/ecma262/#sec-tonumber
 Value Value::to_number(GlobalObject& global_object) const
 {
-    switch (m_type) {
+    switch (type()) {
     case Type::Undefined:
         return js_nan();
     case Type::Null:
         return Value(0);
     case Type::Boolean:
-        return Value(m_value.as_bool ? 1 : 0);
+        return Value(as_bool() ? 1 : 0);
     case Type::Int32:
     case Type::Double:
         return *this;
@@ -1097,32 +1097,14 @@ Value add(GlobalObject& global_object, Value lhs, Value rhs)
     if (vm.exception())
         return {};
 
-    if (lhs_primitive.is_string() && rhs_primitive.is_string()) {
-        auto const& lhs_string = lhs_primitive.as_string();
-        auto const& rhs_string = rhs_primitive.as_string();
-
-        if (lhs_string.has_utf16_string() && rhs_string.has_utf16_string()) {
-            auto const& lhs_utf16_string = lhs_string.utf16_string();
-            auto const& rhs_utf16_string = rhs_string.utf16_string();
-
-            Vector<u16> combined;
-            combined.ensure_capacity(lhs_utf16_string.length_in_code_units() + rhs_utf16_string.length_in_code_units());
-            combined.extend(lhs_utf16_string.string());
-            combined.extend(rhs_utf16_string.string());
-            return js_string(vm.heap(), Utf16String(move(combined)));
-        }
-    }
     if (lhs_primitive.is_string() || rhs_primitive.is_string()) {
-        auto lhs_string = lhs_primitive.to_string(global_object);
+        auto* lhs_string = lhs_primitive.to_primitive_string(global_object);
         if (vm.exception())
             return {};
-        auto rhs_string = rhs_primitive.to_string(global_object);
+        auto* rhs_string = rhs_primitive.to_primitive_string(global_object);
         if (vm.exception())
             return {};
-        StringBuilder builder(lhs_string.length() + rhs_string.length());
-        builder.append(lhs_string);
-        builder.append(rhs_string);
-        return js_string(vm, builder.to_string());
+        return js_rope_string(vm, *lhs_string, *rhs_string);
     }
 
     auto lhs_numeric = lhs_primitive.to_numeric(global_object);
@@ -50,18 +50,20 @@ public:
         Number,
     };
 
-    bool is_empty() const { return m_type == Type::Empty; }
-    bool is_undefined() const { return m_type == Type::Undefined; }
-    bool is_null() const { return m_type == Type::Null; }
-    bool is_number() const { return m_type == Type::Int32 || m_type == Type::Double; }
-    bool is_string() const { return m_type == Type::String; }
-    bool is_object() const { return m_type == Type::Object; }
-    bool is_boolean() const { return m_type == Type::Boolean; }
-    bool is_symbol() const { return m_type == Type::Symbol; }
-    bool is_accessor() const { return m_type == Type::Accessor; };
-    bool is_bigint() const { return m_type == Type::BigInt; };
+    bool is_empty() const { return tag() == EMPTY_TAG; }
+    bool is_undefined() const { return tag() == UNDEFINED_TAG; }
+    bool is_null() const { return tag() == NULL_TAG; }
+    bool is_number() const { return is_double() || tag() == INT32_TAG; }
+    // NOTE: Every number that is an integer in the i32 range (other than -0) is stored as an int32.
+    bool is_int32() const { return tag() == INT32_TAG; }
+    bool is_string() const { return tag() == STRING_TAG; }
+    bool is_object() const { return tag() == OBJECT_TAG; }
+    bool is_boolean() const { return tag() == BOOLEAN_TAG; }
+    bool is_symbol() const { return tag() == SYMBOL_TAG; }
+    bool is_accessor() const { return tag() == ACCESSOR_TAG; };
+    bool is_bigint() const { return tag() == BIGINT_TAG; };
     bool is_nullish() const { return is_null() || is_undefined(); }
-    bool is_cell() const { return is_string() || is_accessor() || is_object() || is_bigint() || is_symbol(); }
+    bool is_cell() const { return is_cell_encoding(m_value); }
     bool is_array(GlobalObject&) const;
     bool is_function() const;
     bool is_constructor() const;
@@ -83,159 +85,187 @@ public:
     }
 
     Value()
-        : m_type(Type::Empty)
+        : m_value(encode(EMPTY_TAG, 0))
     {
     }
 
     explicit Value(bool value)
-        : m_type(Type::Boolean)
+        : m_value(encode(BOOLEAN_TAG, value ? 1 : 0))
     {
-        m_value.as_bool = value;
     }
 
     explicit Value(double value)
     {
         bool is_negative_zero = bit_cast<u64>(value) == NEGATIVE_ZERO_BITS;
         if (value >= NumericLimits<i32>::min() && value <= NumericLimits<i32>::max() && trunc(value) == value && !is_negative_zero) {
-            m_type = Type::Int32;
-            m_value.as_i32 = static_cast<i32>(value);
+            m_value = encode(INT32_TAG, static_cast<u32>(static_cast<i32>(value)));
+        } else if (__builtin_isnan(value)) {
+            // All NaNs are collapsed into a single bit pattern so that the remaining NaN space is free for tagged values.
+            m_value = CANONICAL_NAN_BITS;
         } else {
-            m_type = Type::Double;
-            m_value.as_double = value;
+            m_value = bit_cast<u64>(value);
         }
     }
 
     explicit Value(unsigned long value)
     {
-        if (value > NumericLimits<i32>::max()) {
-            m_value.as_double = static_cast<double>(value);
-            m_type = Type::Double;
-        } else {
-            m_value.as_i32 = static_cast<i32>(value);
-            m_type = Type::Int32;
-        }
+        if (value > NumericLimits<i32>::max())
+            m_value = bit_cast<u64>(static_cast<double>(value));
+        else
+            m_value = encode(INT32_TAG, static_cast<u32>(value));
     }
 
     explicit Value(unsigned value)
     {
-        if (value > NumericLimits<i32>::max()) {
-            m_value.as_double = static_cast<double>(value);
-            m_type = Type::Double;
-        } else {
-            m_value.as_i32 = static_cast<i32>(value);
-            m_type = Type::Int32;
-        }
+        if (value > NumericLimits<i32>::max())
+            m_value = bit_cast<u64>(static_cast<double>(value));
+        else
+            m_value = encode(INT32_TAG, value);
     }
 
     explicit Value(i32 value)
-        : m_type(Type::Int32)
+        : m_value(encode(INT32_TAG, static_cast<u32>(value)))
     {
-        m_value.as_i32 = value;
     }
 
     Value(const Object* object)
-        : m_type(object ? Type::Object : Type::Null)
+        : m_value(object ? encode_pointer(OBJECT_TAG, object) : encode(NULL_TAG, 0))
     {
-        m_value.as_object = const_cast<Object*>(object);
     }
 
     Value(const PrimitiveString* string)
-        : m_type(Type::String)
+        : m_value(encode_pointer(STRING_TAG, string))
     {
-        m_value.as_string = const_cast<PrimitiveString*>(string);
     }
 
     Value(const Symbol* symbol)
-        : m_type(Type::Symbol)
+        : m_value(encode_pointer(SYMBOL_TAG, symbol))
     {
-        m_value.as_symbol = const_cast<Symbol*>(symbol);
     }
 
     Value(const Accessor* accessor)
-        : m_type(Type::Accessor)
+        : m_value(encode_pointer(ACCESSOR_TAG, accessor))
     {
-        m_value.as_accessor = const_cast<Accessor*>(accessor);
     }
 
     Value(const BigInt* bigint)
-        : m_type(Type::BigInt)
+        : m_value(encode_pointer(BIGINT_TAG, bigint))
     {
-        m_value.as_bigint = const_cast<BigInt*>(bigint);
     }
 
     explicit Value(Type type)
-        : m_type(type)
     {
+        switch (type) {
+        case Type::Empty:
+            m_value = encode(EMPTY_TAG, 0);
+            break;
+        case Type::Undefined:
+            m_value = encode(UNDEFINED_TAG, 0);
+            break;
+        case Type::Null:
+            m_value = encode(NULL_TAG, 0);
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
     }
 
-    Type type() const { return m_type; }
+    Type type() const
+    {
+        if (is_double())
+            return Type::Double;
+        switch (tag()) {
+        case EMPTY_TAG:
+            return Type::Empty;
+        case UNDEFINED_TAG:
+            return Type::Undefined;
+        case NULL_TAG:
+            return Type::Null;
+        case BOOLEAN_TAG:
+            return Type::Boolean;
+        case INT32_TAG:
+            return Type::Int32;
+        case OBJECT_TAG:
+            return Type::Object;
+        case STRING_TAG:
+            return Type::String;
+        case SYMBOL_TAG:
+            return Type::Symbol;
+        case ACCESSOR_TAG:
+            return Type::Accessor;
+        case BIGINT_TAG:
+            return Type::BigInt;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
 
     double as_double() const
     {
         VERIFY(is_number());
-        if (m_type == Type::Int32)
-            return m_value.as_i32;
-        return m_value.as_double;
+        if (tag() == INT32_TAG)
+            return unboxed_i32();
+        return unboxed_double();
     }
 
     bool as_bool() const
     {
-        VERIFY(type() == Type::Boolean);
-        return m_value.as_bool;
+        VERIFY(is_boolean());
+        return m_value & 1;
     }
 
     Object& as_object()
     {
-        VERIFY(type() == Type::Object);
-        return *m_value.as_object;
+        VERIFY(is_object());
+        return *extract_pointer<Object>();
     }
 
     const Object& as_object() const
     {
-        VERIFY(type() == Type::Object);
-        return *m_value.as_object;
+        VERIFY(is_object());
+        return *extract_pointer<Object>();
     }
 
     PrimitiveString& as_string()
     {
         VERIFY(is_string());
-        return *m_value.as_string;
+        return *extract_pointer<PrimitiveString>();
     }
 
     const PrimitiveString& as_string() const
     {
         VERIFY(is_string());
-        return *m_value.as_string;
+        return *extract_pointer<PrimitiveString>();
     }
 
     Symbol& as_symbol()
     {
         VERIFY(is_symbol());
-        return *m_value.as_symbol;
+        return *extract_pointer<Symbol>();
     }
 
     const Symbol& as_symbol() const
     {
         VERIFY(is_symbol());
-        return *m_value.as_symbol;
+        return *extract_pointer<Symbol>();
     }
 
     Cell& as_cell()
     {
         VERIFY(is_cell());
-        return *m_value.as_cell;
+        return *extract_pointer<Cell>();
     }
 
     Accessor& as_accessor()
     {
         VERIFY(is_accessor());
-        return *m_value.as_accessor;
+        return *extract_pointer<Accessor>();
     }
 
     BigInt& as_bigint()
     {
         VERIFY(is_bigint());
-        return *m_value.as_bigint;
+        return *extract_pointer<BigInt>();
     }
 
     Array& as_array();
@@ -244,7 +274,17 @@ public:
     i32 as_i32() const;
     u32 as_u32() const;
 
-    u64 encoded() const { return m_value.encoded; }
+    u64 encoded() const { return m_value; }
+
+    // Values are NaN-boxed: doubles are stored as-is (with all NaNs canonicalized), and every other
+    // type lives in the negative NaN space, with a 16-bit tag in the top bits and a 48-bit payload.
+    static constexpr u64 TAG_SHIFT = 48;
+    static constexpr u64 PAYLOAD_MASK = 0x0000FFFFFFFFFFFFULL;
+    static constexpr u64 CANONICAL_NAN_BITS = 0x7FF8000000000000ULL;
+
+    // Returns whether the given encoded value refers to a heap cell, i.e. whether its payload is a pointer.
+    static constexpr bool is_cell_encoding(u64 encoded) { return (encoded >> TAG_SHIFT) >= FIRST_CELL_TAG; }
+    static constexpr FlatPtr pointer_from_cell_encoding(u64 encoded) { return static_cast<FlatPtr>(encoded & PAYLOAD_MASK); }
 
     String to_string(GlobalObject&, bool legacy_null_to_empty_string = false) const;
     Utf16String to_utf16_string(GlobalObject&) const;
@@ -260,8 +300,8 @@ public:
     StringOrSymbol to_property_key(GlobalObject&) const;
     i32 to_i32(GlobalObject& global_object) const
     {
-        if (m_type == Type::Int32)
-            return m_value.as_i32;
+        if (tag() == INT32_TAG)
+            return unboxed_i32();
         return to_i32_slow_case(global_object);
     }
     u32 to_u32(GlobalObject&) const;
@@ -295,27 +335,55 @@ public:
     [[nodiscard]] ALWAYS_INLINE Value invoke(GlobalObject& global_object, PropertyName const& property_name, Args... args);
 
 private:
-    Type m_type { Type::Empty };
+    enum Tag : u16 {
+        // 0xFFF0 with a zero payload is negative infinity, so tags start right after it.
+        EMPTY_TAG = 0xFFF1,
+        UNDEFINED_TAG,
+        NULL_TAG,
+        BOOLEAN_TAG,
+        INT32_TAG,
+
+        // Everything from here on carries a Cell pointer in its payload.
+        OBJECT_TAG = 0xFFF8,
+        STRING_TAG,
+        SYMBOL_TAG,
+        ACCESSOR_TAG,
+        BIGINT_TAG,
+
+        FIRST_CELL_TAG = OBJECT_TAG,
+    };
+
+    static constexpr u64 encode(Tag tag, u64 payload) { return (static_cast<u64>(tag) << TAG_SHIFT) | payload; }
+
+    template<typename T>
+    static u64 encode_pointer(Tag tag, T const* pointer)
+    {
+        auto bits = static_cast<u64>(reinterpret_cast<FlatPtr>(pointer));
+        VERIFY((bits & ~PAYLOAD_MASK) == 0);
+        return encode(tag, bits);
+    }
+
+    // Anything that isn't in the tagged NaN space (everything up to and including negative infinity) is a double.
+    bool is_double() const { return m_value <= NEGATIVE_INFINITY_BITS; }
+    u16 tag() const { return static_cast<u16>(m_value >> TAG_SHIFT); }
+
+    i32 unboxed_i32() const { return static_cast<i32>(static_cast<u32>(m_value)); }
+    double unboxed_double() const { return bit_cast<double>(m_value); }
+
+    template<typename T>
+    T* extract_pointer() const { return reinterpret_cast<T*>(pointer_from_cell_encoding(m_value)); }
+
+    static constexpr u64 NEGATIVE_INFINITY_BITS = 0xFFF0000000000000ULL;
 
     [[nodiscard]] Value invoke_internal(GlobalObject& global_object, PropertyName const&, Optional<MarkedValueList> arguments);
 
     i32 to_i32_slow_case(GlobalObject&) const;
 
-    union {
-        bool as_bool;
-        i32 as_i32;
-        double as_double;
-        PrimitiveString* as_string;
-        Symbol* as_symbol;
-        Object* as_object;
-        Cell* as_cell;
-        Accessor* as_accessor;
-        BigInt* as_bigint;
-
-        u64 encoded;
-    } m_value { .encoded = 0 };
+    u64 m_value { encode(EMPTY_TAG, 0) };
 };
 
+static_assert(sizeof(Value) == sizeof(u64));
+
 inline Value js_undefined()
 {
     return Value(Value::Type::Undefined);
@@ -0,0 +1,94 @@
+describe("arrays of int32s keep working as other values are added", () => {
+    test("storing non-int32 values", () => {
+        const a = [1, 2, 3];
+        a[1] = 1.5;
+        a.push("foo");
+        a[4] = -0;
+        expect(a).toEqual([1, 1.5, 3, "foo", -0]);
+        expect(Object.is(a[4], -0)).toBeTrue();
+    });
+
+    test("creating and removing holes", () => {
+        const a = [1, 2, 3];
+        a[5] = 6;
+        expect(a).toHaveLength(6);
+        expect(3 in a).toBeFalse();
+        delete a[0];
+        expect(0 in a).toBeFalse();
+        expect(a[1]).toBe(2);
+
+        const b = [1, 2, 3];
+        b.length = 5;
+        expect(3 in b).toBeFalse();
+        b.length = 1;
+        expect(b).toEqual([1]);
+    });
+
+    test("non-default attributes", () => {
+        const a = [1, 2, 3];
+        Object.freeze(a);
+        expect(() => {
+            "use strict";
+            a[0] = 4;
+        }).toThrow(TypeError);
+        expect(a[0]).toBe(1);
+    });
+
+    test("integral doubles", () => {
+        const a = [];
+        for (let i = 0; i < 10; ++i) a.push(i * 0.5 * 2);
+        expect(a.indexOf(9)).toBe(9);
+        expect(a.indexOf(-0)).toBe(0);
+        expect(a.indexOf(0.5)).toBe(-1);
+        expect(a.indexOf("1")).toBe(-1);
+    });
+});
+
+describe("fast paths respect the prototype chain", () => {
+    test("indexed properties on Array.prototype", () => {
+        Array.prototype[1] = "proto";
+        try {
+            const a = [1, , 3];
+            expect(a.indexOf("proto")).toBe(1);
+            expect(a.map(x => x)).toEqual([1, "proto", 3]);
+            expect(a[1]).toBe("proto");
+        } finally {
+            delete Array.prototype[1];
+        }
+    });
+
+    test("setter on Array.prototype", () => {
+        let setterCalls = 0;
+        Object.defineProperty(Array.prototype, 2, {
+            set() {
+                ++setterCalls;
+            },
+            configurable: true,
+        });
+        try {
+            const a = [1, 2];
+            a.push(3);
+            expect(setterCalls).toBe(1);
+            a[2] = 4;
+            expect(setterCalls).toBe(2);
+            expect(a).toHaveLength(3);
+            expect(a.hasOwnProperty(2)).toBeFalse();
+        } finally {
+            delete Array.prototype[2];
+        }
+    });
+
+    test("non-writable length", () => {
+        const a = [1, 2];
+        Object.defineProperty(a, "length", { writable: false });
+        expect(() => {
+            a.push(3);
+        }).toThrow(TypeError);
+        expect(a).toEqual([1, 2]);
+    });
+});
+
+test("sorting int32s compares them as strings", () => {
+    expect([10, 9, 1, -5, 100, -10, 0].sort()).toEqual([-10, -5, 0, 1, 10, 100, 9]);
+    expect([3, 1, 2].sort((a, b) => b - a)).toEqual([3, 2, 1]);
+});
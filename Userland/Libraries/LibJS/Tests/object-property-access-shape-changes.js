@@ -0,0 +1,56 @@
+const getX = o => o.x;
+const setX = (o, value) => {
+    "use strict";
+    o.x = value;
+};
+
+describe("repeated property access sees shape changes", () => {
+    test("objects with different shapes", () => {
+        const objects = [{ x: 1 }, { a: 0, x: 2 }, { a: 0, b: 0, x: 3 }, { b: 0, a: 0, x: 4 }, { c: 0, x: 5 }, { x: 6 }];
+        for (let i = 0; i < 3; ++i) {
+            expect(objects.map(getX)).toEqual([1, 2, 3, 4, 5, 6]);
+        }
+    });
+
+    test("property deleted from object", () => {
+        const o = { a: 1, b: 2, x: 3 };
+        expect(getX(o)).toBe(3);
+        delete o.a;
+        expect(getX(o)).toBe(3);
+        delete o.x;
+        expect(getX(o)).toBeUndefined();
+        o.x = 4;
+        expect(getX(o)).toBe(4);
+    });
+
+    test("data property redefined as accessor", () => {
+        const o = { x: 1 };
+        expect(getX(o)).toBe(1);
+        Object.defineProperty(o, "x", { get: () => 2, set: () => {}, configurable: true });
+        expect(getX(o)).toBe(2);
+        setX(o, 3);
+        expect(getX(o)).toBe(2);
+    });
+
+    test("property becomes non-writable", () => {
+        const o = { x: 1 };
+        setX(o, 2);
+        expect(getX(o)).toBe(2);
+        Object.freeze(o);
+        expect(() => {
+            setX(o, 3);
+        }).toThrow(TypeError);
+        expect(getX(o)).toBe(2);
+    });
+
+    test("object with many properties", () => {
+        const o = {};
+        for (let i = 0; i < 200; ++i) o["p" + i] = i;
+        o.x = 1;
+        expect(getX(o)).toBe(1);
+        delete o.p0;
+        setX(o, 2);
+        expect(getX(o)).toBe(2);
+        expect(o.p199).toBe(199);
+    });
+});
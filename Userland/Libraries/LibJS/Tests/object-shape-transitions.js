@@ -0,0 +1,57 @@
+describe("objects that share part of their shape", () => {
+    test("sibling shapes don't see each other's properties", () => {
+        const a = { x: 1, y: 2 };
+        const b = { x: 1, z: 3 };
+        expect(Object.keys(a)).toEqual(["x", "y"]);
+        expect(Object.keys(b)).toEqual(["x", "z"]);
+        expect(a.z).toBeUndefined();
+        expect(b.y).toBeUndefined();
+        expect(a.hasOwnProperty("z")).toBeFalse();
+    });
+
+    test("shorter shapes don't see properties added further down the chain", () => {
+        const long = {};
+        long.a = 1;
+        long.b = 2;
+        long.c = 3;
+        const short = {};
+        short.a = 4;
+        expect(short.b).toBeUndefined();
+        expect(Object.keys(short)).toEqual(["a"]);
+        short.c = 5;
+        expect(Object.keys(short)).toEqual(["a", "c"]);
+        expect(short.c).toBe(5);
+        expect(long.c).toBe(3);
+    });
+
+    test("reconfiguring a property doesn't affect other objects", () => {
+        const a = { x: 1, y: 2 };
+        const b = { x: 1, y: 2 };
+        Object.defineProperty(a, "x", { enumerable: false });
+        a.z = 3;
+        b.z = 4;
+        expect(Object.keys(a)).toEqual(["y", "z"]);
+        expect(Object.keys(b)).toEqual(["x", "y", "z"]);
+    });
+
+    test("changing the prototype keeps the properties", () => {
+        const a = { x: 1 };
+        Object.setPrototypeOf(a, { inherited: true });
+        a.y = 2;
+        const b = { x: 1 };
+        b.y = 3;
+        expect(Object.keys(a)).toEqual(["x", "y"]);
+        expect(a.inherited).toBeTrue();
+        expect(b.inherited).toBeUndefined();
+        expect(b.y).toBe(3);
+    });
+
+    test("deleting a property doesn't affect other objects", () => {
+        const a = { x: 1, y: 2, z: 3 };
+        const b = { x: 1, y: 2, z: 3 };
+        delete a.y;
+        expect(Object.keys(a)).toEqual(["x", "z"]);
+        expect(Object.keys(b)).toEqual(["x", "y", "z"]);
+        expect(b.z).toBe(3);
+    });
+});
@@ -0,0 +1,38 @@
+test("basic functionality", () => {
+    expect("foo" + "bar").toBe("foobar");
+    expect("" + "bar").toBe("bar");
+    expect("foo" + "").toBe("foo");
+    expect("foo" + 1).toBe("foo1");
+    expect(1 + "foo").toBe("1foo");
+    expect("foo" + null + undefined + true).toBe("foonullundefinedtrue");
+    expect("a" + { toString: () => "b" }).toBe("ab");
+});
+
+test("concatenating in a loop", () => {
+    let s = "";
+    for (let i = 0; i < 10000; ++i) s += "x";
+    expect(s.length).toBe(10000);
+    expect(s[9999]).toBe("x");
+
+    let t = "";
+    for (let i = 0; i < 10; ++i) t = i + t;
+    expect(t).toBe("9876543210");
+});
+
+test("concatenated strings survive garbage collection", () => {
+    let s = "";
+    for (let i = 0; i < 100000; ++i) s += "ab";
+    gc();
+    expect(s.length).toBe(200000);
+    expect(s.startsWith("abab")).toBeTrue();
+    expect(s.endsWith("abab")).toBeTrue();
+});
+
+test("mixing UTF-8 and UTF-16 strings", () => {
+    const [high, low] = "😀".split("");
+    const s = high + low + "ab" + high + low;
+    expect(s.length).toBe(6);
+    expect(s.codePointAt(0)).toBe(0x1f600);
+    expect(s.codePointAt(4)).toBe(0x1f600);
+    expect(s).toBe("😀ab😀");
+});
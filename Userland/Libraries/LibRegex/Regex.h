@@ -9,3 +9,4 @@
 #include <LibRegex/Forward.h>
 #include <LibRegex/RegexDebug.h>
 #include <LibRegex/RegexMatcher.h>
+#include <LibRegex/RegexSet.h>
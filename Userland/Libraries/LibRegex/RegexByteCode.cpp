@@ -10,6 +10,7 @@
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <LibUnicode/CharacterTypes.h>
+#include <pthread.h>
 
 namespace regex {
 
@@ -151,18 +152,36 @@ static bool restore_string_position(MatchInput const& input, MatchState& state)
     return true;
 }
 
-OwnPtr<OpCode> ByteCode::s_opcodes[(size_t)OpCodeId::Last + 1];
-bool ByteCode::s_opcodes_initialized { false };
+static __thread OpCodeTable* s_opcode_table_for_current_thread;
+static pthread_key_t s_opcode_table_key;
+static pthread_once_t s_opcode_table_key_once = PTHREAD_ONCE_INIT;
 
-void ByteCode::ensure_opcodes_initialized()
+OpCodeTable& OpCodeTable::for_current_thread()
+{
+    if (auto* table = s_opcode_table_for_current_thread)
+        return *table;
+
+    // The key's destructor frees the table when the thread exits.
+    pthread_once(&s_opcode_table_key_once, [] {
+        int rc = pthread_key_create(&s_opcode_table_key, [](void* table) {
+            delete static_cast<OpCodeTable*>(table);
+        });
+        VERIFY(rc == 0);
+    });
+
+    auto* table = new OpCodeTable;
+    pthread_setspecific(s_opcode_table_key, table);
+    s_opcode_table_for_current_thread = table;
+    return *table;
+}
+
+OpCodeTable::OpCodeTable()
 {
-    if (s_opcodes_initialized)
-        return;
     for (u32 i = (u32)OpCodeId::First; i <= (u32)OpCodeId::Last; ++i) {
         switch ((OpCodeId)i) {
-#define __ENUMERATE_OPCODE(OpCode)              \
-    case OpCodeId::OpCode:                      \
-        s_opcodes[i] = make<OpCode_##OpCode>(); \
+#define __ENUMERATE_OPCODE(OpCode)          \
+    case OpCodeId::OpCode:                  \
+        m_opcodes[i] = new OpCode_##OpCode; \
         break;
 
             ENUMERATE_OPCODES
@@ -170,19 +189,26 @@ void ByteCode::ensure_opcodes_initialized()
 #undef __ENUMERATE_OPCODE
         }
     }
-    s_opcodes_initialized = true;
 }
 
-ALWAYS_INLINE OpCode& ByteCode::get_opcode_by_id(OpCodeId id) const
+OpCodeTable::~OpCodeTable()
+{
+    for (auto* opcode : m_opcodes)
+        delete opcode;
+    if (s_opcode_table_for_current_thread == this)
+        s_opcode_table_for_current_thread = nullptr;
+}
+
+ALWAYS_INLINE OpCode& ByteCode::get_opcode_by_id(OpCodeId id, OpCodeTable& opcodes) const
 {
     VERIFY(id >= OpCodeId::First && id <= OpCodeId::Last);
 
-    auto& opcode = s_opcodes[(u32)id];
-    opcode->set_bytecode(*const_cast<ByteCode*>(this));
-    return *opcode;
+    auto& opcode = opcodes[id];
+    opcode.set_bytecode(*const_cast<ByteCode*>(this));
+    return opcode;
 }
 
-OpCode& ByteCode::get_opcode(MatchState& state) const
+OpCode& ByteCode::get_opcode(MatchState& state, OpCodeTable& opcodes) const
 {
     OpCodeId opcode_id;
     if (state.instruction_position >= size())
@@ -190,7 +216,7 @@ OpCode& ByteCode::get_opcode(MatchState& state) const
     else
         opcode_id = (OpCodeId)at(state.instruction_position);
 
-    auto& opcode = get_opcode_by_id(opcode_id);
+    auto& opcode = get_opcode_by_id(opcode_id, opcodes);
     opcode.set_state(state);
     return opcode;
 }
@@ -140,14 +140,27 @@ struct CompareTypeAndValuePair {
 
 class OpCode;
 
+// The opcodes keep a pointer to the state of the match they're executing, so every thread needs its own set.
+// Looking the table up goes through TLS, so hot loops should do it once and hand the table to get_opcode().
+class OpCodeTable {
+public:
+    static OpCodeTable& for_current_thread();
+
+    ~OpCodeTable();
+
+    OpCode& operator[](OpCodeId id) { return *m_opcodes[(size_t)id]; }
+
+private:
+    OpCodeTable();
+
+    OpCode* m_opcodes[(size_t)OpCodeId::Last + 1];
+};
+
 class ByteCode : public DisjointChunks<ByteCodeValueType> {
     using Base = DisjointChunks<ByteCodeValueType>;
 
 public:
-    ByteCode()
-    {
-        ensure_opcodes_initialized();
-    }
+    ByteCode() = default;
 
     ByteCode(ByteCode const&) = default;
     virtual ~ByteCode() = default;
@@ -515,7 +528,8 @@ public:
         bytecode_to_repeat = move(bytecode);
     }
 
-    OpCode& get_opcode(MatchState& state) const;
+    OpCode& get_opcode(MatchState& state) const { return get_opcode(state, OpCodeTable::for_current_thread()); }
+    OpCode& get_opcode(MatchState&, OpCodeTable&) const;
 
 private:
     void insert_string(StringView const& view)
@@ -525,10 +539,7 @@ private:
             empend((ByteCodeValueType)view[i]);
     }
 
-    void ensure_opcodes_initialized();
-    ALWAYS_INLINE OpCode& get_opcode_by_id(OpCodeId id) const;
-    static OwnPtr<OpCode> s_opcodes[(size_t)OpCodeId::Last + 1];
-    static bool s_opcodes_initialized;
+    ALWAYS_INLINE OpCode& get_opcode_by_id(OpCodeId id, OpCodeTable&) const;
 };
 
 #define ENUMERATE_EXECUTION_RESULTS                          \
@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "RegexLazyDFA.h"
+#include "RegexMatch.h"
+
+#include <AK/CharacterTypes.h>
+#include <AK/QuickSort.h>
+
+namespace regex {
+
+using Detail::DFAStateKey;
+using Detail::NFAThread;
+
+static size_t compare_string_length(ByteCode const& bytecode, size_t instruction_position)
+{
+    // Compare, argument count, arguments size, CharacterCompareType::String, length, characters...
+    return bytecode.at(instruction_position + 4);
+}
+
+static bool is_string_compare(ByteCode const& bytecode, size_t instruction_position)
+{
+    return bytecode.at(instruction_position + 1) == 1
+        && (CharacterCompareType)bytecode.at(instruction_position + 3) == CharacterCompareType::String;
+}
+
+OwnPtr<LazyDFA> LazyDFA::try_create(ByteCode const& bytecode, AllOptions options)
+{
+    MatchState state;
+    while (state.instruction_position < bytecode.size()) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+        case OpCodeId::CheckBoundary:
+            // Lookarounds and word boundaries need to look at more than the next character.
+            return nullptr;
+        case OpCodeId::Compare: {
+            auto& compare = static_cast<OpCode_Compare const&>(opcode);
+            for (auto& argument : compare.flat_compares()) {
+                if (argument.type == CharacterCompareType::Reference)
+                    return nullptr;
+                if (argument.type == CharacterCompareType::String && compare.arguments_count() != 1)
+                    return nullptr;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+
+    return adopt_own(*new LazyDFA(bytecode, options));
+}
+
+Optional<u32> LazyDFA::intern_thread(NFAThread thread)
+{
+    while (!thread.repetition_marks.is_empty() && thread.repetition_marks.last() == 0)
+        thread.repetition_marks.take_last();
+
+    if (auto index = m_thread_indices.get(thread); index.has_value())
+        return *index;
+
+    if (m_threads.size() == max_thread_count)
+        return {};
+
+    u32 index = m_threads.size();
+    m_threads.append(thread);
+    m_thread_indices.set(move(thread), index);
+    return index;
+}
+
+Optional<LazyDFA::Closure> LazyDFA::compute_closure(DFAStateKey const& key, bool at_end, bool inject_start)
+{
+    Closure closure;
+    HashTable<u32> visited;
+    Vector<u32> worklist;
+
+    auto enqueue = [&](NFAThread thread) {
+        auto index = intern_thread(move(thread));
+        if (!index.has_value())
+            return false;
+        if (visited.set(*index) == AK::HashSetResult::InsertedNewEntry)
+            worklist.append(*index);
+        return true;
+    };
+
+    for (auto index : key.threads) {
+        visited.set(index);
+        worklist.append(index);
+    }
+    if (inject_start && !enqueue({}))
+        return {};
+
+    auto advanced_to = [&](NFAThread const& thread, size_t instruction_position) {
+        return NFAThread { instruction_position, 0, thread.repetition_marks };
+    };
+
+    auto& opcodes = OpCodeTable::for_current_thread();
+    MatchState state;
+    while (!worklist.is_empty()) {
+        auto index = worklist.take_last();
+        // Copy the thread, as interning new threads may reallocate m_threads.
+        auto thread = m_threads[index];
+        auto ip = thread.instruction_position;
+
+        if (ip >= m_bytecode.size()) {
+            closure.accepts = true;
+            continue;
+        }
+
+        if (thread.string_index > 0) {
+            closure.consuming_threads.append(index);
+            continue;
+        }
+
+        state.instruction_position = ip;
+        auto& opcode = m_bytecode.get_opcode(state, opcodes);
+        auto next_ip = ip + opcode.size();
+
+        bool ok = true;
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            if (is_string_compare(m_bytecode, ip) && compare_string_length(m_bytecode, ip) == 0)
+                ok = enqueue(advanced_to(thread, next_ip));
+            else
+                closure.consuming_threads.append(index);
+            break;
+        case OpCodeId::Jump:
+            ok = enqueue(advanced_to(thread, next_ip + static_cast<OpCode_Jump const&>(opcode).offset()));
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            ok = enqueue(advanced_to(thread, next_ip + static_cast<OpCode_ForkJump const&>(opcode).offset()))
+                && enqueue(advanced_to(thread, next_ip));
+            break;
+        case OpCodeId::JumpNonEmpty:
+            // Whether the jump is taken depends on the path that led here; following both sides is a superset
+            // of what the VM does, and taking the jump after an empty iteration only leads back to where we were.
+            ok = enqueue(advanced_to(thread, next_ip + static_cast<OpCode_JumpNonEmpty const&>(opcode).offset()))
+                && enqueue(advanced_to(thread, next_ip));
+            break;
+        case OpCodeId::Checkpoint:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+            ok = enqueue(advanced_to(thread, next_ip));
+            break;
+        case OpCodeId::CheckBegin:
+            if (key.at_start)
+                ok = enqueue(advanced_to(thread, next_ip));
+            break;
+        case OpCodeId::CheckEnd:
+            if (at_end)
+                ok = enqueue(advanced_to(thread, next_ip));
+            break;
+        case OpCodeId::Repeat: {
+            auto& repeat = static_cast<OpCode_Repeat const&>(opcode);
+            auto next = advanced_to(thread, next_ip);
+            if (repeat.id() >= next.repetition_marks.size())
+                next.repetition_marks.resize(repeat.id() + 1);
+            auto& mark = next.repetition_marks[repeat.id()];
+            if (mark == repeat.count() - 1) {
+                mark = 0;
+            } else {
+                next.instruction_position = ip - repeat.offset();
+                ++mark;
+            }
+            ok = enqueue(move(next));
+            break;
+        }
+        case OpCodeId::ResetRepeat: {
+            auto next = advanced_to(thread, next_ip);
+            auto id = static_cast<OpCode_ResetRepeat const&>(opcode).id();
+            if (id < next.repetition_marks.size())
+                next.repetition_marks[id] = 0;
+            ok = enqueue(move(next));
+            break;
+        }
+        case OpCodeId::Exit:
+            // An explicit Exit before the end of the bytecode always fails.
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+
+        if (!ok)
+            return {};
+    }
+
+    quick_sort(closure.consuming_threads);
+    return closure;
+}
+
+bool LazyDFA::ensure_consuming_threads(State& state)
+{
+    if (state.consuming_threads.has_value())
+        return true;
+
+    auto closure = compute_closure(state.key, false, state.key.search);
+    if (!closure.has_value())
+        return false;
+
+    state.consuming_threads = move(closure->consuming_threads);
+    state.accepts_before_end = closure->accepts;
+    return true;
+}
+
+bool LazyDFA::thread_accepts_character(NFAThread const& thread, u8 character)
+{
+    auto ip = thread.instruction_position;
+
+    if (is_string_compare(m_bytecode, ip)) {
+        u8 expected = m_bytecode.at(ip + 5 + thread.string_index);
+        if (m_options & AllFlags::Insensitive)
+            return to_ascii_lowercase(expected) == to_ascii_lowercase(character);
+        return expected == character;
+    }
+
+    auto it = m_accepted_characters.find(ip);
+    if (it == m_accepted_characters.end()) {
+        // Let the VM's Compare decide, by running it on every possible single-character input.
+        Bitmap accepted { 256, false };
+        auto& opcodes = OpCodeTable::for_current_thread();
+        for (size_t i = 0; i < 256; ++i) {
+            char ch = static_cast<char>(i);
+            MatchInput input;
+            input.view = StringView { &ch, 1 };
+            input.regex_options = m_options;
+
+            MatchState state;
+            state.instruction_position = ip;
+            auto& opcode = m_bytecode.get_opcode(state, opcodes);
+            auto result = opcode.execute(input, state);
+            accepted.set(i, result == ExecutionResult::Continue && state.string_position == 1);
+        }
+        m_accepted_characters.set(ip, move(accepted));
+        it = m_accepted_characters.find(ip);
+    }
+    return it->value.get(character);
+}
+
+Optional<DFAStateKey> LazyDFA::compute_transition(State& state, u8 character)
+{
+    if (!ensure_consuming_threads(state))
+        return {};
+
+    DFAStateKey key;
+    key.search = state.key.search;
+
+    for (auto index : *state.consuming_threads) {
+        auto thread = m_threads[index];
+        if (!thread_accepts_character(thread, character))
+            continue;
+
+        auto ip = thread.instruction_position;
+        if (is_string_compare(m_bytecode, ip) && thread.string_index + 1 < compare_string_length(m_bytecode, ip)) {
+            ++thread.string_index;
+        } else {
+            MatchState match_state;
+            match_state.instruction_position = ip;
+            thread.instruction_position += m_bytecode.get_opcode(match_state).size();
+            thread.string_index = 0;
+        }
+
+        auto next_index = intern_thread(move(thread));
+        if (!next_index.has_value())
+            return {};
+        key.threads.append(*next_index);
+    }
+
+    quick_sort(key.threads);
+    for (size_t i = 1; i < key.threads.size();) {
+        if (key.threads[i] == key.threads[i - 1])
+            key.threads.remove(i);
+        else
+            ++i;
+    }
+    return key;
+}
+
+LazyDFA::State& LazyDFA::state_for_key(DFAStateKey key)
+{
+    if (auto it = m_states.find(key); it != m_states.end())
+        return *it->value;
+
+    auto state = make<State>();
+    state->key = key;
+    auto& state_reference = *state;
+    m_states.set(move(key), move(state));
+    return state_reference;
+}
+
+Optional<bool> LazyDFA::matches(StringView input, size_t start_offset, Mode mode)
+{
+    bool search = mode == Mode::Search;
+    size_t cache_flushes = 0;
+
+    DFAStateKey initial_key;
+    initial_key.at_start = start_offset == 0;
+    initial_key.search = search;
+    if (!search) {
+        auto start = intern_thread({});
+        if (!start.has_value())
+            return {};
+        initial_key.threads.append(*start);
+    }
+
+    if (start_offset >= input.length()) {
+        // The VM only tries to match at the very end of the input if that's where it was told to start.
+        auto closure = compute_closure(initial_key, true, search);
+        if (!closure.has_value())
+            return {};
+        return closure->accepts;
+    }
+
+    auto* state = &state_for_key(move(initial_key));
+    for (size_t position = start_offset; position < input.length(); ++position) {
+        if (search) {
+            if (!ensure_consuming_threads(*state))
+                return {};
+            if (state->accepts_before_end)
+                return true;
+        }
+
+        u8 character = input[position];
+        auto* next_state = state->transitions[character];
+        if (!next_state) {
+            auto key = compute_transition(*state, character);
+            if (!key.has_value())
+                return {};
+
+            if (m_states.size() >= max_state_count) {
+                if (++cache_flushes > max_cache_flushes_per_match)
+                    return {};
+                m_states.clear();
+                next_state = &state_for_key(key.release_value());
+            } else {
+                next_state = &state_for_key(key.release_value());
+                state->transitions[character] = next_state;
+            }
+        }
+        state = next_state;
+
+        if (!search && state->key.threads.is_empty())
+            return false;
+    }
+
+    if (!state->accepts_at_end.has_value()) {
+        auto closure = compute_closure(state->key, true, false);
+        if (!closure.has_value())
+            return {};
+        state->accepts_at_end = closure->accepts;
+    }
+    return *state->accepts_at_end;
+}
+
+}
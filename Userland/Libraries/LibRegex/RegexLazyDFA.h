@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexOptions.h"
+
+#include <AK/Array.h>
+#include <AK/Bitmap.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+namespace Detail {
+
+// A point in the bytecode that the NFA simulation can be at.
+struct NFAThread {
+    size_t instruction_position { 0 };
+    // How many characters of a multi-character String compare have been matched.
+    size_t string_index { 0 };
+    // Trailing zeroes are trimmed, so that threads which only differ in unused marks compare equal.
+    Vector<u64> repetition_marks;
+
+    bool operator==(NFAThread const&) const = default;
+};
+
+struct DFAStateKey {
+    // Sorted indices of the NFA threads that the state is made up of, right after consuming a character.
+    Vector<u32> threads;
+    // Whether the state is at the very beginning of the input, where CheckBegin succeeds.
+    bool at_start { false };
+    // Whether a match may also start at the current position, i.e. whether we're searching for a match.
+    bool search { false };
+
+    bool operator==(DFAStateKey const&) const = default;
+};
+
+}
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<regex::Detail::NFAThread> : public GenericTraits<regex::Detail::NFAThread> {
+    static unsigned hash(regex::Detail::NFAThread const& thread)
+    {
+        auto hash = pair_int_hash(thread.instruction_position, thread.string_index);
+        for (auto mark : thread.repetition_marks)
+            hash = pair_int_hash(hash, u64_hash(mark));
+        return hash;
+    }
+};
+
+template<>
+struct Traits<regex::Detail::DFAStateKey> : public GenericTraits<regex::Detail::DFAStateKey> {
+    static unsigned hash(regex::Detail::DFAStateKey const& key)
+    {
+        auto hash = pair_int_hash(key.at_start, key.search);
+        for (auto thread : key.threads)
+            hash = pair_int_hash(hash, thread);
+        return hash;
+    }
+};
+
+}
+
+namespace regex {
+
+// Decides whether a pattern matches a string without backtracking, by simulating its bytecode as an NFA
+// and caching the sets of NFA threads it runs into as the states of a DFA. States and their transitions
+// are only built once the input reaches them, so matching takes time linear in the length of the input.
+//
+// This only answers *whether* there is a match, so the backtracking VM is still needed to find out where
+// the match is and what its capture groups are. It can only be created for patterns that don't need the
+// VM's ability to look around or at previous captures.
+class LazyDFA {
+public:
+    static OwnPtr<LazyDFA> try_create(ByteCode const&, AllOptions);
+
+    AllOptions options() const { return m_options; }
+
+    // The options without the flags that only shape the results the VM returns, which a DFA built for one
+    // set of options can answer for just as well as for the other.
+    static AllOptions matching_options(AllOptions options)
+    {
+        options.reset_flag(AllFlags::SkipSubExprResults);
+        options.reset_flag(AllFlags::StringCopyMatches);
+        options.reset_flag(AllFlags::SkipTrimEmptyMatches);
+        return options;
+    }
+
+    enum class Mode {
+        // Is there a match starting anywhere between the start offset and the end of the input?
+        Search,
+        // Does the pattern match the input from the start offset up to its very end?
+        FullMatch,
+    };
+
+    // Returns an empty Optional if the pattern needs more states than the cache is allowed to hold,
+    // in which case the caller should fall back to the VM.
+    Optional<bool> matches(StringView input, size_t start_offset, Mode);
+
+private:
+    static constexpr size_t max_thread_count = 4096;
+    static constexpr size_t max_state_count = 512;
+    static constexpr size_t max_cache_flushes_per_match = 8;
+
+    struct State {
+        Detail::DFAStateKey key;
+        Array<State*, 256> transitions {};
+        // The threads in the closure of the state that are waiting to consume a character.
+        Optional<Vector<u32>> consuming_threads;
+        bool accepts_before_end { false };
+        Optional<bool> accepts_at_end;
+    };
+
+    struct Closure {
+        Vector<u32> consuming_threads;
+        bool accepts { false };
+    };
+
+    LazyDFA(ByteCode const& bytecode, AllOptions options)
+        : m_bytecode(bytecode)
+        , m_options(matching_options(options))
+    {
+    }
+
+    Optional<u32> intern_thread(Detail::NFAThread);
+    Optional<Closure> compute_closure(Detail::DFAStateKey const&, bool at_end, bool inject_start);
+    bool ensure_consuming_threads(State&);
+    bool thread_accepts_character(Detail::NFAThread const&, u8 character);
+    Optional<Detail::DFAStateKey> compute_transition(State&, u8 character);
+    State& state_for_key(Detail::DFAStateKey);
+
+    ByteCode const& m_bytecode;
+    AllOptions m_options;
+
+    Vector<Detail::NFAThread> m_threads;
+    HashMap<Detail::NFAThread, u32> m_thread_indices;
+    // For each Compare instruction, the set of characters that it accepts.
+    HashMap<size_t, Bitmap> m_accepted_characters;
+
+    HashMap<Detail::DFAStateKey, NonnullOwnPtr<State>> m_states;
+};
+
+}
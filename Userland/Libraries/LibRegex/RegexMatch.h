@@ -77,6 +77,8 @@ public:
         return m_view.get<Utf8View>();
     }
 
+    bool is_string_view() const { return m_view.has<StringView>(); }
+
     bool unicode() const { return m_unicode; }
     void set_unicode(bool unicode) { m_unicode = unicode; }
 
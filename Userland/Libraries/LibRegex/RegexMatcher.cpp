@@ -6,6 +6,7 @@
 
 #include <AK/BumpAllocator.h>
 #include <AK/Debug.h>
+#include <AK/MemMem.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
 #include <LibRegex/RegexMatcher.h>
@@ -116,6 +117,62 @@ RegexResult Matcher<Parser>::match(RegexStringView const& view, Optional<typenam
     return match(views, regex_options);
 }
 
+template<typename Parser>
+Optional<bool> Matcher<Parser>::match_with_lazy_dfa(RegexStringView const& view, AllOptions options) const
+{
+    // The DFA only knows about bytes, and can't honour these flags as they depend on where the VM started matching.
+    if (!view.is_string_view() || options.has_flag_set(AllFlags::Unicode))
+        return {};
+    if (options.has_flag_set(AllFlags::Internal_Stateful) || options.has_flag_set(AllFlags::MatchNotBeginOfLine) || options.has_flag_set(AllFlags::MatchNotEndOfLine))
+        return {};
+
+    if (!m_lazy_dfa || m_lazy_dfa->options().value() != LazyDFA::matching_options(options).value()) {
+        if (m_lazy_dfa_unsupported)
+            return {};
+        m_lazy_dfa = LazyDFA::try_create(m_pattern->parser_result.bytecode, options);
+        if (!m_lazy_dfa) {
+            m_lazy_dfa_unsupported = true;
+            return {};
+        }
+    }
+
+    bool search = options.has_flag_set(AllFlags::Global) || options.has_flag_set(AllFlags::Multiline);
+    return m_lazy_dfa->matches(view.string_view(), 0, search ? LazyDFA::Mode::Search : LazyDFA::Mode::FullMatch);
+}
+
+template<typename Parser>
+Optional<bool> Matcher<Parser>::has_match_without_backtracking(RegexStringView const& view, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
+{
+    AllOptions options = m_regex_options | regex_options.value_or({}).value();
+
+    if (options.has_flag_set(AllFlags::Multiline))
+        return has_match_without_backtracking(view.lines(), regex_options);
+
+    Vector<RegexStringView> views;
+    views.append(view);
+    return has_match_without_backtracking(views, regex_options);
+}
+
+template<typename Parser>
+Optional<bool> Matcher<Parser>::has_match_without_backtracking(Vector<RegexStringView> const& views, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
+{
+    AllOptions options = m_regex_options | regex_options.value_or({}).value();
+
+    // When searching, the VM tries every start offset and every path from it, so it finds a match exactly when the DFA does.
+    // Without a search, it only looks at the first path that matches, and fails if that one stops short of the end of the
+    // input (e.g. /a|ab/ doesn't match "ab"), so the DFA can only prove that there is no match.
+    bool search = options.has_flag_set(AllFlags::Global) || options.has_flag_set(AllFlags::Multiline);
+
+    for (auto& view : views) {
+        auto result = match_with_lazy_dfa(view, options);
+        if (!result.has_value())
+            return {};
+        if (*result)
+            return search ? true : Optional<bool> {};
+    }
+    return false;
+}
+
 template<typename Parser>
 RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
 {
@@ -190,6 +247,12 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     if (input.regex_options.has_flag_set(AllFlags::Internal_Stateful))
         continue_search = false;
 
+    // The literals are made of bytes, so they can only be looked for in views that are indexed by byte.
+    auto& optimization_data = m_pattern->parser_result.optimization_data;
+    bool can_search_for_literals = !input.regex_options.has_flag_set(AllFlags::Unicode)
+        && !input.regex_options.has_flag_set(AllFlags::Insensitive)
+        && !input.regex_options.has_flag_set(AllFlags::Internal_Stateful);
+
     for (auto& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -199,6 +262,26 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         input.view = view;
         dbgln_if(REGEX_DEBUG, "[match] Starting match with view ({}): _{}_", view.length(), view);
 
+        if (auto dfa_result = match_with_lazy_dfa(view, input.regex_options); dfa_result.has_value() && !*dfa_result) {
+            // There is no way to match this view at all, so don't bother backtracking through it.
+            ++input.line;
+            input.global_offset += view.length() + 1;
+            continue;
+        }
+
+        bool search_for_literals = can_search_for_literals && view.is_string_view();
+        auto find_literal = [&](String const& literal, size_t start) {
+            auto haystack = view.string_view().substring_view(min(start, view.length()));
+            return AK::memmem_optional(haystack.characters_without_null_termination(), haystack.length(), literal.characters(), literal.length());
+        };
+
+        if (search_for_literals && !optimization_data.required_literal.is_empty() && !find_literal(optimization_data.required_literal, m_pattern->start_offset).has_value()) {
+            // Every match contains this literal, so there can't be any match in this view.
+            ++input.line;
+            input.global_offset += view.length() + 1;
+            continue;
+        }
+
         auto view_length = view.length();
         size_t view_index = m_pattern->start_offset;
         state.string_position = view_index;
@@ -234,6 +317,14 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         }
 
         for (; view_index < view_length; ++view_index) {
+            if (continue_search && search_for_literals && !optimization_data.literal_prefix.is_empty()) {
+                // Every match starts with this literal, so skip straight to the next place it occurs.
+                auto offset = find_literal(optimization_data.literal_prefix, view_index);
+                if (!offset.has_value())
+                    break;
+                view_index += *offset;
+            }
+
             auto& match_length_minimum = m_pattern->parser_result.match_length_minimum;
             // FIXME: More performant would be to know the remaining minimum string
             //        length needed to match from the current position onwards within
@@ -424,9 +515,10 @@ Optional<bool> Matcher<Parser>::execute(MatchInput const& input, MatchState& sta
     size_t recursion_level = 0;
 
     auto& bytecode = m_pattern->parser_result.bytecode;
+    auto& opcodes = OpCodeTable::for_current_thread();
 
     for (;;) {
-        auto& opcode = bytecode.get_opcode(state);
+        auto& opcode = bytecode.get_opcode(state, opcodes);
         ++operations;
 
 #if REGEX_DEBUG
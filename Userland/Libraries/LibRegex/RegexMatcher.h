@@ -7,6 +7,7 @@
 #pragma once
 
 #include "RegexByteCode.h"
+#include "RegexLazyDFA.h"
 #include "RegexMatch.h"
 #include "RegexOptions.h"
 #include "RegexParser.h"
@@ -63,6 +64,11 @@ public:
     RegexResult match(RegexStringView const&, Optional<typename ParserTraits<Parser>::OptionsType> = {}) const;
     RegexResult match(Vector<RegexStringView> const&, Optional<typename ParserTraits<Parser>::OptionsType> = {}) const;
 
+    // Returns whether there is a match if the lazy DFA can decide that on its own (it can always rule out a match, but only
+    // confirm one when searching), or an empty Optional if the VM has to decide.
+    Optional<bool> has_match_without_backtracking(RegexStringView const&, Optional<typename ParserTraits<Parser>::OptionsType> = {}) const;
+    Optional<bool> has_match_without_backtracking(Vector<RegexStringView> const&, Optional<typename ParserTraits<Parser>::OptionsType> = {}) const;
+
     typename ParserTraits<Parser>::OptionsType options() const
     {
         return m_regex_options;
@@ -71,13 +77,18 @@ public:
     void reset_pattern(Badge<Regex<Parser>>, Regex<Parser> const* pattern)
     {
         m_pattern = pattern;
+        m_lazy_dfa = nullptr;
     }
 
 private:
     Optional<bool> execute(MatchInput const& input, MatchState& state, size_t& operations) const;
+    Optional<bool> match_with_lazy_dfa(RegexStringView const&, AllOptions) const;
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+
+    mutable OwnPtr<LazyDFA> m_lazy_dfa;
+    mutable bool m_lazy_dfa_unsupported { false };
 };
 
 template<class Parser>
@@ -215,6 +226,8 @@ public:
     {
         if (!matcher || parser_result.error != Error::NoError)
             return false;
+        if (auto result = matcher->has_match_without_backtracking(view, regex_options); result.has_value())
+            return *result;
         RegexResult result = matcher->match(view, AllOptions { regex_options.value_or({}) } | AllFlags::SkipSubExprResults);
         return result.success;
     }
@@ -223,6 +236,8 @@ public:
     {
         if (!matcher || parser_result.error != Error::NoError)
             return false;
+        if (auto result = matcher->has_match_without_backtracking(views, regex_options); result.has_value())
+            return *result;
         RegexResult result = matcher->match(views, AllOptions { regex_options.value_or({}) } | AllFlags::SkipSubExprResults);
         return result.success;
     }
@@ -232,6 +247,7 @@ private:
     using BasicBlockList = Vector<Detail::Block>;
     BasicBlockList split_basic_blocks();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
+    void fill_optimization_data();
 };
 
 // free standing functions for match, search and has_match
@@ -4,9 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
+#include <AK/AnyOf.h>
+#include <AK/CharacterTypes.h>
 #include <AK/QuickSort.h>
-#include <AK/RedBlackTree.h>
-#include <AK/Stack.h>
 #include <LibRegex/Regex.h>
 #include <LibRegex/RegexBytecodeStreamOptimizer.h>
 
@@ -22,6 +23,135 @@ void Regex<Parser>::run_optimization_passes()
     attempt_rewrite_loops_as_atomic_groups(split_basic_blocks());
 
     parser_result.bytecode.flatten();
+
+    fill_optimization_data();
+}
+
+template<typename Parser>
+void Regex<Parser>::fill_optimization_data()
+{
+    auto& bytecode = parser_result.bytecode;
+    auto& data = parser_result.optimization_data;
+    data = {};
+
+    // Find out where jumps can land, and which instructions some path through the pattern can jump over.
+    HashTable<size_t> jump_targets;
+    Vector<Block> skippable_ranges;
+    MatchState state;
+    for (state.instruction_position = 0; state.instruction_position < bytecode.size();) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto next_ip = state.instruction_position + opcode.size();
+        Optional<size_t> target;
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+            // Lookarounds can contain literals that are never consumed, so don't try to reason about them.
+            return;
+        case OpCodeId::Jump:
+            target = next_ip + static_cast<OpCode_Jump const&>(opcode).offset();
+            break;
+        case OpCodeId::JumpNonEmpty:
+            target = next_ip + static_cast<OpCode_JumpNonEmpty const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceJump:
+        case OpCodeId::ForkReplaceStay:
+            target = next_ip + static_cast<OpCode_ForkJump const&>(opcode).offset();
+            break;
+        case OpCodeId::Repeat:
+            target = state.instruction_position - static_cast<OpCode_Repeat const&>(opcode).offset();
+            break;
+        default:
+            break;
+        }
+        if (target.has_value()) {
+            jump_targets.set(*target);
+            if (*target > next_ip)
+                skippable_ranges.append({ next_ip, *target });
+        }
+        state.instruction_position = next_ip;
+    }
+
+    auto is_skippable = [&](size_t instruction_position) {
+        for (auto& range : skippable_ranges) {
+            if (range.start <= instruction_position && instruction_position < range.end)
+                return true;
+        }
+        return false;
+    };
+
+    // Returns whether the instruction matches exactly one literal string, and appends that string to the builder.
+    auto append_literal = [&](OpCode const& opcode, StringBuilder& builder) {
+        if (opcode.opcode_id() != OpCodeId::Compare)
+            return false;
+        auto& compare = static_cast<OpCode_Compare const&>(opcode);
+        if (compare.arguments_count() != 1)
+            return false;
+
+        // Compare, argument count, arguments size, type, and then the argument itself.
+        auto argument_position = state.instruction_position + 3;
+        switch ((CharacterCompareType)bytecode.at(argument_position)) {
+        case CharacterCompareType::Char: {
+            auto ch = bytecode.at(argument_position + 1);
+            if (ch >= 0x80)
+                return false;
+            builder.append((char)ch);
+            return true;
+        }
+        case CharacterCompareType::String: {
+            auto length = bytecode.at(argument_position + 1);
+            for (size_t i = 0; i < length; ++i)
+                builder.append((char)bytecode.at(argument_position + 2 + i));
+            return true;
+        }
+        default:
+            return false;
+        }
+    };
+
+    // Look for runs of literals that every path goes through from start to end, skipping over instructions that
+    // don't consume anything. Nothing but zero-width instructions can come before the prefix, so nothing can jump
+    // into the middle of it without having matched all of it first.
+    StringBuilder run;
+    bool in_prefix = true;
+    auto end_run = [&] {
+        if (in_prefix && !run.is_empty())
+            data.literal_prefix = run.to_string();
+        if (run.length() > data.required_literal.length())
+            data.required_literal = run.to_string();
+        run.clear();
+        in_prefix = false;
+    };
+
+    for (state.instruction_position = 0; state.instruction_position < bytecode.size();) {
+        auto& opcode = bytecode.get_opcode(state);
+        if (!in_prefix && jump_targets.contains(state.instruction_position))
+            end_run();
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Checkpoint:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+        case OpCodeId::ResetRepeat:
+            break;
+        default:
+            if (is_skippable(state.instruction_position) || !append_literal(opcode, run))
+                end_run();
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+    end_run();
+
+    dbgln_if(REGEX_DEBUG, "Literal prefix: '{}', required literal: '{}'", data.literal_prefix, data.required_literal);
 }
 
 template<typename Parser>
@@ -165,14 +295,20 @@ static bool block_satisfies_atomic_rewrite_precondition(ByteCode const& bytecode
                 }))
                 return false;
 
+            // FIXME: This only knows that two single characters are disjoint; ranges, classes and inverted
+            //        compares could be checked for overlap too, instead of giving up on them.
+            auto is_plain_character = [](auto& compare) { return compare.type == CharacterCompareType::Char; };
+            if (!all_of(compares, is_plain_character))
+                return false;
+
             for (auto& repeated_value : repeated_values) {
-                // FIXME: This is too naive!
-                if (any_of(repeated_value, [](auto& compare) { return compare.type == CharacterCompareType::AnyChar; }))
+                if (!all_of(repeated_value, is_plain_character))
                     return false;
 
                 for (auto& repeated_compare : repeated_value) {
-                    // FIXME: This is too naive! it will miss _tons_ of cases since it doesn't check ranges!
-                    if (any_of(compares, [&](auto& compare) { return compare.type == repeated_compare.type && compare.value == repeated_compare.value; }))
+                    // Compare case-insensitively, as we don't know whether the pattern will be matched that way.
+                    auto repeated_character = to_ascii_lowercase(repeated_compare.value);
+                    if (any_of(compares, [&](auto& compare) { return to_ascii_lowercase(compare.value) == repeated_character; }))
                         return false;
                 }
             }
@@ -211,8 +347,6 @@ void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&
     //     -------------------------
     //     bb1       |  RE1
     // can be rewritten as:
-    //     loop.hdr  | ForkStay bb1
-    //     -------------------------
     //     bb0       | RE0
     //               | ForkReplaceX bb0
     //     -------------------------
@@ -243,7 +377,6 @@ void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&
     };
     struct CandidateBlock {
         Block forking_block;
-        Optional<Block> new_target_block;
         AlternateForm form;
     };
     Vector<CandidateBlock> candidate_blocks;
@@ -292,12 +425,12 @@ void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&
                 // We've found RE0 (and RE1 is just the following block, if any), let's see if the precondition applies.
                 // if RE1 is empty, there's no first(RE1), so this is an automatic pass.
                 if (!fork_fallback_block.has_value() || fork_fallback_block->end == fork_fallback_block->start) {
-                    candidate_blocks.append({ forking_block, fork_fallback_block, AlternateForm::DirectLoopWithoutHeader });
+                    candidate_blocks.append({ forking_block, AlternateForm::DirectLoopWithoutHeader });
                     break;
                 }
 
                 if (block_satisfies_atomic_rewrite_precondition(bytecode, forking_block, *fork_fallback_block)) {
-                    candidate_blocks.append({ forking_block, fork_fallback_block, AlternateForm::DirectLoopWithoutHeader });
+                    candidate_blocks.append({ forking_block, AlternateForm::DirectLoopWithoutHeader });
                     break;
                 }
             }
@@ -315,7 +448,7 @@ void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&
                     if (i + 2 < basic_blocks.size())
                         block_following_fork_fallback = basic_blocks[i + 2];
                     if (!block_following_fork_fallback.has_value() || block_satisfies_atomic_rewrite_precondition(bytecode, *fork_fallback_block, *block_following_fork_fallback)) {
-                        candidate_blocks.append({ forking_block, {}, AlternateForm::DirectLoopWithHeader });
+                        candidate_blocks.append({ forking_block, AlternateForm::DirectLoopWithHeader });
                         break;
                     }
                 }
@@ -329,10 +462,6 @@ void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&
         return;
     }
 
-    RedBlackTree<size_t, size_t> needed_patches;
-
-    // Reverse the blocks, so we can patch the bytecode without messing with the latter patches.
-    quick_sort(candidate_blocks, [](auto& a, auto& b) { return b.forking_block.start > a.forking_block.start; });
     for (auto& candidate : candidate_blocks) {
         // Note that both forms share a ForkReplace patch in forking_block.
         // Patch the ForkX in forking_block to be a ForkReplaceX instead.
@@ -352,77 +481,6 @@ void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&
         } else {
             VERIFY_NOT_REACHED();
         }
-
-        if (candidate.form == AlternateForm::DirectLoopWithoutHeader) {
-            if (candidate.new_target_block.has_value()) {
-                // Insert a fork-stay targeted at the second block.
-                bytecode.insert(candidate.forking_block.start, (ByteCodeValueType)OpCodeId::ForkStay);
-                bytecode.insert(candidate.forking_block.start + 1, candidate.new_target_block->start - candidate.forking_block.start);
-                needed_patches.insert(candidate.forking_block.start, 2u);
-            }
-        }
-    }
-
-    if (!needed_patches.is_empty()) {
-        MatchState state;
-        state.instruction_position = 0;
-        struct Patch {
-            ssize_t value;
-            size_t offset;
-            bool should_negate { false };
-        };
-        for (;;) {
-            if (state.instruction_position >= bytecode.size())
-                break;
-
-            auto& opcode = bytecode.get_opcode(state);
-            Stack<Patch, 2> patch_points;
-
-            switch (opcode.opcode_id()) {
-            case OpCodeId::Jump:
-                patch_points.push({ static_cast<OpCode_Jump const&>(opcode).offset(), state.instruction_position + 1 });
-                break;
-            case OpCodeId::JumpNonEmpty:
-                patch_points.push({ static_cast<OpCode_JumpNonEmpty const&>(opcode).offset(), state.instruction_position + 1 });
-                patch_points.push({ static_cast<OpCode_JumpNonEmpty const&>(opcode).checkpoint(), state.instruction_position + 2 });
-                break;
-            case OpCodeId::ForkJump:
-                patch_points.push({ static_cast<OpCode_ForkJump const&>(opcode).offset(), state.instruction_position + 1 });
-                break;
-            case OpCodeId::ForkStay:
-                patch_points.push({ static_cast<OpCode_ForkStay const&>(opcode).offset(), state.instruction_position + 1 });
-                break;
-            case OpCodeId::Repeat:
-                patch_points.push({ -(ssize_t) static_cast<OpCode_Repeat const&>(opcode).offset(), state.instruction_position + 1, true });
-                break;
-            default:
-                break;
-            }
-
-            while (!patch_points.is_empty()) {
-                auto& patch_point = patch_points.top();
-                auto target_offset = patch_point.value + state.instruction_position + opcode.size();
-
-                constexpr auto do_patch = [](auto& patch_it, auto& patch_point, auto& target_offset, auto& bytecode, auto ip) {
-                    if (patch_it.key() == ip)
-                        return;
-
-                    if (patch_point.value < 0 && target_offset < patch_it.key() && ip > patch_it.key())
-                        bytecode[patch_point.offset] += (patch_point.should_negate ? 1 : -1) * (*patch_it);
-                    else if (patch_point.value > 0 && target_offset > patch_it.key() && ip < patch_it.key())
-                        bytecode[patch_point.offset] += (patch_point.should_negate ? -1 : 1) * (*patch_it);
-                };
-
-                if (auto patch_it = needed_patches.find_largest_not_above_iterator(target_offset); !patch_it.is_end())
-                    do_patch(patch_it, patch_point, target_offset, bytecode, state.instruction_position);
-                else if (auto patch_it = needed_patches.find_largest_not_above_iterator(state.instruction_position); !patch_it.is_end())
-                    do_patch(patch_it, patch_point, target_offset, bytecode, state.instruction_position);
-
-                patch_points.pop();
-            }
-
-            state.instruction_position += opcode.size();
-        }
     }
 
     if constexpr (REGEX_DEBUG) {
@@ -54,6 +54,14 @@ public:
         Error error;
         Token error_token;
         Vector<FlyString> capture_groups;
+
+        // Filled in by the optimizer, and used by the matcher to skip over places where a match can't start.
+        struct OptimizationData {
+            // A literal that every match starts with.
+            String literal_prefix;
+            // The longest literal that every match contains.
+            String required_literal;
+        } optimization_data {};
     };
 
     explicit Parser(Lexer& lexer)
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "RegexSet.h"
+
+#include <AK/BinarySearch.h>
+#include <AK/Bitmap.h>
+#include <AK/Queue.h>
+
+namespace regex::Detail {
+
+size_t AhoCorasick::add_literal(StringView literal)
+{
+    VERIFY(!m_built);
+    VERIFY(!literal.is_empty());
+
+    u32 node = 0;
+    for (auto character : literal) {
+        if (auto next = child(node, character); next.has_value()) {
+            node = *next;
+            continue;
+        }
+
+        u32 next = m_nodes.size();
+        m_nodes.append({});
+        auto& characters = m_nodes[node].characters;
+        size_t insertion_index = 0;
+        while (insertion_index < characters.size() && characters[insertion_index] < (u8)character)
+            ++insertion_index;
+        characters.insert(insertion_index, (u8)character);
+        m_nodes[node].children.insert(insertion_index, next);
+        node = next;
+    }
+
+    m_nodes[node].has_outputs = true;
+    m_nodes[node].outputs.append(m_literal_count);
+    return m_literal_count++;
+}
+
+Optional<u32> AhoCorasick::child(u32 node, u8 character) const
+{
+    auto& characters = m_nodes[node].characters;
+    size_t index = 0;
+    if (!binary_search(characters.span(), character, &index))
+        return {};
+    return m_nodes[node].children[index];
+}
+
+u32 AhoCorasick::step(u32 node, u8 character) const
+{
+    for (;;) {
+        if (auto next = child(node, character); next.has_value())
+            return *next;
+        if (node == 0)
+            return 0;
+        node = m_nodes[node].failure_link;
+    }
+}
+
+void AhoCorasick::build()
+{
+    VERIFY(!m_built);
+
+    // Nodes are visited in order of their depth, so the failure links of shallower nodes are already known.
+    Queue<u32> queue;
+    for (auto child : m_nodes[0].children)
+        queue.enqueue(child);
+
+    while (!queue.is_empty()) {
+        auto node = queue.dequeue();
+        for (size_t i = 0; i < m_nodes[node].children.size(); ++i) {
+            auto character = m_nodes[node].characters[i];
+            auto next = m_nodes[node].children[i];
+
+            auto failure = step(m_nodes[node].failure_link, character);
+            // The root's children fail back to the root, which `step()` from the root would otherwise walk into.
+            if (failure == next)
+                failure = 0;
+            m_nodes[next].failure_link = failure;
+            m_nodes[next].output_link = m_nodes[failure].has_outputs ? failure : m_nodes[failure].output_link;
+            queue.enqueue(next);
+        }
+    }
+
+    m_built = true;
+}
+
+}
+
+namespace regex {
+
+template<class Parser>
+RegexSet<Parser>::RegexSet(Vector<String> patterns, typename ParserTraits<Parser>::OptionsType regex_options)
+{
+    m_regexes.ensure_capacity(patterns.size());
+    for (auto& pattern : patterns)
+        m_regexes.append(make<Regex<Parser>>(move(pattern), regex_options));
+
+    for (size_t i = 0; i < m_regexes.size(); ++i) {
+        auto& regex = m_regexes[i];
+        auto& literal = regex.parser_result.optimization_data.required_literal;
+        if (literal.is_empty() || AllOptions { regex.options() }.has_flag_set(AllFlags::Insensitive)) {
+            m_patterns_without_literal.append(i);
+            continue;
+        }
+
+        auto index = m_literals.add_literal(literal);
+        if (index == m_patterns_for_literal.size())
+            m_patterns_for_literal.append({});
+        m_patterns_for_literal[index].append(i);
+    }
+    m_literals.build();
+}
+
+template<class Parser>
+Optional<size_t> RegexSet<Parser>::first_pattern_with_error() const
+{
+    for (size_t i = 0; i < m_regexes.size(); ++i) {
+        if (m_regexes[i].parser_result.error != Error::NoError)
+            return i;
+    }
+    return {};
+}
+
+template<class Parser>
+template<typename Callback>
+void RegexSet<Parser>::for_each_candidate(RegexStringView const& view, Optional<typename ParserTraits<Parser>::OptionsType> regex_options, Callback callback) const
+{
+    // The literals are made of bytes, and have to match exactly.
+    AllOptions options { regex_options.value_or({}) };
+    bool can_search_for_literals = view.is_string_view() && !options.has_flag_set(AllFlags::Insensitive);
+
+    if (!can_search_for_literals) {
+        for (size_t i = 0; i < m_regexes.size(); ++i) {
+            if (callback(i) == IterationDecision::Break)
+                return;
+        }
+        return;
+    }
+
+    Bitmap is_candidate { m_regexes.size(), false };
+    for (auto index : m_patterns_without_literal)
+        is_candidate.set(index, true);
+
+    Bitmap found_literals { m_literals.literal_count(), false };
+    size_t found_literal_count = 0;
+    m_literals.find_all(view.string_view(), [&](size_t literal) {
+        if (found_literals.get(literal))
+            return IterationDecision::Continue;
+        found_literals.set(literal, true);
+        for (auto index : m_patterns_for_literal[literal])
+            is_candidate.set(index, true);
+        return ++found_literal_count == m_literals.literal_count() ? IterationDecision::Break : IterationDecision::Continue;
+    });
+
+    for (size_t i = 0; i < m_regexes.size(); ++i) {
+        if (is_candidate.get(i) && callback(i) == IterationDecision::Break)
+            return;
+    }
+}
+
+template<class Parser>
+Vector<size_t> RegexSet<Parser>::matches(RegexStringView const& view, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
+{
+    Vector<size_t> result;
+    for_each_candidate(view, regex_options, [&](size_t index) {
+        if (m_regexes[index].has_match(view, regex_options))
+            result.append(index);
+        return IterationDecision::Continue;
+    });
+    return result;
+}
+
+template<class Parser>
+bool RegexSet<Parser>::has_match(RegexStringView const& view, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
+{
+    bool found = false;
+    for_each_candidate(view, regex_options, [&](size_t index) {
+        if (!m_regexes[index].has_match(view, regex_options))
+            return IterationDecision::Continue;
+        found = true;
+        return IterationDecision::Break;
+    });
+    return found;
+}
+
+template class RegexSet<PosixBasicParser>;
+template class RegexSet<PosixExtendedParser>;
+template class RegexSet<ECMA262Parser>;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexMatcher.h"
+
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+namespace Detail {
+
+// Finds all occurrences of a set of literals in a single pass over the input, in time linear in its length.
+class AhoCorasick {
+public:
+    // Adds a literal, and returns the index that `find_all()` will report it as.
+    size_t add_literal(StringView);
+    // Must be called once all the literals have been added, and before searching.
+    void build();
+
+    size_t literal_count() const { return m_literal_count; }
+
+    // Calls the callback with the index of every literal that occurs in the input, once per occurrence.
+    // The callback can return IterationDecision::Break to stop the search early.
+    template<typename Callback>
+    void find_all(StringView input, Callback callback) const
+    {
+        VERIFY(m_built);
+        u32 node = 0;
+        for (auto character : input) {
+            node = step(node, character);
+            for (auto output = m_nodes[node].has_outputs ? node : m_nodes[node].output_link; output != 0; output = m_nodes[output].output_link) {
+                for (auto literal : m_nodes[output].outputs) {
+                    if (callback(literal) == IterationDecision::Break)
+                        return;
+                }
+            }
+        }
+    }
+
+private:
+    struct Node {
+        // Sorted by character, so that they can be binary searched.
+        Vector<u8> characters;
+        Vector<u32> children;
+        u32 failure_link { 0 };
+        // The closest node along the failure links that some literal ends in, or 0 if there is none.
+        u32 output_link { 0 };
+        bool has_outputs { false };
+        Vector<size_t> outputs;
+    };
+
+    Optional<u32> child(u32 node, u8 character) const;
+    u32 step(u32 node, u8 character) const;
+
+    Vector<Node> m_nodes { Node {} };
+    size_t m_literal_count { 0 };
+    bool m_built { false };
+};
+
+}
+
+// Matches the same input against many patterns at once, and reports which of them matched.
+//
+// All of the patterns' required literals (see Parser::Result::OptimizationData) are searched for in one pass
+// with Aho-Corasick, and only the patterns whose literal occurs in the input (or that don't have one) are run
+// on it. Sets with many rules that mostly don't match, such as log routing rules, only pay for the rules that
+// could match, instead of for every rule.
+template<class Parser>
+class RegexSet final {
+public:
+    explicit RegexSet(Vector<String> patterns, typename ParserTraits<Parser>::OptionsType regex_options = {});
+
+    size_t size() const { return m_regexes.size(); }
+    Regex<Parser> const& regex(size_t index) const { return m_regexes[index]; }
+
+    // Returns the index of the first pattern that failed to parse, if any.
+    Optional<size_t> first_pattern_with_error() const;
+
+    // Returns the indices of all the patterns that match the input, in ascending order.
+    Vector<size_t> matches(RegexStringView const&, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {}) const;
+
+    // Returns whether any of the patterns match the input.
+    bool has_match(RegexStringView const&, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {}) const;
+
+private:
+    template<typename Callback>
+    void for_each_candidate(RegexStringView const&, Optional<typename ParserTraits<Parser>::OptionsType> regex_options, Callback) const;
+
+    NonnullOwnPtrVector<Regex<Parser>> m_regexes;
+    Detail::AhoCorasick m_literals;
+    // For each literal in the automaton, the patterns that require it.
+    Vector<Vector<size_t>> m_patterns_for_literal;
+    // The patterns that don't require any literal, and so have to be run on every input.
+    Vector<size_t> m_patterns_without_literal;
+};
+
+}
+
+using regex::RegexSet;
@@ -21,7 +21,8 @@ Threading::Thread::Thread(Function<intptr_t()> action, StringView thread_name)
 Threading::Thread::~Thread()
 {
     if (m_tid && !m_detached) {
-        dbgln("Destroying thread \"{}\"({}) while it is still running!", m_thread_name, m_tid);
+        if (!m_has_exited)
+            dbgln("Destroying thread \"{}\"({}) while it is still running!", m_thread_name, m_tid);
         [[maybe_unused]] auto res = join();
     }
 }
@@ -33,17 +34,19 @@ void Threading::Thread::start()
         nullptr,
         [](void* arg) -> void* {
             Thread* self = static_cast<Thread*>(arg);
+            // The thread names itself, as it may already be gone by the time pthread_create() returns.
+            if (!self->m_thread_name.is_empty()) {
+                int rc = pthread_setname_np(pthread_self(), self->m_thread_name.characters());
+                VERIFY(rc == 0);
+            }
+            // Note: Don't clear m_tid here, join() still needs it once we've exited.
             auto exit_code = self->m_action();
-            self->m_tid = 0;
+            self->m_has_exited = true;
             return reinterpret_cast<void*>(exit_code);
         },
         static_cast<void*>(this));
 
     VERIFY(rc == 0);
-    if (!m_thread_name.is_empty()) {
-        rc = pthread_setname_np(m_tid, m_thread_name.characters());
-        VERIFY(rc == 0);
-    }
     dbgln("Started thread \"{}\", tid = {}", m_thread_name, m_tid);
 }
 
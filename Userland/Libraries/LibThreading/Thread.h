@@ -7,11 +7,13 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/DistinctNumeric.h>
 #include <AK/Function.h>
 #include <AK/Result.h>
 #include <AK/String.h>
 #include <LibCore/Object.h>
+#include <errno.h>
 #include <pthread.h>
 
 namespace Threading {
@@ -32,6 +34,7 @@ public:
 
     String thread_name() const { return m_thread_name; }
     pthread_t tid() const { return m_tid; }
+    bool has_exited() const { return m_has_exited; }
 
 private:
     explicit Thread(Function<intptr_t()> action, StringView thread_name = nullptr);
@@ -39,11 +42,15 @@ private:
     pthread_t m_tid { 0 };
     String m_thread_name;
     bool m_detached { false };
+    Atomic<bool> m_has_exited { false };
 };
 
 template<typename T>
 Result<T, ThreadError> Thread::join()
 {
+    if (m_detached)
+        return ThreadError { EINVAL };
+
     void* thread_return = nullptr;
     int rc = pthread_join(m_tid, &thread_return);
     if (rc != 0) {
@@ -6,15 +6,24 @@
 
 #include <AK/Assertions.h>
 #include <AK/ByteBuffer.h>
-#include <AK/ScopeGuard.h>
+#include <AK/MappedFile.h>
+#include <AK/MemMem.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/QuickSort.h>
 #include <AK/String.h>
-#include <AK/Utf8View.h>
+#include <AK/StringBuilder.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
+#include <LibCore/ProcessorCount.h>
 #include <LibRegex/Regex.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+#include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 
 enum class BinaryFileMode {
@@ -23,6 +32,17 @@ enum class BinaryFileMode {
     Skip,
 };
 
+struct GrepOptions {
+    Vector<String> patterns;
+    PosixOptions regex_options;
+    BinaryFileMode binary_mode { BinaryFileMode::Binary };
+    bool invert_match { false };
+    bool colored_output { false };
+};
+
+// Pipes and other files that can't be mapped are read in chunks of at least this size.
+static constexpr size_t read_chunk_size = 1 * MiB;
+
 template<typename... Ts>
 void fail(StringView format, Ts... args)
 {
@@ -32,40 +52,335 @@ void fail(StringView format, Ts... args)
     abort();
 }
 
+template<typename Parser>
+class LineMatcher {
+public:
+    LineMatcher(GrepOptions const& options)
+    {
+        if (options.patterns.size() == 1)
+            m_regex = make<Regex<Parser>>(options.patterns.first(), options.regex_options);
+        else
+            m_set = make<RegexSet<Parser>>(options.patterns, options.regex_options);
+    }
+
+    bool has_error() const
+    {
+        if (m_regex)
+            return m_regex->parser_result.error != Error::NoError;
+        return m_set->first_pattern_with_error().has_value();
+    }
+
+    // A literal that every matching line contains, if there is one.
+    StringView required_literal() const
+    {
+        if (!m_regex || m_regex->options().has_flag_set(PosixFlags::Insensitive))
+            return {};
+        return m_regex->parser_result.optimization_data.required_literal;
+    }
+
+    RegexResult match(StringView line) const
+    {
+        if (m_regex)
+            return m_regex->match(line, PosixFlags::Global);
+
+        // Find out which patterns match in a single pass, and only then look for where those patterns match.
+        RegexResult result;
+        for (auto index : m_set->matches(line, PosixFlags::Global)) {
+            auto pattern_result = m_set->regex(index).match(line, PosixFlags::Global);
+            result.success = true;
+            result.matches.extend(move(pattern_result.matches));
+        }
+
+        // Highlight the matches from left to right, dropping those that overlap with an earlier one.
+        quick_sort(result.matches, [](auto& a, auto& b) { return a.global_offset < b.global_offset; });
+        size_t end_of_last_match = 0;
+        result.matches.remove_all_matching([&](auto& match) {
+            if (match.global_offset < end_of_last_match)
+                return true;
+            end_of_last_match = match.global_offset + match.view.length();
+            return false;
+        });
+        result.count = result.matches.size();
+        return result;
+    }
+
+private:
+    OwnPtr<Regex<Parser>> m_regex;
+    OwnPtr<RegexSet<Parser>> m_set;
+};
+
+template<typename Parser>
+class FileGrepper {
+public:
+    FileGrepper(GrepOptions const& options, LineMatcher<Parser> const& matcher, StringView filename, bool print_filename, Function<void(StringBuilder&)> flush)
+        : m_options(options)
+        , m_matcher(matcher)
+        , m_filename(filename)
+        , m_print_filename(print_filename)
+        , m_flush(move(flush))
+    {
+    }
+
+    bool did_match() const { return m_did_match; }
+
+    // Greps the whole file, mapping it into memory if possible. Returns false if it couldn't be read.
+    bool grep_file(StringView path)
+    {
+        auto file_or_error = MappedFile::map(path);
+        if (!file_or_error.is_error()) {
+            auto& file = file_or_error.value();
+            grep_buffer({ (char const*)file->data(), file->size() });
+            m_flush(m_output);
+            return true;
+        }
+
+        int fd = open(String(path).characters(), O_RDONLY);
+        if (fd < 0) {
+            warnln("Failed to open {}: {}", path, strerror(errno));
+            return false;
+        }
+        auto success = grep_fd(fd);
+        close(fd);
+        return success;
+    }
+
+    // Greps whatever can be read from the file descriptor, a large chunk at a time.
+    bool grep_fd(int fd)
+    {
+        auto maybe_buffer = ByteBuffer::create_uninitialized(read_chunk_size);
+        if (!maybe_buffer.has_value()) {
+            warnln("Failed to allocate a buffer to read {} into", m_filename);
+            return false;
+        }
+        auto& buffer = maybe_buffer.value();
+        size_t used = 0;
+        for (;;) {
+            auto nread = read(fd, buffer.data() + used, buffer.size() - used);
+            if (nread < 0) {
+                warnln("Failed to read {}: {}", m_filename, strerror(errno));
+                return false;
+            }
+            if (nread == 0)
+                break;
+            used += nread;
+
+            // Only grep whole lines, and keep the incomplete last one around until the rest of it has been read.
+            size_t end_of_lines = used;
+            while (end_of_lines > 0 && buffer[end_of_lines - 1] != '\n')
+                --end_of_lines;
+            if (end_of_lines == 0) {
+                if (used == buffer.size() && !buffer.try_resize(buffer.size() * 2)) {
+                    warnln("Failed to allocate a buffer to read {} into", m_filename);
+                    return false;
+                }
+                continue;
+            }
+
+            bool keep_going = grep_buffer({ (char const*)buffer.data(), end_of_lines });
+            m_flush(m_output);
+            if (!keep_going)
+                return true;
+
+            memmove(buffer.data(), buffer.data() + end_of_lines, used - end_of_lines);
+            used -= end_of_lines;
+        }
+
+        grep_buffer({ (char const*)buffer.data(), used });
+        m_flush(m_output);
+        return true;
+    }
+
+private:
+    // Returns false if the rest of the file should be skipped.
+    bool grep_buffer(StringView buffer)
+    {
+        auto literal = m_options.invert_match ? StringView {} : m_matcher.required_literal();
+        // The lines that the literal search jumps over are never seen by grep_line(), so look for binary data in them here.
+        auto skipped_lines_are_binary = [&](size_t start, size_t end) {
+            return m_options.binary_mode == BinaryFileMode::Skip && memchr(buffer.characters_without_null_termination() + start, 0, end - start) != nullptr;
+        };
+
+        size_t position = 0;
+        while (position < buffer.length()) {
+            size_t line_start = position;
+            if (!literal.is_empty()) {
+                // Search the whole buffer for the literal, and only then find the line that it's in.
+                auto offset = AK::memmem_optional(buffer.characters_without_null_termination() + position, buffer.length() - position, literal.characters_without_null_termination(), literal.length());
+                if (!offset.has_value())
+                    return !skipped_lines_are_binary(position, buffer.length());
+                line_start = position + *offset;
+                while (line_start > position && buffer[line_start - 1] != '\n')
+                    --line_start;
+                if (skipped_lines_are_binary(position, line_start))
+                    return false;
+            }
+
+            auto* newline = memchr(buffer.characters_without_null_termination() + line_start, '\n', buffer.length() - line_start);
+            size_t line_end = newline ? (char const*)newline - buffer.characters_without_null_termination() : buffer.length();
+            if (!grep_line(buffer.substring_view(line_start, line_end - line_start)))
+                return false;
+            position = line_end + 1;
+        }
+        return true;
+    }
+
+    // Returns false if the rest of the file should be skipped.
+    bool grep_line(StringView line)
+    {
+        auto is_binary = memchr(line.characters_without_null_termination(), 0, line.length()) != nullptr;
+        if (is_binary && m_options.binary_mode == BinaryFileMode::Skip)
+            return false;
+
+        auto result = m_matcher.match(line);
+        if (!(result.success ^ m_options.invert_match))
+            return true;
+
+        m_did_match = true;
+        if (is_binary && m_options.binary_mode == BinaryFileMode::Binary) {
+            m_output.appendff(m_options.colored_output ? "binary file \x1B[34m{}\x1B[0m matches\n" : "binary file {} matches\n", m_filename);
+            return false;
+        }
+
+        if ((result.matches.size() || m_options.invert_match) && m_print_filename)
+            m_output.appendff(m_options.colored_output ? "\x1B[34m{}:\x1B[0m" : "{}:", m_filename);
+
+        size_t last_printed_char_pos = 0;
+        for (auto& match : result.matches) {
+            m_output.appendff(m_options.colored_output ? "{}\x1B[32m{}\x1B[0m" : "{}{}",
+                line.substring_view(last_printed_char_pos, match.global_offset - last_printed_char_pos),
+                match.view.to_string());
+            last_printed_char_pos = match.global_offset + match.view.length();
+        }
+        m_output.append(line.substring_view(last_printed_char_pos));
+        m_output.append('\n');
+        return true;
+    }
+
+    GrepOptions const& m_options;
+    LineMatcher<Parser> const& m_matcher;
+    StringView m_filename;
+    bool m_print_filename { false };
+    Function<void(StringBuilder&)> m_flush;
+    StringBuilder m_output;
+    bool m_did_match { false };
+};
+
+static void write_to_stdout(StringBuilder& builder)
+{
+    out("{}", builder.string_view());
+    builder.clear();
+}
+
+struct FileToGrep {
+    String path;
+    String display_name;
+};
+
+struct GrepResult {
+    String output;
+    bool did_match { false };
+};
+
+// Greps the files on several threads, and prints their output in order.
+template<typename Parser>
+static bool grep_files_in_parallel(GrepOptions const& options, Vector<FileToGrep> const& files, size_t thread_count)
+{
+    Threading::Mutex mutex;
+    Threading::ConditionVariable result_available { mutex };
+    size_t next_file = 0;
+    Vector<Optional<GrepResult>> results;
+    results.resize(files.size());
+
+    NonnullRefPtrVector<Threading::Thread> threads;
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads.append(Threading::Thread::construct([&] {
+            // Matchers keep state while matching, so every thread needs its own.
+            LineMatcher<Parser> matcher { options };
+            for (;;) {
+                size_t index;
+                {
+                    Threading::MutexLocker locker { mutex };
+                    if (next_file == files.size())
+                        return 0;
+                    index = next_file++;
+                }
+
+                StringBuilder output;
+                FileGrepper<Parser> grepper { options, matcher, files[index].display_name, true, [&](StringBuilder& builder) {
+                                                 output.append(builder.string_view());
+                                                 builder.clear();
+                                             } };
+                grepper.grep_file(files[index].path);
+
+                Threading::MutexLocker locker { mutex };
+                results[index] = GrepResult { output.build(), grepper.did_match() };
+                result_available.broadcast();
+            }
+        },
+            "grep"sv));
+        threads.last().start();
+    }
+
+    bool did_match_something = false;
+    for (size_t i = 0; i < files.size(); ++i) {
+        GrepResult result;
+        {
+            Threading::MutexLocker locker { mutex };
+            result_available.wait_while([&] { return !results[i].has_value(); });
+            result = results[i].release_value();
+        }
+        out("{}", result.output);
+        did_match_something |= result.did_match;
+    }
+
+    for (auto& thread : threads)
+        (void)thread.join();
+    return did_match_something;
+}
+
 int main(int argc, char** argv)
 {
-    if (pledge("stdio rpath", nullptr) < 0) {
+    if (pledge("stdio rpath thread", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
 
     Vector<const char*> files;
 
+    GrepOptions options;
     bool recursive { false };
     bool use_ere { false };
-    const char* pattern = nullptr;
-    BinaryFileMode binary_mode { BinaryFileMode::Binary };
     bool case_insensitive = false;
-    bool invert_match = false;
-    bool colored_output = isatty(STDOUT_FILENO);
+    unsigned thread_count = 0;
+    options.colored_output = isatty(STDOUT_FILENO);
 
     Core::ArgsParser args_parser;
     args_parser.add_option(recursive, "Recursively scan files", "recursive", 'r');
     args_parser.add_option(use_ere, "Extended regular expressions", "extended-regexp", 'E');
-    args_parser.add_option(pattern, "Pattern", "regexp", 'e', "Pattern");
+    args_parser.add_option(Core::ArgsParser::Option {
+        .requires_argument = true,
+        .help_string = "Pattern (may be given multiple times)",
+        .long_name = "regexp",
+        .short_name = 'e',
+        .value_name = "Pattern",
+        .accept_value = [&](auto* str) {
+            options.patterns.append(str);
+            return true;
+        },
+    });
     args_parser.add_option(case_insensitive, "Make matches case-insensitive", nullptr, 'i');
-    args_parser.add_option(invert_match, "Select non-matching lines", "invert-match", 'v');
+    args_parser.add_option(options.invert_match, "Select non-matching lines", "invert-match", 'v');
     args_parser.add_option(Core::ArgsParser::Option {
         .requires_argument = true,
         .help_string = "Action to take for binary files ([binary], text, skip)",
         .long_name = "binary-mode",
         .accept_value = [&](auto* str) {
             if ("text"sv == str)
-                binary_mode = BinaryFileMode::Text;
+                options.binary_mode = BinaryFileMode::Text;
             else if ("binary"sv == str)
-                binary_mode = BinaryFileMode::Binary;
+                options.binary_mode = BinaryFileMode::Binary;
             else if ("skip"sv == str)
-                binary_mode = BinaryFileMode::Skip;
+                options.binary_mode = BinaryFileMode::Skip;
             else
                 return false;
             return true;
@@ -77,7 +392,7 @@ int main(int argc, char** argv)
         .long_name = "text",
         .short_name = 'a',
         .accept_value = [&](auto) {
-            binary_mode = BinaryFileMode::Text;
+            options.binary_mode = BinaryFileMode::Text;
             return true;
         },
     });
@@ -87,7 +402,7 @@ int main(int argc, char** argv)
         .long_name = nullptr,
         .short_name = 'I',
         .accept_value = [&](auto) {
-            binary_mode = BinaryFileMode::Skip;
+            options.binary_mode = BinaryFileMode::Skip;
             return true;
         },
     });
@@ -99,135 +414,94 @@ int main(int argc, char** argv)
         .value_name = "WHEN",
         .accept_value = [&](auto* str) {
             if ("never"sv == str)
-                colored_output = false;
+                options.colored_output = false;
             else if ("always"sv == str)
-                colored_output = true;
+                options.colored_output = true;
             else if ("auto"sv != str)
                 return false;
             return true;
         },
     });
+    args_parser.add_option(thread_count, "Number of threads to scan files with when recursing (defaults to the number of processors)", "threads", 'j', "count");
     args_parser.add_positional_argument(files, "File(s) to process", "file", Core::ArgsParser::Required::No);
     args_parser.parse(argc, argv);
 
     // mock grep behavior: if -e is omitted, use first positional argument as pattern
-    if (pattern == nullptr && files.size())
-        pattern = files.take_first();
+    if (options.patterns.is_empty() && files.size())
+        options.patterns.append(files.take_first());
+    if (options.patterns.is_empty()) {
+        args_parser.print_usage(stderr, argv[0]);
+        return 1;
+    }
 
     auto user_has_specified_files = !files.is_empty();
 
-    PosixOptions options {};
     if (case_insensitive)
-        options |= PosixFlags::Insensitive;
+        options.regex_options |= PosixFlags::Insensitive;
 
-    auto grep_logic = [&](auto&& re) {
-        if (re.parser_result.error != Error::NoError) {
+    auto grep_logic = [&]<typename Parser>() {
+        LineMatcher<Parser> matcher { options };
+        if (matcher.has_error())
             return 1;
-        }
-
-        auto matches = [&](StringView str, StringView filename = "", bool print_filename = false, bool is_binary = false) {
-            size_t last_printed_char_pos { 0 };
-            if (is_binary && binary_mode == BinaryFileMode::Skip)
-                return false;
-
-            auto result = re.match(str, PosixFlags::Global);
-            if (result.success ^ invert_match) {
-                if (is_binary && binary_mode == BinaryFileMode::Binary) {
-                    outln(colored_output ? "binary file \x1B[34m{}\x1B[0m matches" : "binary file {} matches", filename);
-                } else {
-                    if ((result.matches.size() || invert_match) && print_filename)
-                        out(colored_output ? "\x1B[34m{}:\x1B[0m" : "{}:", filename);
-
-                    for (auto& match : result.matches) {
-                        out(colored_output ? "{}\x1B[32m{}\x1B[0m" : "{}{}",
-                            StringView(&str[last_printed_char_pos], match.global_offset - last_printed_char_pos),
-                            match.view.to_string());
-                        last_printed_char_pos = match.global_offset + match.view.length();
-                    }
-                    outln("{}", StringView(&str[last_printed_char_pos], str.length() - last_printed_char_pos));
-                }
-
-                return true;
-            }
 
-            return false;
+        bool did_match_something = false;
+        auto grep_one_file = [&](StringView path, StringView display_name, bool print_filename) {
+            FileGrepper<Parser> grepper { options, matcher, display_name, print_filename, write_to_stdout };
+            auto success = grepper.grep_file(path);
+            did_match_something |= grepper.did_match();
+            return success;
         };
 
-        auto handle_file = [&matches, binary_mode](StringView filename, bool print_filename) -> bool {
-            auto file = Core::File::construct(filename);
-            if (!file->open(Core::OpenMode::ReadOnly)) {
-                warnln("Failed to open {}: {}", filename, file->error_string());
-                return false;
-            }
-
-            while (file->can_read_line()) {
-                auto line = file->read_line();
-                auto is_binary = memchr(line.characters(), 0, line.length()) != nullptr;
+        if (!files.size() && !recursive) {
+            FileGrepper<Parser> grepper { options, matcher, "stdin", false, write_to_stdout };
+            if (!grepper.grep_fd(STDIN_FILENO))
+                return 1;
+            return grepper.did_match() ? 0 : 1;
+        }
 
-                if (matches(line, filename, print_filename, is_binary) && is_binary && binary_mode == BinaryFileMode::Binary)
-                    return true;
+        if (!recursive) {
+            bool print_filename { files.size() > 1 };
+            for (auto& filename : files) {
+                if (!grep_one_file(filename, filename, print_filename))
+                    return 1;
             }
-            return true;
-        };
+            return did_match_something ? 0 : 1;
+        }
 
-        auto add_directory = [&handle_file, user_has_specified_files](String base, Optional<String> recursive, auto handle_directory) -> void {
+        Vector<FileToGrep> files_to_grep;
+        auto add_directory = [&](String base, Optional<String> recursive, auto handle_directory) -> void {
             Core::DirIterator it(recursive.value_or(base), Core::DirIterator::Flags::SkipDots);
             while (it.has_next()) {
                 auto path = it.next_full_path();
                 if (!Core::File::is_directory(path)) {
                     auto key = user_has_specified_files ? path.view() : path.substring_view(base.length() + 1, path.length() - base.length() - 1);
-                    handle_file(key, true);
+                    files_to_grep.append({ path, key });
                 } else {
                     handle_directory(base, path, handle_directory);
                 }
             }
         };
 
-        bool did_match_something = false;
-        if (!files.size() && !recursive) {
-            char* line = nullptr;
-            size_t line_len = 0;
-            ssize_t nread = 0;
-            ScopeGuard free_line = [line] { free(line); };
-            while ((nread = getline(&line, &line_len, stdin)) != -1) {
-                VERIFY(nread > 0);
-                if (line[nread - 1] == '\n')
-                    --nread;
-                StringView line_view(line, nread);
-                bool is_binary = line_view.contains(0);
-
-                if (is_binary && binary_mode == BinaryFileMode::Skip)
-                    return 1;
-
-                auto matched = matches(line_view, "stdin", false, is_binary);
-                did_match_something = did_match_something || matched;
-                if (matched && is_binary && binary_mode == BinaryFileMode::Binary)
-                    return 0;
-            }
+        if (user_has_specified_files) {
+            for (auto& filename : files)
+                add_directory(filename, {}, add_directory);
         } else {
-            if (recursive) {
-                if (user_has_specified_files) {
-                    for (auto& filename : files) {
-                        add_directory(filename, {}, add_directory);
-                    }
-                } else {
-                    add_directory(".", {}, add_directory);
-                }
-
-            } else {
-                bool print_filename { files.size() > 1 };
-                for (auto& filename : files) {
-                    if (!handle_file(filename, print_filename))
-                        return 1;
-                }
-            }
+            add_directory(".", {}, add_directory);
         }
 
+        if (thread_count == 0)
+            thread_count = Core::processor_count();
+        thread_count = min((size_t)thread_count, files_to_grep.size());
+        if (thread_count > 1)
+            return grep_files_in_parallel<Parser>(options, files_to_grep, thread_count) ? 0 : 1;
+
+        for (auto& file : files_to_grep)
+            grep_one_file(file.path, file.display_name, true);
         return did_match_something ? 0 : 1;
     };
 
     if (use_ere)
-        return grep_logic(Regex<PosixExtended>(pattern, options));
+        return grep_logic.operator()<PosixExtended>();
 
-    return grep_logic(Regex<PosixBasic>(pattern, options));
+    return grep_logic.operator()<PosixBasic>();
 }
@@ -15,6 +15,7 @@
 #include <LibCore/StandardPaths.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/PassManager.h>
@@ -100,6 +101,7 @@ static bool s_dump_ast = false;
 static bool s_dump_bytecode = false;
 static bool s_run_bytecode = false;
 static bool s_opt_bytecode = false;
+static OwnPtr<JS::Bytecode::ExecutableCache> s_bytecode_cache;
 static bool s_as_module = false;
 static bool s_print_last_result = false;
 static RefPtr<Line::Editor> s_editor;
@@ -801,6 +803,11 @@ static bool write_to_file(String const& path)
 
 static bool parse_and_run(JS::Interpreter& interpreter, StringView const& source)
 {
+    auto run_bytecode = [&](JS::Bytecode::Executable const& executable) {
+        JS::Bytecode::Interpreter bytecode_interpreter(interpreter.global_object(), interpreter.realm());
+        bytecode_interpreter.run(executable);
+    };
+
     auto program_type = s_as_module ? JS::Program::Type::Module : JS::Program::Type::Script;
     auto parser = JS::Parser(JS::Lexer(source), program_type);
     auto program = parser.parse_program();
@@ -815,7 +822,13 @@ static bool parse_and_run(JS::Interpreter& interpreter, StringView const& source
             outln("{}", hint);
         vm->throw_exception<JS::SyntaxError>(interpreter.global_object(), error.to_string());
     } else {
-        if (s_dump_bytecode || s_run_bytecode) {
+        Optional<JS::Bytecode::Executable> cached_executable;
+        if (s_run_bytecode && s_bytecode_cache && !s_dump_bytecode)
+            cached_executable = s_bytecode_cache->load(source, *program);
+
+        if (cached_executable.has_value()) {
+            run_bytecode(*cached_executable);
+        } else if (s_dump_bytecode || s_run_bytecode) {
             auto unit = JS::Bytecode::Generator::generate(*program);
             if (s_opt_bytecode) {
                 auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
@@ -833,8 +846,9 @@ static bool parse_and_run(JS::Interpreter& interpreter, StringView const& source
             }
 
             if (s_run_bytecode) {
-                JS::Bytecode::Interpreter bytecode_interpreter(interpreter.global_object(), interpreter.realm());
-                bytecode_interpreter.run(unit);
+                if (s_bytecode_cache)
+                    s_bytecode_cache->store(source, *program, unit);
+                run_bytecode(unit);
             } else {
                 return true;
             }
@@ -1115,6 +1129,7 @@ int main(int argc, char** argv)
     bool gc_on_every_allocation = false;
     bool zombify_dead_cells = false;
     bool disable_syntax_highlight = false;
+    char const* bytecode_cache_path = nullptr;
     Vector<String> script_paths;
 
     Core::ArgsParser args_parser;
@@ -1124,6 +1139,7 @@ int main(int argc, char** argv)
     args_parser.add_option(s_run_bytecode, "Run the bytecode", "run-bytecode", 'b');
     args_parser.add_option(s_opt_bytecode, "Optimize the bytecode", "optimize-bytecode", 'p');
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
+    args_parser.add_option(bytecode_cache_path, "Cache the generated bytecode in (and load it from) the given directory", "bytecode-cache", 0, "path");
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
     args_parser.add_option(zombify_dead_cells, "Zombify dead cells (to catch missing GC marks)", "zombify-dead-cells", 'z');
@@ -1133,6 +1149,9 @@ int main(int argc, char** argv)
 
     bool syntax_highlight = !disable_syntax_highlight;
 
+    if (bytecode_cache_path)
+        s_bytecode_cache = make<JS::Bytecode::ExecutableCache>(bytecode_cache_path, String::formatted("{}{}", s_opt_bytecode ? "optimized " : "", s_as_module ? "module" : "script"));
+
     vm = JS::VM::create();
     // NOTE: These will print out both warnings when using something like Promise.reject().catch(...) -
     // which is, as far as I can tell, correct - a promise is created, rejected without handler, and a
@@ -1314,7 +1333,7 @@ int main(int argc, char** argv)
             Vector<Line::CompletionSuggestion> results;
 
             Function<void(JS::Shape const&, StringView const&)> list_all_properties = [&results, &list_all_properties](JS::Shape const& shape, auto& property_pattern) {
-                for (auto const& descriptor : shape.property_table()) {
+                for (auto const& descriptor : shape.property_table_ordered()) {
                     if (!descriptor.key.is_string())
                         continue;
                     auto key = descriptor.key.as_string();
@@ -4,44 +4,462 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BinaryHeap.h>
+#include <AK/CharacterTypes.h>
+#include <AK/NonnullRefPtrVector.h>
 #include <AK/QuickSort.h>
+#include <AK/ScopeGuard.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ProcessorCount.h>
+#include <LibThreading/Thread.h>
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
+struct SortOptions {
+    // 1-based fields that make up the key, or 0 if the whole line is the key.
+    size_t key_start_field { 0 };
+    size_t key_end_field { 0 };
+    Optional<char> field_separator;
+    bool numeric { false };
+};
+
+static SortOptions s_options;
+
+// Each merge pass looks at no more than this many runs at once.
+static constexpr size_t max_merge_width = 64;
+
+static StringView key_for_line(StringView line)
 {
-    if (pledge("stdio", nullptr) > 0) {
+    if (s_options.key_start_field == 0)
+        return line;
+
+    // Without a separator, fields are separated by (and start after) runs of blanks.
+    auto is_separator = [](char ch) {
+        if (s_options.field_separator.has_value())
+            return ch == *s_options.field_separator;
+        return is_ascii_blank(ch);
+    };
+
+    size_t position = 0;
+    auto skip_to_next_field = [&] {
+        if (!s_options.field_separator.has_value()) {
+            while (position < line.length() && is_separator(line[position]))
+                ++position;
+        }
+        while (position < line.length() && !is_separator(line[position]))
+            ++position;
+        if (s_options.field_separator.has_value() && position < line.length())
+            ++position;
+    };
+
+    for (size_t field = 1; field < s_options.key_start_field; ++field)
+        skip_to_next_field();
+    if (!s_options.field_separator.has_value()) {
+        while (position < line.length() && is_separator(line[position]))
+            ++position;
+    }
+    auto start = min(position, line.length());
+
+    if (s_options.key_end_field == 0)
+        return line.substring_view(start);
+
+    for (size_t field = s_options.key_start_field; field <= s_options.key_end_field && position < line.length(); ++field) {
+        skip_to_next_field();
+        if (s_options.field_separator.has_value() && field == s_options.key_end_field && position > start && line[position - 1] == *s_options.field_separator)
+            --position;
+    }
+    return line.substring_view(start, position - start);
+}
+
+static double numeric_value(StringView key)
+{
+    size_t position = 0;
+    while (position < key.length() && is_ascii_blank(key[position]))
+        ++position;
+
+    bool negative = position < key.length() && key[position] == '-';
+    if (negative)
+        ++position;
+
+    double value = 0;
+    for (; position < key.length() && is_ascii_digit(key[position]); ++position)
+        value = value * 10 + parse_ascii_digit(key[position]);
+    if (position < key.length() && key[position] == '.') {
+        double scale = 0.1;
+        for (++position; position < key.length() && is_ascii_digit(key[position]); ++position) {
+            value += parse_ascii_digit(key[position]) * scale;
+            scale /= 10;
+        }
+    }
+    return negative ? -value : value;
+}
+
+static int compare_strings(StringView a, StringView b)
+{
+    if (auto result = __builtin_memcmp(a.characters_without_null_termination(), b.characters_without_null_termination(), min(a.length(), b.length())); result != 0)
+        return result;
+    if (a.length() == b.length())
+        return 0;
+    return a.length() < b.length() ? -1 : 1;
+}
+
+static int compare_lines(StringView a, StringView b)
+{
+    auto a_key = key_for_line(a);
+    auto b_key = key_for_line(b);
+
+    if (s_options.numeric) {
+        auto a_value = numeric_value(a_key);
+        auto b_value = numeric_value(b_key);
+        if (a_value != b_value)
+            return a_value < b_value ? -1 : 1;
+    } else if (auto result = compare_strings(a_key, b_key); result != 0) {
+        return result;
+    }
+
+    // Lines with equal keys are ordered by the whole line, so that the output doesn't depend on how the input was split up.
+    return compare_strings(a, b);
+}
+
+struct MergeKey {
+    StringView line;
+    // Which source the line came from, which also breaks ties between equal lines.
+    size_t source;
+
+    int compare(MergeKey const& other) const
+    {
+        if (auto result = compare_lines(line, other.line); result != 0)
+            return result;
+        return source == other.source ? 0 : (source < other.source ? -1 : 1);
+    }
+
+    bool operator<(MergeKey const& other) const { return compare(other) < 0; }
+    bool operator<=(MergeKey const& other) const { return compare(other) <= 0; }
+    bool operator>=(MergeKey const& other) const { return compare(other) >= 0; }
+};
+
+// A sorted run of lines that was spilled to a temporary file.
+class RunFile {
+public:
+    static Optional<RunFile> create(String const& temporary_directory)
+    {
+        auto path = String::formatted("{}/sort.XXXXXX", temporary_directory);
+        auto fd = mkstemp(const_cast<char*>(path.characters()));
+        if (fd < 0) {
+            perror("mkstemp");
+            return {};
+        }
+        // Nobody else needs to see the file, so it goes away as soon as we close it.
+        unlink(path.characters());
+        auto* file = fdopen(fd, "w+");
+        if (!file) {
+            perror("fdopen");
+            close(fd);
+            return {};
+        }
+        return RunFile { file };
+    }
+
+    RunFile(RunFile&& other)
+        : m_file(exchange(other.m_file, nullptr))
+        , m_buffer(exchange(other.m_buffer, nullptr))
+        , m_buffer_size(other.m_buffer_size)
+        , m_current(other.m_current)
+    {
+    }
+
+    ~RunFile()
+    {
+        free(m_buffer);
+        if (m_file)
+            fclose(m_file);
+    }
+
+    bool write_line(StringView line)
+    {
+        if (fwrite(line.characters_without_null_termination(), 1, line.length(), m_file) != line.length() || fputc('\n', m_file) == EOF) {
+            perror("fwrite");
+            return false;
+        }
+        return true;
+    }
+
+    // Rewinds the file, and makes the first line of it current.
+    bool start_reading()
+    {
+        if (fflush(m_file) != 0 || fseek(m_file, 0, SEEK_SET) != 0) {
+            perror("fseek");
+            return false;
+        }
+        advance();
+        return true;
+    }
+
+    Optional<StringView> current() const { return m_current; }
+
+    void advance()
+    {
+        auto length = getline(&m_buffer, &m_buffer_size, m_file);
+        if (length < 0) {
+            m_current = {};
+            return;
+        }
+        if (length > 0 && m_buffer[length - 1] == '\n')
+            --length;
+        m_current = StringView { m_buffer, (size_t)length };
+    }
+
+private:
+    explicit RunFile(FILE* file)
+        : m_file(file)
+    {
+    }
+
+    FILE* m_file { nullptr };
+    char* m_buffer { nullptr };
+    size_t m_buffer_size { 0 };
+    Optional<StringView> m_current;
+};
+
+// A sorted slice of the lines that are still in memory.
+class RunSlice {
+public:
+    explicit RunSlice(Span<String> lines)
+        : m_lines(lines)
+    {
+    }
+
+    Optional<StringView> current() const
+    {
+        if (m_index == m_lines.size())
+            return {};
+        return m_lines[m_index].view();
+    }
+
+    void advance() { ++m_index; }
+
+private:
+    Span<String> m_lines;
+    size_t m_index { 0 };
+};
+
+// Merges up to `max_merge_width` sorted runs, passing the lines to the callback in order.
+template<typename Run, typename Callback>
+static bool merge_runs(Span<Run> runs, Callback callback)
+{
+    VERIFY(runs.size() <= max_merge_width);
+
+    BinaryHeap<MergeKey, size_t, max_merge_width> heap;
+    for (size_t i = 0; i < runs.size(); ++i) {
+        if (auto line = runs[i].current(); line.has_value())
+            heap.insert({ *line, i }, i);
+    }
+
+    while (!heap.is_empty()) {
+        auto index = heap.pop_min();
+        if (!callback(*runs[index].current()))
+            return false;
+        runs[index].advance();
+        if (auto line = runs[index].current(); line.has_value())
+            heap.insert({ *line, index }, index);
+    }
+    return true;
+}
+
+// Sorts the lines with several threads, and returns the sorted slices that they are made up of.
+static Vector<RunSlice> sort_in_parallel(Vector<String>& lines, size_t thread_count)
+{
+    auto less_than = [](String const& a, String const& b) { return compare_lines(a, b) < 0; };
+
+    thread_count = clamp(thread_count, (size_t)1, min(max_merge_width, max(lines.size(), (size_t)1)));
+    auto slice_size = ceil_div(lines.size(), thread_count);
+
+    Vector<RunSlice> slices;
+    NonnullRefPtrVector<Threading::Thread> threads;
+    for (size_t start = 0; start < lines.size(); start += slice_size) {
+        auto slice = lines.span().slice(start, min(slice_size, lines.size() - start));
+        slices.append(RunSlice { slice });
+        if (start + slice_size >= lines.size()) {
+            // This thread would only be waiting for the others, so it might as well sort the last slice itself.
+            quick_sort(slice, less_than);
+            break;
+        }
+        threads.append(Threading::Thread::construct([slice, less_than]() mutable {
+            quick_sort(slice, less_than);
+            return 0;
+        },
+            "sort"sv));
+        threads.last().start();
+    }
+
+    for (auto& thread : threads)
+        (void)thread.join();
+    return slices;
+}
+
+int main(int argc, char** argv)
+{
+    if (pledge("stdio rpath wpath cpath thread", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
 
-    Vector<String> lines;
+    Vector<const char*> paths;
+    const char* key_fields = nullptr;
+    const char* separator = nullptr;
+    const char* temporary_directory = "/tmp";
+    size_t buffer_size = 64 * MiB;
+    unsigned thread_count = 0;
 
-    for (;;) {
-        char* buffer = nullptr;
-        ssize_t buflen = 0;
-        size_t n;
-        errno = 0;
-        buflen = getline(&buffer, &n, stdin);
-        if (buflen == -1 && errno != 0) {
-            perror("getline");
-            exit(1);
-        }
-        if (buflen == -1)
-            break;
-        lines.append({ buffer, AK::ShouldChomp::Chomp });
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Sort lines of text, spilling sorted runs to temporary files if they don't fit into memory.");
+    args_parser.add_option(key_fields, "Sort by the given fields (e.g. 2 or 2,3), counting from 1", "key", 'k', "start[,end]");
+    args_parser.add_option(separator, "Separate fields by this character instead of by blanks", "field-separator", 't', "separator");
+    args_parser.add_option(s_options.numeric, "Compare keys by their numerical value", "numeric-sort", 'n');
+    args_parser.add_option(Core::ArgsParser::Option {
+        .requires_argument = true,
+        .help_string = "Keep at most this many bytes of input in memory (suffixes K, M and G are allowed)",
+        .long_name = "buffer-size",
+        .short_name = 'S',
+        .value_name = "size",
+        .accept_value = [&](auto* str) {
+            StringView value { str };
+            u64 multiplier = 1;
+            if (value.ends_with('K') || value.ends_with('M') || value.ends_with('G')) {
+                multiplier = value.ends_with('K') ? KiB : value.ends_with('M') ? MiB : GiB;
+                value = value.substring_view(0, value.length() - 1);
+            }
+            auto number = value.to_uint();
+            if (!number.has_value() || *number == 0)
+                return false;
+            buffer_size = *number * multiplier;
+            return true;
+        },
+    });
+    args_parser.add_option(temporary_directory, "Put temporary files into this directory", "temporary-directory", 'T', "directory");
+    args_parser.add_option(thread_count, "Sort with this many threads (defaults to the number of processors)", "parallel", 0, "count");
+    args_parser.add_positional_argument(paths, "Files to sort (defaults to standard input)", "file", Core::ArgsParser::Required::No);
+    args_parser.parse(argc, argv);
+
+    if (key_fields) {
+        auto parts = StringView { key_fields }.split_view(',');
+        auto start = parts.is_empty() ? Optional<unsigned> {} : parts[0].to_uint();
+        auto end = parts.size() == 2 ? parts[1].to_uint() : Optional<unsigned> { 0 };
+        if (parts.size() > 2 || !start.has_value() || *start == 0 || !end.has_value() || (*end != 0 && *end < *start)) {
+            warnln("sort: invalid key '{}'", key_fields);
+            return 1;
+        }
+        s_options.key_start_field = *start;
+        s_options.key_end_field = *end;
     }
+    if (separator) {
+        if (strlen(separator) != 1) {
+            warnln("sort: the field separator must be a single character");
+            return 1;
+        }
+        s_options.field_separator = separator[0];
+    }
+    if (thread_count == 0)
+        thread_count = Core::processor_count();
+
+    Vector<FILE*> inputs;
+    for (auto* path : paths) {
+        auto* file = fopen(path, "r");
+        if (!file) {
+            perror(path);
+            return 1;
+        }
+        inputs.append(file);
+    }
+    if (inputs.is_empty())
+        inputs.append(stdin);
+
+    Vector<RunFile> runs;
+    Vector<String> lines;
+    size_t buffered_bytes = 0;
+
+    // Sorts the lines that are buffered, and writes them out to a new run.
+    auto spill = [&] {
+        auto run = RunFile::create(temporary_directory);
+        if (!run.has_value())
+            return false;
+        auto slices = sort_in_parallel(lines, thread_count);
+        if (!merge_runs(slices.span(), [&](StringView line) { return run->write_line(line); }))
+            return false;
+        runs.append(run.release_value());
+        lines.clear();
+        buffered_bytes = 0;
+        return true;
+    };
+
+    char* buffer = nullptr;
+    size_t buffer_capacity = 0;
+    ScopeGuard free_buffer = [&] { free(buffer); };
+    for (auto* input : inputs) {
+        for (;;) {
+            errno = 0;
+            auto length = getline(&buffer, &buffer_capacity, input);
+            if (length == -1 && errno != 0) {
+                perror("getline");
+                return 1;
+            }
+            if (length == -1)
+                break;
+            if (length > 0 && buffer[length - 1] == '\n')
+                --length;
 
-    quick_sort(lines);
+            lines.append({ buffer, (size_t)length });
+            buffered_bytes += length + sizeof(String) + sizeof(StringImpl);
+            if (buffered_bytes >= buffer_size && !spill())
+                return 1;
+        }
+        if (input != stdin)
+            fclose(input);
+    }
 
-    for (auto& line : lines) {
+    auto write_to_stdout = [](StringView line) {
         outln("{}", line);
+        return true;
+    };
+
+    if (runs.is_empty()) {
+        // Everything fit into memory.
+        auto slices = sort_in_parallel(lines, thread_count);
+        merge_runs(slices.span(), write_to_stdout);
+        return 0;
     }
 
+    if (!lines.is_empty() && !spill())
+        return 1;
+
+    // Merge the runs in groups until there are few enough left to merge them straight into the output.
+    while (runs.size() > max_merge_width) {
+        Vector<RunFile> merged_runs;
+        for (size_t start = 0; start < runs.size(); start += max_merge_width) {
+            auto group = runs.span().slice(start, min(max_merge_width, runs.size() - start));
+            auto merged_run = RunFile::create(temporary_directory);
+            if (!merged_run.has_value())
+                return 1;
+            for (auto& run : group) {
+                if (!run.start_reading())
+                    return 1;
+            }
+            if (!merge_runs(group, [&](StringView line) { return merged_run->write_line(line); }))
+                return 1;
+            merged_runs.append(merged_run.release_value());
+        }
+        runs = move(merged_runs);
+    }
+
+    for (auto& run : runs) {
+        if (!run.start_reading())
+            return 1;
+    }
+    merge_runs(runs.span(), write_to_stdout);
     return 0;
 }